@@ -12,7 +12,8 @@
 
 int main(int argc, char *argv[])
 {
-    int i, j, numprocs, rank, size;
+    int i, j, numprocs, rank;
+    size_t size;
     double latency = 0.0, t_start = 0.0, t_stop = 0.0;
     double timer = 0.0;
     double avg_time = 0.0, max_time = 0.0, min_time = 0.0;
@@ -25,6 +26,7 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     options.bench = COLLECTIVE;
     options.subtype = ALL_GATHER;
+    options.large_count = OMB_LARGE_COUNT;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_CHAR;
     size_t omb_ddt_transmit_size = 0;
@@ -148,17 +150,20 @@ int main(int argc, char *argv[])
                                           omb_buffer_sizes);
                     for (j = 0; j < options.warmup_validation; j++) {
                         MPI_CHECK(MPI_Barrier(omb_comm));
-                        MPI_CHECK(MPI_Allgather(
-                            sendbuf, num_elements, omb_curr_datatype, recvbuf,
-                            num_elements, omb_curr_datatype, omb_comm));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Allgather, num_elements,
+                            (sendbuf, num_elements, omb_curr_datatype, recvbuf,
+                             num_elements, omb_curr_datatype, omb_comm)));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
 
                 t_start = MPI_Wtime();
-                MPI_CHECK(MPI_Allgather(
-                    sendbuf, num_elements, omb_curr_datatype, recvbuf,
-                    num_elements, omb_curr_datatype, omb_comm));
+                t_start += omb_skew_inject(rank, numprocs);
+                MPI_CHECK(OMB_MPI_LARGE(
+                    MPI_Allgather, num_elements,
+                    (sendbuf, num_elements, omb_curr_datatype, recvbuf,
+                     num_elements, omb_curr_datatype, omb_comm)));
 
                 t_stop = MPI_Wtime();
                 MPI_CHECK(MPI_Barrier(omb_comm));
@@ -241,7 +246,7 @@ int main(int argc, char *argv[])
     if (0 != errors && options.validate && 0 == rank) {
         fprintf(stdout,
                 "DATA VALIDATION ERROR: %s exited with status %d on"
-                " message size %d.\n",
+                " message size %zu.\n",
                 argv[0], EXIT_FAILURE, size);
         exit(EXIT_FAILURE);
     }
@@ -12,12 +12,14 @@
 
 int main(int argc, char *argv[])
 {
-    int i, j, numprocs, rank, size;
+    int i, j, numprocs, rank;
+    size_t size;
     double latency = 0.0, t_start = 0.0, t_stop = 0.0;
     double timer = 0.0;
     double avg_time = 0.0, max_time = 0.0, min_time = 0.0;
     char *sendbuf, *recvbuf;
     void *sendbuf_warmup = NULL, *recvbuf_warmup = NULL;
+    void **policy_sendbuf = NULL;
     int po_ret;
     int errors = 0, local_errors = 0;
     size_t bufsize;
@@ -26,8 +28,11 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     options.bench = COLLECTIVE;
     options.subtype = ALL_REDUCE;
+    options.large_count = OMB_LARGE_COUNT;
+    options.buffer_policies = 1;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
     int mpi_type_itr = 0, mpi_type_size = 0, mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
@@ -40,7 +45,6 @@ int main(int argc, char *argv[])
     set_header(HEADER);
     set_benchmark_name("osu_allreduce");
     po_ret = process_options(argc, argv);
-    omb_populate_mpi_type_list(mpi_type_list);
 
     if (PO_OKAY == po_ret && NONE != options.accel) {
         if (init_accel()) {
@@ -56,6 +60,7 @@ int main(int argc, char *argv[])
     }
     MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
     MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
 
     omb_graph_options_init(&omb_graph_options);
     switch (po_ret) {
@@ -118,6 +123,7 @@ int main(int argc, char *argv[])
         MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
         omb_curr_datatype = mpi_type_list[mpi_type_itr];
         OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
         MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
                                     &mpi_type_name_length));
         OMB_MPI_RUN_AT_RANK_ZERO(
@@ -140,10 +146,15 @@ int main(int argc, char *argv[])
             MPI_CHECK(MPI_Barrier(omb_comm));
             timer = 0.0;
 
+            /* -E leaves the send side of an in-place allreduce alone */
+            policy_sendbuf = (void **)&sendbuf;
             if (1 == options.omb_enable_mpi_in_place) {
                 sendbuf = MPI_IN_PLACE;
+                policy_sendbuf = NULL;
             }
             for (i = 0; i < options.iterations + options.skip; i++) {
+                omb_buffer_policy_next(policy_sendbuf, (void **)&recvbuf,
+                                       size);
                 if (i == options.skip) {
                     omb_papi_start(&papi_eventset);
                 }
@@ -153,16 +164,20 @@ int main(int argc, char *argv[])
                                           omb_buffer_sizes);
                     for (j = 0; j < options.warmup_validation; j++) {
                         MPI_CHECK(MPI_Barrier(omb_comm));
-                        MPI_CHECK(MPI_Allreduce(sendbuf_warmup, recvbuf_warmup,
-                                                num_elements, omb_curr_datatype,
-                                                MPI_SUM, omb_comm));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Allreduce, num_elements,
+                            (sendbuf_warmup, recvbuf_warmup, num_elements,
+                             omb_curr_datatype, omb_curr_op, omb_comm)));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
 
                 t_start = MPI_Wtime();
-                MPI_CHECK(MPI_Allreduce(sendbuf, recvbuf, num_elements,
-                                        omb_curr_datatype, MPI_SUM, omb_comm));
+                t_start += omb_skew_inject(rank, numprocs);
+                MPI_CHECK(OMB_MPI_LARGE(MPI_Allreduce, num_elements,
+                                        (sendbuf, recvbuf, num_elements,
+                                         omb_curr_datatype, omb_curr_op,
+                                         omb_comm)));
                 t_stop = MPI_Wtime();
                 MPI_CHECK(MPI_Barrier(omb_comm));
 
@@ -183,6 +198,7 @@ int main(int argc, char *argv[])
                     }
                 }
             }
+            omb_buffer_policy_reset(policy_sendbuf, (void **)&recvbuf);
             omb_papi_stop_and_print(&papi_eventset, size);
             latency = (double)(timer * 1e6) / options.iterations;
 
@@ -238,7 +254,7 @@ int main(int argc, char *argv[])
     if (0 != errors && options.validate && 0 == rank) {
         fprintf(stdout,
                 "DATA VALIDATION ERROR: %s exited with status %d on"
-                " message size %d.\n",
+                " message size %zu.\n",
                 argv[0], EXIT_FAILURE, size);
         exit(EXIT_FAILURE);
     }
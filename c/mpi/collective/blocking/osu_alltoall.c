@@ -12,7 +12,8 @@
 
 int main(int argc, char *argv[])
 {
-    int i, j, numprocs, rank, size;
+    int i, j, numprocs, rank;
+    size_t size;
     double latency = 0.0, t_start = 0.0, t_stop = 0.0;
     double timer = 0.0;
     int errors = 0, local_errors = 0;
@@ -26,6 +27,7 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     options.bench = COLLECTIVE;
     options.subtype = ALLTOALL;
+    options.large_count = OMB_LARGE_COUNT;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_CHAR;
     size_t omb_ddt_transmit_size = 0;
@@ -157,18 +159,22 @@ int main(int argc, char *argv[])
                                           omb_buffer_sizes);
                     for (j = 0; j < options.warmup_validation; j++) {
                         MPI_CHECK(MPI_Barrier(omb_comm));
-                        MPI_CHECK(MPI_Alltoall(sendbuf_warmup, num_elements,
-                                               omb_curr_datatype,
-                                               recvbuf_warmup, num_elements,
-                                               omb_curr_datatype, omb_comm));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Alltoall, num_elements,
+                            (sendbuf_warmup, num_elements, omb_curr_datatype,
+                             recvbuf_warmup, num_elements, omb_curr_datatype,
+                             omb_comm)));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
 
                 t_start = MPI_Wtime();
-                MPI_CHECK(MPI_Alltoall(sendbuf, num_elements, omb_curr_datatype,
-                                       recvbuf, num_elements, omb_curr_datatype,
-                                       omb_comm));
+                t_start += omb_skew_inject(rank, numprocs);
+                MPI_CHECK(OMB_MPI_LARGE(MPI_Alltoall, num_elements,
+                                        (sendbuf, num_elements,
+                                         omb_curr_datatype, recvbuf,
+                                         num_elements, omb_curr_datatype,
+                                         omb_comm)));
                 t_stop = MPI_Wtime();
                 MPI_CHECK(MPI_Barrier(omb_comm));
 
@@ -248,7 +254,7 @@ int main(int argc, char *argv[])
     if (0 != errors && options.validate && 0 == rank) {
         fprintf(stdout,
                 "DATA VALIDATION ERROR: %s exited with status %d on"
-                " message size %d.\n",
+                " message size %zu.\n",
                 argv[0], EXIT_FAILURE, size);
         exit(EXIT_FAILURE);
     }
@@ -196,6 +196,7 @@ int main(int argc, char *argv[])
                 }
 
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
 
                 MPI_CHECK(MPI_Alltoallv(sendbuf, sendcounts, sdispls,
                                         omb_curr_datatype, recvbuf, recvcounts,
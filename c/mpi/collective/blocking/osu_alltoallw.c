@@ -211,6 +211,7 @@ int main(int argc, char *argv[])
                 }
 
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
                 MPI_CHECK(MPI_Alltoallw(sendbuf, sendcounts, sdispls, stypes,
                                         recvbuf, recvcounts, rdispls, rtypes,
                                         omb_comm));
@@ -95,6 +95,7 @@ int main(int argc, char *argv[])
             omb_papi_start(&papi_eventset);
         }
         t_start = MPI_Wtime();
+        t_start += omb_skew_inject(rank, numprocs);
         MPI_CHECK(MPI_Barrier(omb_comm));
         t_stop = MPI_Wtime();
 
@@ -12,7 +12,8 @@
 
 int main(int argc, char *argv[])
 {
-    int i = 0, j, rank, size;
+    int i = 0, j, rank;
+    size_t size;
     int numprocs;
     double avg_time = 0.0, max_time = 0.0, min_time = 0.0;
     double latency = 0.0, t_start = 0.0, t_stop = 0.0;
@@ -25,6 +26,8 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     options.bench = COLLECTIVE;
     options.subtype = BCAST;
+    options.large_count = OMB_LARGE_COUNT;
+    options.buffer_policies = 1;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_CHAR;
     size_t omb_ddt_transmit_size = 0;
@@ -128,6 +131,7 @@ int main(int argc, char *argv[])
                 mpi_type_size;
             num_elements = omb_ddt_get_size(num_elements);
             for (i = 0; i < options.iterations + options.skip; i++) {
+                omb_buffer_policy_next((void **)&buffer, NULL, size);
                 if (i == options.skip) {
                     omb_papi_start(&papi_eventset);
                 }
@@ -136,15 +140,19 @@ int main(int argc, char *argv[])
                                           omb_curr_datatype, omb_buffer_sizes);
                     for (j = 0; j < options.warmup_validation; j++) {
                         MPI_CHECK(MPI_Barrier(omb_comm));
-                        MPI_CHECK(MPI_Bcast(buffer, num_elements,
-                                            omb_curr_datatype, 0, omb_comm));
+                        MPI_CHECK(OMB_MPI_LARGE(MPI_Bcast, num_elements,
+                                                (buffer, num_elements,
+                                                 omb_curr_datatype, 0,
+                                                 omb_comm)));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
 
                 t_start = MPI_Wtime();
-                MPI_CHECK(MPI_Bcast(buffer, num_elements, omb_curr_datatype, 0,
-                                    omb_comm));
+                t_start += omb_skew_inject(rank, numprocs);
+                MPI_CHECK(OMB_MPI_LARGE(MPI_Bcast, num_elements,
+                                        (buffer, num_elements,
+                                         omb_curr_datatype, 0, omb_comm)));
                 t_stop = MPI_Wtime();
                 MPI_CHECK(MPI_Barrier(omb_comm));
 
@@ -168,6 +176,7 @@ int main(int argc, char *argv[])
             }
 
             MPI_CHECK(MPI_Barrier(omb_comm));
+            omb_buffer_policy_reset((void **)&buffer, NULL);
             omb_papi_stop_and_print(&papi_eventset, size);
 
             latency = (timer * 1e6) / options.iterations;
@@ -223,7 +232,7 @@ int main(int argc, char *argv[])
     if (0 != errors && options.validate && 0 == rank) {
         fprintf(stdout,
                 "DATA VALIDATION ERROR: %s exited with status %d on"
-                " message size %d.\n",
+                " message size %zu.\n",
                 argv[0], EXIT_FAILURE, size);
         exit(EXIT_FAILURE);
     }
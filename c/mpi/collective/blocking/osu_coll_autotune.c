@@ -0,0 +1,307 @@
+#define BENCHMARK "OSU MPI%s Collective Algorithm Autotuner"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpit.h>
+
+#define TUNE_MAX_SIZES      32
+#define TUNE_MAX_COMM_SIZES 32
+
+/* Collective IDs of the Open MPI coll/tuned dynamic rules file. */
+static const int tune_ompi_coll_ids[OMB_COLL_NUM] = {0, 2,  3,  6, 7,
+                                                       9, 11, 12, 15};
+
+omb_mpit_cvar_t cvar;
+char *sendbuf = NULL, *recvbuf = NULL;
+int *recvcounts = NULL;
+int coll = OMB_COLL_ALLREDUCE;
+int num_sizes = 0, num_comm_sizes = 0;
+size_t sizes[TUNE_MAX_SIZES];
+int comm_sizes[TUNE_MAX_COMM_SIZES];
+int best[TUNE_MAX_COMM_SIZES][TUNE_MAX_SIZES];
+
+/* Average latency over the ranks of comm in us, valid at rank 0. */
+static double time_coll(MPI_Comm comm, size_t size, int nprocs)
+{
+    int i = 0, count = omb_coll_count(coll, size);
+    int iterations = options.iterations, skip = options.skip;
+    double t_start = 0.0, timer = 0.0, latency = 0.0, avg = 0.0;
+
+    if (size > LARGE_MESSAGE_SIZE) {
+        iterations = options.iterations_large;
+        skip = options.skip_large;
+    }
+    MPI_CHECK(MPI_Barrier(comm));
+    for (i = 0; i < skip + iterations; i++) {
+        t_start = MPI_Wtime();
+        omb_coll_run(coll, comm, nprocs, sendbuf, recvbuf, recvcounts, count,
+                     0);
+        if (i >= skip) {
+            timer += MPI_Wtime() - t_start;
+        }
+        MPI_CHECK(MPI_Barrier(comm));
+    }
+    latency = timer * 1e6 / iterations;
+    MPI_CHECK(MPI_Reduce(&latency, &avg, 1, MPI_DOUBLE, MPI_SUM, 0, comm));
+    return avg / nprocs;
+}
+
+/*
+ * Runs every candidate algorithm on the first nprocs ranks. The cvar is
+ * written on all processes and a new communicator is created for each
+ * candidate, since libraries bind the algorithm choice at that point.
+ */
+static void tune_comm_size(int rank, int comm_idx)
+{
+    int nprocs = comm_sizes[comm_idx], cand = 0, size_idx = 0;
+    double latency[OMB_MPIT_MAX_CANDIDATES][TUNE_MAX_SIZES];
+    MPI_Comm sub_comm = MPI_COMM_NULL, tune_comm = MPI_COMM_NULL;
+
+    MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD, rank < nprocs ? 0 : MPI_UNDEFINED,
+                             rank, &sub_comm));
+    for (cand = 0; cand < cvar.num_candidates; cand++) {
+        omb_mpit_cvar_write(&cvar, cvar.values[cand]);
+        if (MPI_COMM_NULL == sub_comm) {
+            continue;
+        }
+        MPI_CHECK(MPI_Comm_dup(sub_comm, &tune_comm));
+        for (size_idx = 0; size_idx < num_sizes; size_idx++) {
+            latency[cand][size_idx] =
+                omb_coll_count(coll, sizes[size_idx]) ?
+                    time_coll(tune_comm, sizes[size_idx], nprocs) :
+                    -1.0;
+        }
+        MPI_CHECK(MPI_Comm_free(&tune_comm));
+    }
+    omb_mpit_cvar_write(&cvar, cvar.default_value);
+    if (MPI_COMM_NULL != sub_comm) {
+        MPI_CHECK(MPI_Comm_free(&sub_comm));
+    }
+    if (0 != rank) {
+        return;
+    }
+
+    fprintf(stdout, "# Communicator size: %d\n", nprocs);
+    fprintf(stdout, "%-*s", 10, "# Size");
+    for (cand = 0; cand < cvar.num_candidates; cand++) {
+        fprintf(stdout, "%*.*s", FIELD_WIDTH, FIELD_WIDTH - 1,
+                cvar.value_names[cand]);
+    }
+    fprintf(stdout, "%*s\n", FIELD_WIDTH, "Best");
+    for (size_idx = 0; size_idx < num_sizes; size_idx++) {
+        best[comm_idx][size_idx] = -1;
+        if (latency[0][size_idx] < 0) {
+            continue;
+        }
+        fprintf(stdout, "%-*zu", 10, sizes[size_idx]);
+        for (cand = 0; cand < cvar.num_candidates; cand++) {
+            fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                    latency[cand][size_idx]);
+            if (-1 == best[comm_idx][size_idx] ||
+                latency[cand][size_idx] <
+                    latency[best[comm_idx][size_idx]][size_idx]) {
+                best[comm_idx][size_idx] = cand;
+            }
+        }
+        fprintf(stdout, "%*.*s\n", FIELD_WIDTH, FIELD_WIDTH - 1,
+                cvar.value_names[best[comm_idx][size_idx]]);
+    }
+    fprintf(stdout, "\n");
+    fflush(stdout);
+}
+
+/*
+ * Writes the best algorithms in the dynamic rules format of the Open MPI
+ * coll/tuned component, where each rule applies from its communicator and
+ * message size upwards. Open MPI compares the total buffer size for the
+ * rooted and all-to-all data movement collectives, hence the scaling by the
+ * communicator size. Other libraries get a plain table.
+ */
+static void write_tuning_file(void)
+{
+    int comm_idx = 0, size_idx = 0, rules = 0, last = 0, first = 0;
+    int ompi = !strncmp(cvar.name, "coll_tuned_", strlen("coll_tuned_"));
+    size_t scale = 1;
+    FILE *fp = fopen(options.omb_tune_file, "w");
+
+    if (NULL == fp) {
+        fprintf(stderr, "Unable to open tuning file %s\n",
+                options.omb_tune_file);
+        return;
+    }
+    if (ompi) {
+        fprintf(fp, "1 # number of collectives\n");
+        fprintf(fp, "%d # %s\n", tune_ompi_coll_ids[coll],
+                omb_coll_name(coll));
+        fprintf(fp, "%d # number of communicator sizes\n", num_comm_sizes);
+    } else {
+        fprintf(fp, "# %s: communicator size, message size, value, name\n",
+                cvar.name);
+    }
+    for (comm_idx = 0; comm_idx < num_comm_sizes; comm_idx++) {
+        switch (coll) {
+            case OMB_COLL_ALLGATHER:
+            case OMB_COLL_ALLTOALL:
+            case OMB_COLL_GATHER:
+            case OMB_COLL_SCATTER:
+                scale = comm_sizes[comm_idx];
+                break;
+            default:
+                scale = 1;
+                break;
+        }
+        for (rules = 0, last = -1, size_idx = 0; size_idx < num_sizes;
+             size_idx++) {
+            if (-1 != best[comm_idx][size_idx] &&
+                best[comm_idx][size_idx] != last) {
+                last = best[comm_idx][size_idx];
+                rules++;
+            }
+        }
+        if (ompi) {
+            fprintf(fp, "%d # communicator size\n", comm_sizes[comm_idx]);
+            fprintf(fp, "%d # number of message sizes\n", rules);
+        }
+        for (first = 1, last = -1, size_idx = 0; size_idx < num_sizes;
+             size_idx++) {
+            if (-1 == best[comm_idx][size_idx] ||
+                best[comm_idx][size_idx] == last) {
+                continue;
+            }
+            last = best[comm_idx][size_idx];
+            if (ompi) {
+                /* the first rule has to cover the smallest messages */
+                fprintf(fp, "%zu %d 0 0 # %s\n",
+                        first ? 0 : sizes[size_idx] * scale, cvar.values[last],
+                        cvar.value_names[last]);
+                first = 0;
+            } else {
+                fprintf(fp, "%d %zu %d %s\n", comm_sizes[comm_idx],
+                        sizes[size_idx], cvar.values[last],
+                        cvar.value_names[last]);
+            }
+        }
+    }
+    fclose(fp);
+    fprintf(stdout, "# Tuning table written to %s\n", options.omb_tune_file);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, nprocs = 0, po_ret = PO_OKAY;
+    size_t size = 0, bufsize = 0;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = COLLECTIVE;
+    options.subtype = COLL_AUTOTUNE;
+    set_header(HEADER);
+    set_benchmark_name("osu_coll_autotune");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    if (MPI_COMM_NULL == omb_init_h.omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    coll = omb_coll_by_name(options.omb_tune_coll);
+    if (-1 == coll) {
+        if (0 == rank) {
+            fprintf(stderr, "Unknown collective %s\n", options.omb_tune_coll);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    omb_mpit_init();
+    if (omb_mpit_find_algorithm_cvar(omb_coll_name(coll), &cvar)) {
+        if (0 == rank) {
+            fprintf(stderr,
+                    "No writable algorithm selection control variable found"
+                    " for %s\n",
+                    omb_coll_name(coll));
+        }
+        omb_mpit_finalize();
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    omb_mpit_enable_dynamic_rules(&cvar, omb_coll_name(coll), rank);
+
+    for (size = options.min_message_size;
+         size <= options.max_message_size && num_sizes < TUNE_MAX_SIZES;
+         size *= 2) {
+        sizes[num_sizes++] = size;
+        if (OMB_COLL_BARRIER == coll) {
+            break;
+        }
+    }
+    for (nprocs = 2; num_comm_sizes < TUNE_MAX_COMM_SIZES - 1;
+         nprocs *= 2) {
+        comm_sizes[num_comm_sizes++] = MIN(nprocs, numprocs);
+        if (nprocs >= numprocs) {
+            break;
+        }
+    }
+    bufsize = options.max_message_size * numprocs;
+    sendbuf = malloc(bufsize);
+    recvbuf = malloc(bufsize);
+    recvcounts = malloc(numprocs * sizeof(int));
+    OMB_CHECK_NULL_AND_EXIT(sendbuf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recvbuf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recvcounts, "Unable to allocate memory");
+    memset(sendbuf, 0, bufsize);
+    memset(recvbuf, 0, bufsize);
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Collective: %s\n", omb_coll_name(coll));
+        fprintf(stdout, "# Control variable: %s (%d candidates)\n", cvar.name,
+                cvar.num_candidates);
+        fprintf(stdout, "# Avg Latency(us) per candidate algorithm\n\n");
+        fflush(stdout);
+    }
+    for (nprocs = 0; nprocs < num_comm_sizes; nprocs++) {
+        tune_comm_size(rank, nprocs);
+    }
+    if (0 == rank && options.omb_tune_file[0]) {
+        write_tuning_file();
+    }
+
+    omb_mpit_cvar_free(&cvar);
+    omb_mpit_finalize();
+    free(sendbuf);
+    free(recvbuf);
+    free(recvcounts);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,252 @@
+#define BENCHMARK "OSU MPI%s Concurrent Collectives Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+static const char *group_pattern_names[] = {"node", "stride", "row", "col"};
+
+char *sendbuf = NULL, *recvbuf = NULL;
+int *recvcounts = NULL;
+int coll = OMB_COLL_ALLREDUCE, nonblocking = 0;
+
+/* Average latency over the ranks of comm in us, valid at rank 0. */
+static double time_coll(MPI_Comm comm, size_t size, int nprocs)
+{
+    int i = 0, count = omb_coll_count(coll, size);
+    int iterations = options.iterations, skip = options.skip;
+    double t_start = 0.0, timer = 0.0, lat = 0.0, avg = 0.0;
+
+    if (size > LARGE_MESSAGE_SIZE) {
+        iterations = options.iterations_large;
+        skip = options.skip_large;
+    }
+    MPI_CHECK(MPI_Barrier(comm));
+    for (i = 0; i < skip + iterations; i++) {
+        t_start = MPI_Wtime();
+        omb_coll_run(coll, comm, nprocs, sendbuf, recvbuf, recvcounts, count,
+                     nonblocking);
+        if (i >= skip) {
+            timer += MPI_Wtime() - t_start;
+        }
+        MPI_CHECK(MPI_Barrier(comm));
+    }
+    lat = timer * 1e6 / iterations;
+    MPI_CHECK(MPI_Reduce(&lat, &avg, 1, MPI_DOUBLE, MPI_SUM, 0, comm));
+    return avg / nprocs;
+}
+
+/* Columns of the most square grid of numprocs ranks. */
+static int grid_columns(int numprocs)
+{
+    int rows = 1, i = 0;
+
+    for (i = 1; i * i <= numprocs; i++) {
+        if (0 == numprocs % i) {
+            rows = i;
+        }
+    }
+    return numprocs / rows;
+}
+
+/*
+ * Group of this process. Nodes are numbered by their lowest world rank, the
+ * grid is filled row by row in the order of the world ranks.
+ */
+static int group_color(int rank, int columns)
+{
+    int local_rank = 0, node = 0;
+    MPI_Comm node_comm = MPI_COMM_NULL, leader_comm = MPI_COMM_NULL;
+
+    switch (options.group_pattern) {
+        case OMB_GROUP_NODE:
+            MPI_CHECK(MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED,
+                                          rank, MPI_INFO_NULL, &node_comm));
+            MPI_CHECK(MPI_Comm_rank(node_comm, &local_rank));
+            MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD,
+                                     0 == local_rank ? 0 : MPI_UNDEFINED, rank,
+                                     &leader_comm));
+            if (0 == local_rank) {
+                MPI_CHECK(MPI_Comm_rank(leader_comm, &node));
+                MPI_CHECK(MPI_Comm_free(&leader_comm));
+            }
+            MPI_CHECK(MPI_Bcast(&node, 1, MPI_INT, 0, node_comm));
+            MPI_CHECK(MPI_Comm_free(&node_comm));
+            return node;
+        case OMB_GROUP_STRIDE:
+            return rank % (options.group_arg ? options.group_arg : 2);
+        case OMB_GROUP_ROW:
+            return rank / columns;
+        case OMB_GROUP_COL:
+            return rank % columns;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = PO_OKAY, i = 0, g = 0;
+    int group = 0, group_rank = 0, group_size = 0, num_groups = 0;
+    int min_group_size = 0, columns = 0;
+    size_t size = 0, bufsize = 0;
+    double alone = 0.0, concurrent = 0.0;
+    double local[4], *all = NULL;
+    MPI_Comm group_comm = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = COLLECTIVE;
+    options.subtype = COLL_CONCURRENT;
+    set_header(HEADER);
+    set_benchmark_name("osu_coll_concurrent");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    if (MPI_COMM_NULL == omb_init_h.omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    nonblocking = 'i' == options.omb_tune_coll[0];
+    coll = omb_coll_by_name(options.omb_tune_coll + nonblocking);
+    if (-1 == coll) {
+        if (0 == rank) {
+            fprintf(stderr, "Unknown collective %s\n", options.omb_tune_coll);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    columns = options.group_arg ? options.group_arg : grid_columns(numprocs);
+    if ((OMB_GROUP_ROW == options.group_pattern ||
+         OMB_GROUP_COL == options.group_pattern) &&
+        0 != numprocs % columns) {
+        if (0 == rank) {
+            fprintf(stderr, "%d processes do not fill a grid of %d columns\n",
+                    numprocs, columns);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    group = group_color(rank, columns);
+    MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD, group, rank, &group_comm));
+    MPI_CHECK(MPI_Comm_rank(group_comm, &group_rank));
+    MPI_CHECK(MPI_Comm_size(group_comm, &group_size));
+    MPI_CHECK(MPI_Allreduce(&group, &num_groups, 1, MPI_INT, MPI_MAX,
+                            MPI_COMM_WORLD));
+    num_groups++;
+    MPI_CHECK(MPI_Allreduce(&group_size, &min_group_size, 1, MPI_INT, MPI_MIN,
+                            MPI_COMM_WORLD));
+    if (num_groups < 2 || min_group_size < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test needs at least two groups of at least"
+                            " two processes, got %d group(s) of %d or more\n",
+                    num_groups, min_group_size);
+        }
+        MPI_CHECK(MPI_Comm_free(&group_comm));
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    bufsize = options.max_message_size * group_size;
+    sendbuf = malloc(bufsize);
+    recvbuf = malloc(bufsize);
+    recvcounts = malloc(group_size * sizeof(int));
+    OMB_CHECK_NULL_AND_EXIT(sendbuf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recvbuf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recvcounts, "Unable to allocate memory");
+    memset(sendbuf, 0, bufsize);
+    memset(recvbuf, 0, bufsize);
+    if (0 == rank) {
+        all = malloc(4 * numprocs * sizeof(double));
+        OMB_CHECK_NULL_AND_EXIT(all, "Unable to allocate memory");
+    }
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Collective: %s\n", options.omb_tune_coll);
+        fprintf(stdout, "# Groups: %d by %s", num_groups,
+                group_pattern_names[options.group_pattern]);
+        if (OMB_GROUP_ROW == options.group_pattern ||
+            OMB_GROUP_COL == options.group_pattern) {
+            fprintf(stdout, " of a %d x %d grid", numprocs / columns,
+                    columns);
+        }
+        fprintf(stdout, "\n# Alone: every group timed on its own, in turn\n");
+        fprintf(stdout, "# Concurrent: all groups at the same time\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Group", FIELD_WIDTH, "Ranks", FIELD_WIDTH, "Alone(us)",
+                FIELD_WIDTH, "Concurrent(us)", FIELD_WIDTH, "Slowdown");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size *= 2) {
+        if (0 == omb_coll_count(coll, size)) {
+            continue;
+        }
+        /* the other groups wait in the barrier while one group runs */
+        for (g = 0; g < num_groups; g++) {
+            if (g == group) {
+                alone = time_coll(group_comm, size, group_size);
+            }
+            MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+        }
+        concurrent = time_coll(group_comm, size, group_size);
+        MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+
+        local[0] = 0 == group_rank ? group : -1;
+        local[1] = group_size;
+        local[2] = alone;
+        local[3] = concurrent;
+        MPI_CHECK(MPI_Gather(local, 4, MPI_DOUBLE, all, 4, MPI_DOUBLE, 0,
+                             MPI_COMM_WORLD));
+        for (g = 0; 0 == rank && g < num_groups; g++) {
+            for (i = 0; i < numprocs; i++) {
+                if (all[4 * i] == g) {
+                    break;
+                }
+            }
+            fprintf(stdout, "%-*zu%*d%*d", 10, size, FIELD_WIDTH, g,
+                    FIELD_WIDTH, (int)all[4 * i + 1]);
+            fprintf(stdout, "%*.*f%*.*f%*.*f\n", FIELD_WIDTH, FLOAT_PRECISION,
+                    all[4 * i + 2], FIELD_WIDTH, FLOAT_PRECISION,
+                    all[4 * i + 3], FIELD_WIDTH, FLOAT_PRECISION,
+                    all[4 * i + 3] / all[4 * i + 2]);
+            fflush(stdout);
+        }
+        if (OMB_COLL_BARRIER == coll) {
+            break;
+        }
+    }
+
+    free(sendbuf);
+    free(recvbuf);
+    free(recvcounts);
+    free(all);
+    MPI_CHECK(MPI_Comm_free(&group_comm));
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
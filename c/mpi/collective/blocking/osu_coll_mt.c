@@ -0,0 +1,249 @@
+#define BENCHMARK "OSU MPI%s Multi-threaded Collectives Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+typedef struct thread_tag {
+    int id;
+    MPI_Comm comm;
+    char *sendbuf;
+    char *recvbuf;
+    int *recvcounts;
+} thread_tag_t;
+
+pthread_barrier_t thread_barrier;
+
+int coll = OMB_COLL_ALLREDUCE, numprocs = 0, num_threads = 0, pinned = 0;
+int iterations = 0, skip = 0;
+size_t size = 0;
+double t_start = 0.0, t_end = 0.0;
+double thread_time[MAX_NUM_THREADS];
+
+/*
+ * Whether the buffers hold one block per process. reduce_scatter sends at
+ * least one float to every process, even for messages smaller than that.
+ */
+static int mt_per_process_buffers(void)
+{
+    return OMB_COLL_ALLGATHER == coll || OMB_COLL_ALLTOALL == coll ||
+           OMB_COLL_GATHER == coll || OMB_COLL_SCATTER == coll ||
+           OMB_COLL_REDUCE_SCATTER == coll;
+}
+
+/* Starts the timer at thread 0 once all threads of all ranks are ready. */
+static void sync_threads(int id, double *t)
+{
+    pthread_barrier_wait(&thread_barrier);
+    if (0 == id) {
+        MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+        *t = MPI_Wtime();
+    }
+    pthread_barrier_wait(&thread_barrier);
+}
+
+void *coll_thread(void *arg)
+{
+    thread_tag_t *tag = (thread_tag_t *)arg;
+    int i = 0, count = omb_coll_count(coll, size);
+
+    if (pinned) {
+        omb_affinity_bind_thread(tag->id);
+    }
+    for (i = 0; i < skip + iterations; i++) {
+        if (i == skip) {
+            sync_threads(tag->id, &t_start);
+        }
+        omb_coll_run(coll, tag->comm, numprocs, tag->sendbuf, tag->recvbuf,
+                     tag->recvcounts, count, 0);
+    }
+    thread_time[tag->id] = MPI_Wtime() - t_start;
+    sync_threads(tag->id, &t_end);
+
+    return NULL;
+}
+
+/*
+ * Runs one round of all threads. stats receives the minimum, sum and maximum
+ * collectives/s of a single thread and the aggregate collectives/s of all
+ * threads, valid at rank 0.
+ */
+static void run_threads(thread_tag_t *tags, double *stats)
+{
+    int i = 0;
+    double rate = 0.0, local_min = 0.0, local_sum = 0.0, local_max = 0.0;
+    double t = 0.0, t_max = 0.0;
+    pthread_t threads[MAX_NUM_THREADS];
+
+    pthread_barrier_init(&thread_barrier, NULL, num_threads);
+    for (i = 0; i < num_threads; i++) {
+        pthread_create(&threads[i], NULL, coll_thread, &tags[i]);
+    }
+    for (i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&thread_barrier);
+
+    for (i = 0; i < num_threads; i++) {
+        rate = iterations / thread_time[i];
+        local_min = i ? MIN(local_min, rate) : rate;
+        local_max = MAX(local_max, rate);
+        local_sum += rate;
+    }
+    t = t_end - t_start;
+    MPI_CHECK(MPI_Reduce(&local_min, &stats[0], 1, MPI_DOUBLE, MPI_MIN, 0,
+                         MPI_COMM_WORLD));
+    MPI_CHECK(MPI_Reduce(&local_sum, &stats[1], 1, MPI_DOUBLE, MPI_SUM, 0,
+                         MPI_COMM_WORLD));
+    MPI_CHECK(MPI_Reduce(&local_max, &stats[2], 1, MPI_DOUBLE, MPI_MAX, 0,
+                         MPI_COMM_WORLD));
+    MPI_CHECK(
+        MPI_Reduce(&t, &t_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD));
+    stats[3] = (double)num_threads * iterations / t_max;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, provided = 0, po_ret = PO_OKAY, i = 0, rounds = 0;
+    size_t bufsize = 0;
+    double stats[4];
+    thread_tag_t tags[MAX_NUM_THREADS];
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = COLLECTIVE;
+    options.subtype = COLL_MT;
+    set_header(HEADER);
+    set_benchmark_name("osu_coll_mt");
+    po_ret = process_options(argc, argv);
+
+    MPI_CHECK(MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided));
+    omb_init_h.omb_comm = MPI_COMM_WORLD;
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (provided != MPI_THREAD_MULTIPLE) {
+        if (0 == rank) {
+            fprintf(stderr,
+                    "MPI_Init_thread must return MPI_THREAD_MULTIPLE!\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    coll = omb_coll_by_name(options.omb_tune_coll);
+    if (-1 == coll) {
+        if (0 == rank) {
+            fprintf(stderr, "Unknown collective %s\n", options.omb_tune_coll);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    num_threads = options.num_threads;
+    if (OMB_AFFINITY_UNSET == options.affinity_policy) {
+        options.affinity_policy = OMB_AFFINITY_COMPACT;
+    }
+    omb_affinity_init(MPI_COMM_WORLD);
+    /* -H none keeps the placement of the launcher, nothing to pin */
+    rounds = OMB_AFFINITY_NONE == options.affinity_policy ? 1 : 2;
+    bufsize = MAX(options.max_message_size, sizeof(float));
+    if (mt_per_process_buffers()) {
+        bufsize *= numprocs;
+    }
+    /* the main thread creates the duplicates in the same order on all ranks */
+    for (i = 0; i < num_threads; i++) {
+        tags[i].id = i;
+        MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, &tags[i].comm));
+        tags[i].sendbuf = malloc(bufsize);
+        tags[i].recvbuf = malloc(bufsize);
+        tags[i].recvcounts = malloc(numprocs * sizeof(int));
+        OMB_CHECK_NULL_AND_EXIT(tags[i].sendbuf, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(tags[i].recvbuf, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(tags[i].recvcounts,
+                                "Unable to allocate memory");
+        memset(tags[i].sendbuf, 1, bufsize);
+        memset(tags[i].recvbuf, 0, bufsize);
+    }
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# [ collective: %s ] [ threads per process: %d ]\n",
+                omb_coll_name(coll), num_threads);
+        fprintf(stdout, "# Every thread runs the collective on its own"
+                        " MPI_Comm_dup of MPI_COMM_WORLD\n");
+        fprintf(stdout, "# Per thread: collectives/s of the slowest, average"
+                        " and fastest thread\n");
+        fprintf(stdout, "# Pinned: each thread bound to its own CPU of the"
+                        " process\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Pinned", FIELD_WIDTH, "Min Thread", FIELD_WIDTH,
+                "Avg Thread", FIELD_WIDTH, "Max Thread", FIELD_WIDTH,
+                "Total (coll/s)", FIELD_WIDTH, "Total (MB/s)");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size = (size ? size * 2 : 1)) {
+        if (0 == omb_coll_count(coll, size)) {
+            continue;
+        }
+        iterations = options.iterations;
+        skip = options.skip;
+        if (size > LARGE_MESSAGE_SIZE) {
+            iterations = options.iterations_large;
+            skip = options.skip_large;
+        }
+        for (pinned = 0; pinned < rounds; pinned++) {
+            run_threads(tags, stats);
+            if (0 == rank) {
+                fprintf(stdout, "%-*zu%*s", 10, size, FIELD_WIDTH,
+                        pinned ? "yes" : "no");
+                fprintf(stdout, "%*.*f%*.*f%*.*f%*.*f%*.*f\n", FIELD_WIDTH,
+                        FLOAT_PRECISION, stats[0], FIELD_WIDTH,
+                        FLOAT_PRECISION, stats[1] / (numprocs * num_threads),
+                        FIELD_WIDTH, FLOAT_PRECISION, stats[2], FIELD_WIDTH,
+                        FLOAT_PRECISION, stats[3], FIELD_WIDTH,
+                        FLOAT_PRECISION, stats[3] * size / 1e6);
+                fflush(stdout);
+            }
+        }
+    }
+
+    for (i = 0; i < num_threads; i++) {
+        MPI_CHECK(MPI_Comm_free(&tags[i].comm));
+        free(tags[i].sendbuf);
+        free(tags[i].recvbuf);
+        free(tags[i].recvcounts);
+    }
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
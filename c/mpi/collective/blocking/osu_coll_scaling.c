@@ -0,0 +1,251 @@
+#define BENCHMARK "OSU MPI%s Collective Communicator Size Scaling Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+#define SCALING_MAX_SIZES 32
+
+char *sendbuf = NULL, *recvbuf = NULL;
+int *recvcounts = NULL;
+int coll = OMB_COLL_ALLREDUCE;
+int num_sizes = 0, num_comm_sizes = 0, num_nodes = 0;
+size_t sizes[SCALING_MAX_SIZES];
+int comm_sizes[OMB_MAX_COMM_SIZES];
+double latency[OMB_MAX_COMM_SIZES][SCALING_MAX_SIZES];
+
+/* Average latency over the ranks of comm in us, valid at rank 0. */
+static double time_coll(MPI_Comm comm, size_t size, int nprocs)
+{
+    int i = 0, count = omb_coll_count(coll, size);
+    int iterations = options.iterations, skip = options.skip;
+    double t_start = 0.0, timer = 0.0, lat = 0.0, avg = 0.0;
+
+    if (size > LARGE_MESSAGE_SIZE) {
+        iterations = options.iterations_large;
+        skip = options.skip_large;
+    }
+    MPI_CHECK(MPI_Barrier(comm));
+    for (i = 0; i < skip + iterations; i++) {
+        t_start = MPI_Wtime();
+        omb_coll_run(coll, comm, nprocs, sendbuf, recvbuf, recvcounts, count,
+                     0);
+        if (i >= skip) {
+            timer += MPI_Wtime() - t_start;
+        }
+        MPI_CHECK(MPI_Barrier(comm));
+    }
+    lat = timer * 1e6 / iterations;
+    MPI_CHECK(MPI_Reduce(&lat, &avg, 1, MPI_DOUBLE, MPI_SUM, 0, comm));
+    return avg / nprocs;
+}
+
+/*
+ * Position of this process in the order in which the sub-communicators take
+ * ranks. Nodes are numbered by their lowest world rank, so world rank 0 is
+ * always first. Dense placement fills a node before moving on to the next
+ * one, spread placement takes the i-th rank of every node before the
+ * (i+1)-th rank of any node.
+ */
+static int carve_position(int rank, int numprocs)
+{
+    int local_rank = 0, node = 0, leader = 0, pos = 0, i = 0;
+    int key[2], *keys = NULL;
+    MPI_Comm node_comm = MPI_COMM_NULL, leader_comm = MPI_COMM_NULL;
+
+    MPI_CHECK(MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank,
+                                  MPI_INFO_NULL, &node_comm));
+    MPI_CHECK(MPI_Comm_rank(node_comm, &local_rank));
+    leader = 0 == local_rank;
+    MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD, leader ? 0 : MPI_UNDEFINED, rank,
+                             &leader_comm));
+    if (leader) {
+        MPI_CHECK(MPI_Comm_rank(leader_comm, &node));
+        MPI_CHECK(MPI_Comm_size(leader_comm, &num_nodes));
+        MPI_CHECK(MPI_Comm_free(&leader_comm));
+    }
+    MPI_CHECK(MPI_Bcast(&node, 1, MPI_INT, 0, node_comm));
+    MPI_CHECK(MPI_Bcast(&num_nodes, 1, MPI_INT, 0, MPI_COMM_WORLD));
+    MPI_CHECK(MPI_Comm_free(&node_comm));
+
+    keys = malloc(2 * numprocs * sizeof(int));
+    OMB_CHECK_NULL_AND_EXIT(keys, "Unable to allocate memory");
+    if (OMB_CARVE_SPREAD == options.carve_type) {
+        key[0] = local_rank;
+        key[1] = node;
+    } else {
+        key[0] = node;
+        key[1] = local_rank;
+    }
+    MPI_CHECK(MPI_Allgather(key, 2, MPI_INT, keys, 2, MPI_INT,
+                            MPI_COMM_WORLD));
+    for (i = 0; i < numprocs; i++) {
+        if (keys[2 * i] < key[0] ||
+            (keys[2 * i] == key[0] && keys[2 * i + 1] < key[1])) {
+            pos++;
+        }
+    }
+    free(keys);
+    return pos;
+}
+
+static void print_table(void)
+{
+    int comm_idx = 0, size_idx = 0;
+
+    fprintf(stdout, "%-*s", 10, "# Size");
+    for (comm_idx = 0; comm_idx < num_comm_sizes; comm_idx++) {
+        fprintf(stdout, "%*d", FIELD_WIDTH, comm_sizes[comm_idx]);
+    }
+    fprintf(stdout, "\n");
+    for (size_idx = 0; size_idx < num_sizes; size_idx++) {
+        if (0 == omb_coll_count(coll, sizes[size_idx])) {
+            continue;
+        }
+        fprintf(stdout, "%-*zu", 10, sizes[size_idx]);
+        for (comm_idx = 0; comm_idx < num_comm_sizes; comm_idx++) {
+            fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                    latency[comm_idx][size_idx]);
+        }
+        fprintf(stdout, "\n");
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, nprocs = 0, pos = 0, po_ret = PO_OKAY;
+    int comm_idx = 0, size_idx = 0;
+    size_t size = 0, bufsize = 0;
+    MPI_Comm sub_comm = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = COLLECTIVE;
+    options.subtype = COLL_SCALING;
+    set_header(HEADER);
+    set_benchmark_name("osu_coll_scaling");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    if (MPI_COMM_NULL == omb_init_h.omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    coll = omb_coll_by_name(options.omb_tune_coll);
+    if (-1 == coll) {
+        if (0 == rank) {
+            fprintf(stderr, "Unknown collective %s\n", options.omb_tune_coll);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    if (options.num_comm_sizes) {
+        for (comm_idx = 0; comm_idx < options.num_comm_sizes; comm_idx++) {
+            if (options.comm_sizes[comm_idx] > numprocs) {
+                if (0 == rank) {
+                    fprintf(stderr,
+                            "Communicator size %d exceeds the %d processes\n",
+                            options.comm_sizes[comm_idx], numprocs);
+                }
+                omb_mpi_finalize(omb_init_h);
+                exit(EXIT_FAILURE);
+            }
+            comm_sizes[num_comm_sizes++] = options.comm_sizes[comm_idx];
+        }
+    } else {
+        for (nprocs = 2; num_comm_sizes < OMB_MAX_COMM_SIZES; nprocs *= 2) {
+            comm_sizes[num_comm_sizes++] = MIN(nprocs, numprocs);
+            if (nprocs >= numprocs) {
+                break;
+            }
+        }
+    }
+    for (size = options.min_message_size;
+         size <= options.max_message_size && num_sizes < SCALING_MAX_SIZES;
+         size *= 2) {
+        sizes[num_sizes++] = size;
+        if (OMB_COLL_BARRIER == coll) {
+            break;
+        }
+    }
+
+    bufsize = options.max_message_size * numprocs;
+    sendbuf = malloc(bufsize);
+    recvbuf = malloc(bufsize);
+    recvcounts = malloc(numprocs * sizeof(int));
+    OMB_CHECK_NULL_AND_EXIT(sendbuf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recvbuf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recvcounts, "Unable to allocate memory");
+    memset(sendbuf, 0, bufsize);
+    memset(recvbuf, 0, bufsize);
+    pos = carve_position(rank, numprocs);
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Collective: %s\n", omb_coll_name(coll));
+        fprintf(stdout, "# Placement: %s over %d node(s)\n",
+                OMB_CARVE_SPREAD == options.carve_type ?
+                    "spread (one rank per node first)" :
+                    "dense (fill a node first)",
+                num_nodes);
+        fprintf(stdout, "# Avg Latency(us) per communicator size\n");
+        fflush(stdout);
+    }
+    for (comm_idx = 0; comm_idx < num_comm_sizes; comm_idx++) {
+        nprocs = comm_sizes[comm_idx];
+        MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD,
+                                 pos < nprocs ? 0 : MPI_UNDEFINED, pos,
+                                 &sub_comm));
+        if (MPI_COMM_NULL != sub_comm) {
+            for (size_idx = 0; size_idx < num_sizes; size_idx++) {
+                if (0 == omb_coll_count(coll, sizes[size_idx])) {
+                    continue;
+                }
+                latency[comm_idx][size_idx] =
+                    time_coll(sub_comm, sizes[size_idx], nprocs);
+            }
+            MPI_CHECK(MPI_Comm_free(&sub_comm));
+        }
+        MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+    }
+    if (0 == rank) {
+        print_table();
+    }
+
+    free(sendbuf);
+    free(recvbuf);
+    free(recvcounts);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
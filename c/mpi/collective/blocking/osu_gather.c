@@ -156,6 +156,7 @@ int main(int argc, char *argv[])
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
                 if (1 == options.omb_enable_mpi_in_place) {
                     if (root_rank == rank) {
                         MPI_CHECK(MPI_Gather(MPI_IN_PLACE, num_elements,
@@ -175,6 +175,7 @@ int main(int argc, char *argv[])
                 }
 
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
 
                 if (1 == options.omb_enable_mpi_in_place) {
                     if (root_rank == rank) {
@@ -0,0 +1,259 @@
+#define BENCHMARK "OSU MPI%s Reduce_local Throughput Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+#if defined(__AVX__)
+#define VECTOR_BYTES 32
+#else
+#define VECTOR_BYTES 16
+#endif
+
+enum reduce_local_kernels_t {
+    KERNEL_MPI,
+    KERNEL_LOOP,
+    KERNEL_VECTOR,
+    NUM_KERNELS
+};
+
+#if defined(__GNUC__)
+#define VECTOR_LOOP(body)                                                      \
+    for (i = 0; i < count / lanes; i++) {                                      \
+        body;                                                                  \
+    }
+
+/*
+ * Reduces whole VECTOR_BYTES wide vectors with the GCC vector extensions and
+ * leaves the tail to the plain loop. Integer arithmetic goes through the
+ * unsigned type utype so that it wraps, max and min blend with the
+ * comparison mask of type mtype.
+ */
+#define REDUCE_VECTOR(ctype, mtype, utype)                                     \
+    do {                                                                       \
+        typedef ctype vec_t __attribute__((vector_size(VECTOR_BYTES)));        \
+        typedef mtype mask_t __attribute__((vector_size(VECTOR_BYTES)));       \
+        typedef utype uvec_t __attribute__((vector_size(VECTOR_BYTES)));       \
+        const vec_t *restrict a = (const vec_t *)in;                           \
+        vec_t *restrict b = (vec_t *)inout;                                    \
+        mask_t m;                                                              \
+        lanes = VECTOR_BYTES / sizeof(ctype);                                  \
+        switch (op) {                                                          \
+            case OMB_OP_PROD:                                                  \
+                VECTOR_LOOP(b[i] = (vec_t)((uvec_t)b[i] * (uvec_t)a[i]));      \
+                break;                                                         \
+            case OMB_OP_BAND:                                                  \
+                VECTOR_LOOP(b[i] = (vec_t)((mask_t)b[i] & (mask_t)a[i]));      \
+                break;                                                         \
+            case OMB_OP_MAX:                                                   \
+                VECTOR_LOOP(m = (mask_t)(b[i] < a[i]);                         \
+                            b[i] = (vec_t)(((mask_t)a[i] & m) |                \
+                                           ((mask_t)b[i] & ~m)));              \
+                break;                                                         \
+            case OMB_OP_MIN:                                                   \
+                VECTOR_LOOP(m = (mask_t)(a[i] < b[i]);                         \
+                            b[i] = (vec_t)(((mask_t)a[i] & m) |                \
+                                           ((mask_t)b[i] & ~m)));              \
+                break;                                                         \
+            default:                                                           \
+                VECTOR_LOOP(b[i] = (vec_t)((uvec_t)b[i] + (uvec_t)a[i]));      \
+                break;                                                         \
+        }                                                                      \
+        tail = (count / lanes) * lanes;                                        \
+        omb_reduce_local((const ctype *)in + tail, (ctype *)inout + tail,      \
+                         count - tail, dtype, op);                             \
+    } while (0)
+#endif
+
+/* Whether the explicitly vectorized loop covers the datatype. */
+static int vector_supported(MPI_Datatype dtype)
+{
+#if defined(__GNUC__)
+    return MPI_SIGNED_CHAR == dtype || MPI_INT == dtype ||
+           MPI_INT64_T == dtype || MPI_FLOAT == dtype || MPI_DOUBLE == dtype;
+#else
+    return 0;
+#endif
+}
+
+static void reduce_vector(const void *in, void *inout, int count,
+                          MPI_Datatype dtype, enum omb_reduce_ops_t op)
+{
+#if defined(__GNUC__)
+    int i = 0, lanes = 0, tail = 0;
+
+    if (MPI_SIGNED_CHAR == dtype) {
+        REDUCE_VECTOR(signed char, signed char, unsigned char);
+    } else if (MPI_INT == dtype) {
+        REDUCE_VECTOR(int32_t, int32_t, uint32_t);
+    } else if (MPI_INT64_T == dtype) {
+        REDUCE_VECTOR(int64_t, int64_t, uint64_t);
+    } else if (MPI_FLOAT == dtype) {
+        REDUCE_VECTOR(float, int32_t, float);
+    } else if (MPI_DOUBLE == dtype) {
+        REDUCE_VECTOR(double, int64_t, double);
+    }
+#endif
+}
+
+/* Seconds per call of kernel, averaged over the iterations. */
+static double time_kernel(int kernel, void *inbuf, void *inoutbuf, int count,
+                          MPI_Datatype dtype, MPI_Op mpi_op, size_t size)
+{
+    int i = 0, iterations = options.iterations, skip = options.skip;
+    /* the plain loop of a user-defined operator is its sum kernel */
+    enum omb_reduce_ops_t op =
+        OMB_OP_USER == options.reduce_op ? OMB_OP_SUM : options.reduce_op;
+    double t_start = 0.0;
+
+    if (size > LARGE_MESSAGE_SIZE) {
+        iterations = options.iterations_large;
+        skip = options.skip_large;
+    }
+    for (i = 0; i < skip + iterations; i++) {
+        if (i == skip) {
+            t_start = MPI_Wtime();
+        }
+        switch (kernel) {
+            case KERNEL_MPI:
+                MPI_CHECK(
+                    MPI_Reduce_local(inbuf, inoutbuf, count, dtype, mpi_op));
+                break;
+            case KERNEL_LOOP:
+                omb_reduce_local(inbuf, inoutbuf, count, dtype, op);
+                break;
+            case KERNEL_VECTOR:
+                reduce_vector(inbuf, inoutbuf, count, dtype, op);
+                break;
+        }
+    }
+    return (MPI_Wtime() - t_start) / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = PO_OKAY, count = 0, i = 0;
+    int kernel = 0, mpi_type_itr = 0, mpi_type_size = 0;
+    int mpi_type_name_length = 0;
+    size_t size = 0, max_count = 0;
+    double rate = 0.0, avg_rate = 0.0;
+    void *inbuf = NULL, *inoutbuf = NULL;
+    char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
+    MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
+    MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = COLLECTIVE;
+    options.subtype = REDUCE_LOCAL;
+    set_header(HEADER);
+    set_benchmark_name("osu_reduce_local");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    if (MPI_COMM_NULL == omb_init_h.omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+
+    if (posix_memalign(&inbuf, sysconf(_SC_PAGESIZE),
+                       options.max_message_size) ||
+        posix_memalign(&inoutbuf, sysconf(_SC_PAGESIZE),
+                       options.max_message_size)) {
+        OMB_ERROR_EXIT("Unable to allocate memory");
+    }
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Throughput counts the bytes read from both buffers"
+                        " and written back (3 x size),\n");
+        fprintf(stdout, "# averaged over %d concurrent process(es).\n",
+                numprocs);
+        fflush(stdout);
+    }
+    for (mpi_type_itr = 0; mpi_type_itr < options.omb_dtype_itr;
+         mpi_type_itr++) {
+        MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
+        omb_curr_datatype = mpi_type_list[mpi_type_itr];
+        OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
+        MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
+                                    &mpi_type_name_length));
+        max_count = options.max_message_size / mpi_type_size;
+        for (i = 0; i < max_count; i++) {
+            omb_assign_to_type(inbuf, i, 1, omb_curr_datatype);
+            omb_assign_to_type(inoutbuf, i, 1, omb_curr_datatype);
+        }
+        if (0 == rank) {
+            fprintf(stdout, "# Datatype: %s.\n", mpi_type_name_str);
+            fprintf(stdout, "%-*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                    "MPI (GB/s)", FIELD_WIDTH, "Loop (GB/s)", FIELD_WIDTH,
+                    "Vector (GB/s)");
+            fflush(stdout);
+        }
+        for (size = options.min_message_size; size <= options.max_message_size;
+             size *= 2) {
+            count = omb_get_num_elements(size, omb_curr_datatype);
+            if (0 == count) {
+                continue;
+            }
+            if (0 == rank) {
+                fprintf(stdout, "%-*zu", 10, size);
+            }
+            for (kernel = 0; kernel < NUM_KERNELS; kernel++) {
+                if (KERNEL_VECTOR == kernel &&
+                    !vector_supported(omb_curr_datatype)) {
+                    if (0 == rank) {
+                        fprintf(stdout, "%*s", FIELD_WIDTH, "-");
+                    }
+                    continue;
+                }
+                MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+                rate = 3.0 * count * mpi_type_size /
+                       time_kernel(kernel, inbuf, inoutbuf, count,
+                                   omb_curr_datatype, omb_curr_op, size) /
+                       1e9;
+                MPI_CHECK(MPI_Reduce(&rate, &avg_rate, 1, MPI_DOUBLE, MPI_SUM,
+                                     0, MPI_COMM_WORLD));
+                if (0 == rank) {
+                    fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                            avg_rate / numprocs);
+                }
+            }
+            if (0 == rank) {
+                fprintf(stdout, "\n");
+                fflush(stdout);
+            }
+        }
+    }
+
+    free(inbuf);
+    free(inoutbuf);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
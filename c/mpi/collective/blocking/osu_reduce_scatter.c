@@ -27,6 +27,7 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
     int mpi_type_itr = 0, mpi_type_size = 0, mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
@@ -43,7 +44,6 @@ int main(int argc, char *argv[])
     options.subtype = REDUCE_SCATTER;
 
     po_ret = process_options(argc, argv);
-    omb_populate_mpi_type_list(mpi_type_list);
 
     if (PO_OKAY == po_ret && NONE != options.accel) {
         if (init_accel()) {
@@ -59,6 +59,7 @@ int main(int argc, char *argv[])
     }
     MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
     MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
 
     omb_graph_options_init(&omb_graph_options);
     switch (po_ret) {
@@ -126,6 +127,7 @@ int main(int argc, char *argv[])
         MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
         omb_curr_datatype = mpi_type_list[mpi_type_itr];
         OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
         MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
                                     &mpi_type_name_length));
         OMB_MPI_RUN_AT_RANK_ZERO(
@@ -180,15 +182,16 @@ int main(int argc, char *argv[])
                         MPI_CHECK(MPI_Barrier(omb_comm));
                         MPI_CHECK(MPI_Reduce_scatter(
                             sendbuf_warmup, recvbuf_warmup, recvcounts,
-                            omb_curr_datatype, MPI_SUM, omb_comm));
+                            omb_curr_datatype, omb_curr_op, omb_comm));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
 
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
 
                 MPI_CHECK(MPI_Reduce_scatter(sendbuf, recvbuf, recvcounts,
-                                             omb_curr_datatype, MPI_SUM,
+                                             omb_curr_datatype, omb_curr_op,
                                              omb_comm));
                 t_stop = MPI_Wtime();
 
@@ -167,6 +167,7 @@ int main(int argc, char *argv[])
                 }
 
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
 
                 if (root_rank == rank && 1 == options.omb_enable_mpi_in_place) {
                     OMB_CHECK_NULL_AND_EXIT(recvbuf, "recvbug is null");
@@ -186,6 +186,7 @@ int main(int argc, char *argv[])
                 }
 
                 t_start = MPI_Wtime();
+                t_start += omb_skew_inject(rank, numprocs);
                 if (root_rank == rank && 1 == options.omb_enable_mpi_in_place) {
                     MPI_CHECK(MPI_Scatterv(recvbuf, sendcounts, sdispls,
                                            omb_curr_datatype, MPI_IN_PLACE,
@@ -0,0 +1,428 @@
+#define BENCHMARK "OSU MPI%s Sparse Exchange Comparison Latency Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+/*
+ * One sparse pattern (the neighborhood selected with -N) is exchanged by every
+ * variant on the same buffers:
+ *  - MPI_Alltoallv over the full communicator with zero counts for every
+ *    process that is not a neighbor,
+ *  - MPI_Neighbor_alltoallv over a distributed graph communicator,
+ *  - hand-rolled MPI_Irecv/MPI_Isend followed by MPI_Waitall,
+ *  - MPI_Neighbor_alltoallv_init/MPI_Start (MPI-4 only).
+ */
+#define OMB_SPARSE_TAG 100
+
+enum omb_sparse_variant_t {
+    OMB_SPARSE_ALLTOALLV,
+    OMB_SPARSE_NEIGHBOR,
+    OMB_SPARSE_ISEND_IRECV,
+    OMB_SPARSE_PERSISTENT,
+    OMB_SPARSE_NUM_VARIANTS
+};
+
+static const char *omb_sparse_variant_names[OMB_SPARSE_NUM_VARIANTS] = {
+    "Alltoallv", "Neighbor", "Isend/Irecv", "Persistent"};
+
+#ifdef _ENABLE_MPI4_
+static const int omb_sparse_variant_enabled[OMB_SPARSE_NUM_VARIANTS] = {1, 1,
+                                                                        1, 1};
+#else
+static const int omb_sparse_variant_enabled[OMB_SPARSE_NUM_VARIANTS] = {1, 1,
+                                                                        1, 0};
+#endif
+
+static size_t omb_sparse_rss_growth(size_t rss_before)
+{
+    size_t rss_now = omb_get_resident_memory();
+
+    return rss_now > rss_before ? rss_now - rss_before : 0;
+}
+
+static void print_sparse_header(int rank)
+{
+    int v = 0;
+    char column[OMB_DATATYPE_STR_MAX_LEN];
+
+    if (rank) {
+        return;
+    }
+    fprintf(stdout, "%-*s", 10, "# Size");
+    for (v = 0; v < OMB_SPARSE_NUM_VARIANTS; v++) {
+        if (!omb_sparse_variant_enabled[v]) {
+            continue;
+        }
+        snprintf(column, sizeof(column), "%s(us)", omb_sparse_variant_names[v]);
+        fprintf(stdout, "%*s", FIELD_WIDTH, column);
+    }
+    fprintf(stdout, "\n");
+    fflush(stdout);
+}
+
+static void print_sparse_setup(int rank, int numprocs, MPI_Comm comm,
+                               double *setup_time, size_t *footprint,
+                               size_t *rss_growth)
+{
+    int v = 0;
+    double setup_sum[OMB_SPARSE_NUM_VARIANTS];
+    unsigned long long footprint_max[OMB_SPARSE_NUM_VARIANTS];
+    unsigned long long rss_max[OMB_SPARSE_NUM_VARIANTS];
+    unsigned long long local_footprint[OMB_SPARSE_NUM_VARIANTS];
+    unsigned long long local_rss[OMB_SPARSE_NUM_VARIANTS];
+
+    for (v = 0; v < OMB_SPARSE_NUM_VARIANTS; v++) {
+        local_footprint[v] = footprint[v];
+        local_rss[v] = rss_growth[v];
+    }
+    MPI_CHECK(MPI_Reduce(setup_time, setup_sum, OMB_SPARSE_NUM_VARIANTS,
+                         MPI_DOUBLE, MPI_SUM, 0, comm));
+    MPI_CHECK(MPI_Reduce(local_footprint, footprint_max,
+                         OMB_SPARSE_NUM_VARIANTS, MPI_UNSIGNED_LONG_LONG,
+                         MPI_MAX, 0, comm));
+    MPI_CHECK(MPI_Reduce(local_rss, rss_max, OMB_SPARSE_NUM_VARIANTS,
+                         MPI_UNSIGNED_LONG_LONG, MPI_MAX, 0, comm));
+    if (rank) {
+        return;
+    }
+    fprintf(stdout, "%-*s%*s%*s%*s\n", 14, "# Variant", FIELD_WIDTH,
+            "Setup(us)", FIELD_WIDTH, "Footprint(B)", FIELD_WIDTH,
+            "RSS growth(KB)");
+    for (v = 0; v < OMB_SPARSE_NUM_VARIANTS; v++) {
+        if (!omb_sparse_variant_enabled[v]) {
+            continue;
+        }
+        fprintf(stdout, "# %-*s%*.*f%*llu%*llu\n", 12,
+                omb_sparse_variant_names[v], FIELD_WIDTH, FLOAT_PRECISION,
+                setup_sum[v] * 1e6 / numprocs, FIELD_WIDTH, footprint_max[v],
+                FIELD_WIDTH, rss_max[v] / 1024);
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    int i = 0, k = 0, v = 0, rank = 0, numprocs = 0, po_ret = 0;
+    int disp = 0, reorder = 0;
+    size_t size = 0, bufsize = 0, rss_before = 0;
+    double t_start = 0.0, t_stop = 0.0, timer = 0.0;
+    double latency[OMB_SPARSE_NUM_VARIANTS];
+    double avg_latency[OMB_SPARSE_NUM_VARIANTS];
+    double setup_time[OMB_SPARSE_NUM_VARIANTS];
+    size_t footprint[OMB_SPARSE_NUM_VARIANTS];
+    size_t rss_growth[OMB_SPARSE_NUM_VARIANTS];
+    int num_sizes = 0;
+    char *sendbuf = NULL, *recvbuf = NULL;
+    int *sendcounts = NULL, *sdispls = NULL;
+    int *recvcounts = NULL, *rdispls = NULL;
+    int *peer_out = NULL, *peer_in = NULL;
+    int *nhbr_sendcounts = NULL, *nhbr_sdispls = NULL;
+    int *nhbr_recvcounts = NULL, *nhbr_rdispls = NULL;
+    int *indegree = NULL, *outdegree = NULL;
+    int *sources = NULL, *sourceweights = NULL;
+    int *destinations = NULL, *destweights = NULL;
+    MPI_Request *requests = NULL;
+    MPI_Comm omb_comm = MPI_COMM_NULL, comm_dist_graph = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+#ifdef _ENABLE_MPI4_
+    MPI_Request persistent_request = MPI_REQUEST_NULL;
+    MPI_Status reqstat;
+#endif
+
+    options.bench = COLLECTIVE;
+    options.subtype = NHBR_ALLTOALL;
+    set_header(HEADER);
+    set_benchmark_name("osu_sparse_alltoallv");
+    po_ret = process_options(argc, argv);
+    if (PO_OKAY == po_ret && NONE != options.accel) {
+        if (init_accel()) {
+            fprintf(stderr, "Error initializing device\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    for (v = 0; v < OMB_SPARSE_NUM_VARIANTS; v++) {
+        setup_time[v] = 0.0;
+        footprint[v] = 0;
+        rss_growth[v] = 0;
+    }
+    omb_neighborhood_create(omb_comm, &indegree, &sources, &sourceweights,
+                            &outdegree, &destinations, &destweights);
+    bufsize = options.max_message_size * MAX(MAX(*indegree, *outdegree), 1);
+    if (allocate_memory_coll((void **)&sendbuf, bufsize, options.accel)) {
+        fprintf(stderr, "Could Not Allocate Memory [rank %d]\n", rank);
+        MPI_CHECK(MPI_Abort(omb_comm, EXIT_FAILURE));
+    }
+    set_buffer(sendbuf, options.accel, 1, bufsize);
+    if (allocate_memory_coll((void **)&recvbuf, bufsize, options.accel)) {
+        fprintf(stderr, "Could Not Allocate Memory [rank %d]\n", rank);
+        MPI_CHECK(MPI_Abort(omb_comm, EXIT_FAILURE));
+    }
+    set_buffer(recvbuf, options.accel, 0, bufsize);
+
+    /* Dense alltoallv: one count and displacement per process */
+    rss_before = omb_get_resident_memory();
+    t_start = MPI_Wtime();
+    sendcounts = calloc(numprocs, sizeof(int));
+    sdispls = calloc(numprocs, sizeof(int));
+    recvcounts = calloc(numprocs, sizeof(int));
+    rdispls = calloc(numprocs, sizeof(int));
+    peer_out = calloc(numprocs, sizeof(int));
+    peer_in = calloc(numprocs, sizeof(int));
+    if (NULL == sendcounts || NULL == sdispls || NULL == recvcounts ||
+        NULL == rdispls || NULL == peer_out || NULL == peer_in) {
+        OMB_ERROR_EXIT("Unable to allocate memory");
+    }
+    for (k = 0; k < *outdegree; k++) {
+        peer_out[destinations[k]]++;
+    }
+    for (k = 0; k < *indegree; k++) {
+        peer_in[sources[k]]++;
+    }
+    setup_time[OMB_SPARSE_ALLTOALLV] = MPI_Wtime() - t_start;
+    rss_growth[OMB_SPARSE_ALLTOALLV] =
+        omb_sparse_rss_growth(rss_before);
+    footprint[OMB_SPARSE_ALLTOALLV] = 6 * numprocs * sizeof(int);
+
+    /* Neighborhood collectives: arrays sized by the degree only */
+    rss_before = omb_get_resident_memory();
+    t_start = MPI_Wtime();
+    MPI_CHECK(MPI_Dist_graph_create_adjacent(
+        omb_comm, *indegree, sources, sourceweights, *outdegree, destinations,
+        destweights, MPI_INFO_NULL, reorder, &comm_dist_graph));
+    nhbr_sendcounts = malloc(MAX(*outdegree, 1) * sizeof(int));
+    nhbr_sdispls = malloc(MAX(*outdegree, 1) * sizeof(int));
+    nhbr_recvcounts = malloc(MAX(*indegree, 1) * sizeof(int));
+    nhbr_rdispls = malloc(MAX(*indegree, 1) * sizeof(int));
+    if (NULL == nhbr_sendcounts || NULL == nhbr_sdispls ||
+        NULL == nhbr_recvcounts || NULL == nhbr_rdispls) {
+        OMB_ERROR_EXIT("Unable to allocate memory");
+    }
+    setup_time[OMB_SPARSE_NEIGHBOR] = MPI_Wtime() - t_start;
+    rss_growth[OMB_SPARSE_NEIGHBOR] =
+        omb_sparse_rss_growth(rss_before);
+    footprint[OMB_SPARSE_NEIGHBOR] =
+        4 * (*indegree + *outdegree) * sizeof(int);
+    setup_time[OMB_SPARSE_PERSISTENT] = setup_time[OMB_SPARSE_NEIGHBOR];
+    rss_growth[OMB_SPARSE_PERSISTENT] = rss_growth[OMB_SPARSE_NEIGHBOR];
+    footprint[OMB_SPARSE_PERSISTENT] =
+        footprint[OMB_SPARSE_NEIGHBOR] + sizeof(MPI_Request);
+
+    /* Point-to-point: one request per edge */
+    rss_before = omb_get_resident_memory();
+    t_start = MPI_Wtime();
+    requests = malloc(MAX(*indegree + *outdegree, 1) * sizeof(MPI_Request));
+    OMB_CHECK_NULL_AND_EXIT(requests, "Unable to allocate memory");
+    setup_time[OMB_SPARSE_ISEND_IRECV] = MPI_Wtime() - t_start;
+    rss_growth[OMB_SPARSE_ISEND_IRECV] =
+        omb_sparse_rss_growth(rss_before);
+    footprint[OMB_SPARSE_ISEND_IRECV] =
+        (*indegree + *outdegree) * (sizeof(int) + sizeof(MPI_Request));
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Edges per rank: in %d, out %d (rank 0)\n",
+                *indegree, *outdegree);
+        fprintf(stdout, "# Message buffers: %zu bytes per rank, shared by"
+                        " all variants\n",
+                2 * bufsize);
+    }
+    print_sparse_header(rank);
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size *= 2) {
+        if (0 == size) {
+            size = 1;
+        }
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.skip = options.skip_large;
+            options.iterations = options.iterations_large;
+        }
+        disp = 0;
+        for (k = 0; k < numprocs; k++) {
+            sendcounts[k] = peer_out[k] * size;
+            sdispls[k] = disp;
+            disp += sendcounts[k];
+        }
+        disp = 0;
+        for (k = 0; k < numprocs; k++) {
+            recvcounts[k] = peer_in[k] * size;
+            rdispls[k] = disp;
+            disp += recvcounts[k];
+        }
+        for (k = 0; k < *outdegree; k++) {
+            nhbr_sendcounts[k] = size;
+            nhbr_sdispls[k] = k * size;
+        }
+        for (k = 0; k < *indegree; k++) {
+            nhbr_recvcounts[k] = size;
+            nhbr_rdispls[k] = k * size;
+        }
+        for (v = 0; v < OMB_SPARSE_NUM_VARIANTS; v++) {
+            latency[v] = 0.0;
+            if (!omb_sparse_variant_enabled[v]) {
+                continue;
+            }
+#ifdef _ENABLE_MPI4_
+            if (OMB_SPARSE_PERSISTENT == v) {
+                rss_before = omb_get_resident_memory();
+                t_start = MPI_Wtime();
+                MPI_CHECK(MPI_Neighbor_alltoallv_init(
+                    sendbuf, nhbr_sendcounts, nhbr_sdispls, MPI_CHAR, recvbuf,
+                    nhbr_recvcounts, nhbr_rdispls, MPI_CHAR, comm_dist_graph,
+                    MPI_INFO_NULL, &persistent_request));
+                setup_time[OMB_SPARSE_PERSISTENT] += MPI_Wtime() - t_start;
+                rss_growth[OMB_SPARSE_PERSISTENT] =
+                    MAX(rss_growth[OMB_SPARSE_PERSISTENT],
+                        omb_sparse_rss_growth(rss_before));
+            }
+#endif
+            MPI_CHECK(MPI_Barrier(omb_comm));
+            timer = 0.0;
+            for (i = 0; i < options.iterations + options.skip; i++) {
+                t_start = MPI_Wtime();
+                switch (v) {
+                    case OMB_SPARSE_ALLTOALLV:
+                        MPI_CHECK(MPI_Alltoallv(sendbuf, sendcounts, sdispls,
+                                                MPI_CHAR, recvbuf, recvcounts,
+                                                rdispls, MPI_CHAR, omb_comm));
+                        break;
+                    case OMB_SPARSE_NEIGHBOR:
+                        MPI_CHECK(MPI_Neighbor_alltoallv(
+                            sendbuf, nhbr_sendcounts, nhbr_sdispls, MPI_CHAR,
+                            recvbuf, nhbr_recvcounts, nhbr_rdispls, MPI_CHAR,
+                            comm_dist_graph));
+                        break;
+                    case OMB_SPARSE_ISEND_IRECV:
+                        for (k = 0; k < *indegree; k++) {
+                            MPI_CHECK(MPI_Irecv(recvbuf + k * size, size,
+                                                MPI_CHAR, sources[k],
+                                                OMB_SPARSE_TAG, omb_comm,
+                                                &requests[k]));
+                        }
+                        for (k = 0; k < *outdegree; k++) {
+                            MPI_CHECK(MPI_Isend(
+                                sendbuf + k * size, size, MPI_CHAR,
+                                destinations[k], OMB_SPARSE_TAG, omb_comm,
+                                &requests[*indegree + k]));
+                        }
+                        MPI_CHECK(MPI_Waitall(*indegree + *outdegree, requests,
+                                              MPI_STATUSES_IGNORE));
+                        break;
+#ifdef _ENABLE_MPI4_
+                    case OMB_SPARSE_PERSISTENT:
+                        MPI_CHECK(MPI_Start(&persistent_request));
+                        MPI_CHECK(MPI_Wait(&persistent_request, &reqstat));
+                        break;
+#endif
+                }
+                t_stop = MPI_Wtime();
+                MPI_CHECK(MPI_Barrier(omb_comm));
+                if (i >= options.skip) {
+                    timer += t_stop - t_start;
+                }
+            }
+#ifdef _ENABLE_MPI4_
+            if (OMB_SPARSE_PERSISTENT == v) {
+                MPI_CHECK(MPI_Request_free(&persistent_request));
+            }
+#endif
+            latency[v] = timer * 1e6 / options.iterations;
+        }
+        num_sizes++;
+        MPI_CHECK(MPI_Reduce(latency, avg_latency, OMB_SPARSE_NUM_VARIANTS,
+                             MPI_DOUBLE, MPI_SUM, 0, omb_comm));
+        if (0 == rank) {
+            fprintf(stdout, "%-*zu", 10, size);
+            for (v = 0; v < OMB_SPARSE_NUM_VARIANTS; v++) {
+                if (!omb_sparse_variant_enabled[v]) {
+                    continue;
+                }
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        avg_latency[v] / numprocs);
+            }
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+
+    /* Persistent setup is the graph creation plus the average init cost */
+    if (num_sizes) {
+        setup_time[OMB_SPARSE_PERSISTENT] =
+            setup_time[OMB_SPARSE_NEIGHBOR] +
+            (setup_time[OMB_SPARSE_PERSISTENT] -
+             setup_time[OMB_SPARSE_NEIGHBOR]) /
+                num_sizes;
+    }
+    if (0 == rank) {
+        fprintf(stdout, "\n");
+    }
+    print_sparse_setup(rank, numprocs, omb_comm, setup_time, footprint,
+                       rss_growth);
+
+    free(requests);
+    free(nhbr_sendcounts);
+    free(nhbr_sdispls);
+    free(nhbr_recvcounts);
+    free(nhbr_rdispls);
+    free(sendcounts);
+    free(sdispls);
+    free(recvcounts);
+    free(rdispls);
+    free(peer_out);
+    free(peer_in);
+    free_buffer(sendbuf, options.accel);
+    free_buffer(recvbuf, options.accel);
+    free(destweights);
+    free(destinations);
+    free(sources);
+    free(sourceweights);
+    free(indegree);
+    free(outdegree);
+    MPI_CHECK(MPI_Comm_free(&comm_dist_graph));
+    omb_mpi_finalize(omb_init_h);
+    if (NONE != options.accel) {
+        if (cleanup_accel()) {
+            fprintf(stderr, "Error cleaning up device\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -30,6 +30,7 @@ int main(int argc, char *argv[])
     options.subtype = NBC_ALL_REDUCE;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
     int mpi_type_itr = 0, mpi_type_size = 0, mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
@@ -48,7 +49,6 @@ int main(int argc, char *argv[])
     set_header(HEADER);
     set_benchmark_name("osu_iallreduce");
     po_ret = process_options(argc, argv);
-    omb_populate_mpi_type_list(mpi_type_list);
 
     if (PO_OKAY == po_ret && NONE != options.accel) {
         if (init_accel()) {
@@ -64,6 +64,7 @@ int main(int argc, char *argv[])
     }
     MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
     MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
     MPI_Request request;
     MPI_Status status;
 
@@ -128,6 +129,7 @@ int main(int argc, char *argv[])
         MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
         omb_curr_datatype = mpi_type_list[mpi_type_itr];
         OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
         MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
                                     &mpi_type_name_length));
         OMB_MPI_RUN_AT_RANK_ZERO(
@@ -166,7 +168,8 @@ int main(int argc, char *argv[])
                         MPI_CHECK(MPI_Barrier(omb_comm));
                         MPI_CHECK(MPI_Iallreduce(
                             sendbuf_warmup, recvbuf_warmup, num_elements,
-                            omb_curr_datatype, MPI_SUM, omb_comm, &request));
+                            omb_curr_datatype, omb_curr_op, omb_comm,
+                            &request));
                         MPI_CHECK(MPI_Wait(&request, &status));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
@@ -174,8 +177,8 @@ int main(int argc, char *argv[])
 
                 t_start = MPI_Wtime();
                 MPI_CHECK(MPI_Iallreduce(sendbuf, recvbuf, num_elements,
-                                         omb_curr_datatype, MPI_SUM, omb_comm,
-                                         &request));
+                                         omb_curr_datatype, omb_curr_op,
+                                         omb_comm, &request));
                 MPI_CHECK(MPI_Wait(&request, &status));
 
                 t_stop = MPI_Wtime();
@@ -221,7 +224,8 @@ int main(int argc, char *argv[])
                         MPI_CHECK(MPI_Barrier(omb_comm));
                         MPI_CHECK(MPI_Iallreduce(
                             sendbuf_warmup, recvbuf_warmup, num_elements,
-                            omb_curr_datatype, MPI_SUM, omb_comm, &request));
+                            omb_curr_datatype, omb_curr_op, omb_comm,
+                            &request));
                         MPI_CHECK(MPI_Wait(&request, &status));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
@@ -230,8 +234,8 @@ int main(int argc, char *argv[])
                 t_start = MPI_Wtime();
                 init_time = MPI_Wtime();
                 MPI_CHECK(MPI_Iallreduce(sendbuf, recvbuf, num_elements,
-                                         omb_curr_datatype, MPI_SUM, omb_comm,
-                                         &request));
+                                         omb_curr_datatype, omb_curr_op,
+                                         omb_comm, &request));
                 init_time = MPI_Wtime() - init_time;
 
                 tcomp = MPI_Wtime();
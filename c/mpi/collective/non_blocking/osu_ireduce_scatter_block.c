@@ -31,6 +31,7 @@ int main(int argc, char *argv[])
     options.subtype = NBC_REDUCE_SCATTER;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
     int mpi_type_itr = 0, mpi_type_size = 0, mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
@@ -49,7 +50,6 @@ int main(int argc, char *argv[])
     set_header(HEADER);
     set_benchmark_name("osu_Ireduce_scatter_block");
     po_ret = process_options(argc, argv);
-    omb_populate_mpi_type_list(mpi_type_list);
 
     if (PO_OKAY == po_ret && NONE != options.accel) {
         if (init_accel()) {
@@ -65,6 +65,7 @@ int main(int argc, char *argv[])
     }
     MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
     MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
     MPI_Request request;
     MPI_Status status;
 
@@ -130,6 +131,7 @@ int main(int argc, char *argv[])
         MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
         omb_curr_datatype = mpi_type_list[mpi_type_itr];
         OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
         MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
                                     &mpi_type_name_length));
         OMB_MPI_RUN_AT_RANK_ZERO(
@@ -173,15 +175,17 @@ int main(int argc, char *argv[])
                         MPI_CHECK(MPI_Barrier(omb_comm));
                         MPI_CHECK(MPI_Ireduce_scatter_block(
                             sendbuf_warmup, recvbuf_warmup, portion,
-                            omb_curr_datatype, MPI_SUM, omb_comm, &request));
+                            omb_curr_datatype, omb_curr_op, omb_comm,
+                            &request));
                         MPI_CHECK(MPI_Wait(&request, &status));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
                 }
                 t_start = MPI_Wtime();
                 MPI_CHECK(MPI_Ireduce_scatter_block(sendbuf, recvbuf, portion,
-                                                    omb_curr_datatype, MPI_SUM,
-                                                    omb_comm, &request));
+                                                    omb_curr_datatype,
+                                                    omb_curr_op, omb_comm,
+                                                    &request));
                 MPI_CHECK(MPI_Wait(&request, &status));
                 t_stop = MPI_Wtime();
                 MPI_CHECK(MPI_Barrier(omb_comm));
@@ -220,7 +224,8 @@ int main(int argc, char *argv[])
                         MPI_CHECK(MPI_Barrier(omb_comm));
                         MPI_CHECK(MPI_Ireduce_scatter_block(
                             sendbuf_warmup, recvbuf_warmup, portion,
-                            omb_curr_datatype, MPI_SUM, omb_comm, &request));
+                            omb_curr_datatype, omb_curr_op, omb_comm,
+                            &request));
                         MPI_CHECK(MPI_Wait(&request, &status));
                     }
                     MPI_CHECK(MPI_Barrier(omb_comm));
@@ -228,8 +233,9 @@ int main(int argc, char *argv[])
                 t_start = MPI_Wtime();
                 init_time = MPI_Wtime();
                 MPI_CHECK(MPI_Ireduce_scatter_block(sendbuf, recvbuf, portion,
-                                                    omb_curr_datatype, MPI_SUM,
-                                                    omb_comm, &request));
+                                                    omb_curr_datatype,
+                                                    omb_curr_op, omb_comm,
+                                                    &request));
                 init_time = MPI_Wtime() - init_time;
                 tcomp = MPI_Wtime();
                 test_time = dummy_compute(latency_in_secs, &request);
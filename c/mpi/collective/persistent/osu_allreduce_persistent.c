@@ -28,6 +28,7 @@ int main(int argc, char *argv[])
     options.subtype = ALL_REDUCE_P;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
     int mpi_type_itr = 0, mpi_type_size = 0, mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
@@ -42,7 +43,6 @@ int main(int argc, char *argv[])
     set_header(HEADER);
     set_benchmark_name("osu_allreduce_persistent");
     po_ret = process_options(argc, argv);
-    omb_populate_mpi_type_list(mpi_type_list);
 
     if (PO_OKAY == po_ret && NONE != options.accel) {
         if (init_accel()) {
@@ -58,6 +58,7 @@ int main(int argc, char *argv[])
     }
     MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
     MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
 
     omb_graph_options_init(&omb_graph_options);
     switch (po_ret) {
@@ -120,6 +121,7 @@ int main(int argc, char *argv[])
         MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
         omb_curr_datatype = mpi_type_list[mpi_type_itr];
         OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
         MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
                                     &mpi_type_name_length));
         OMB_MPI_RUN_AT_RANK_ZERO(
@@ -141,7 +143,7 @@ int main(int argc, char *argv[])
                 &omb_graph_data, &omb_graph_options, size, options.iterations);
             MPI_CHECK(MPI_Allreduce_init(
                 sendbuf_warmup, recvbuf_warmup, num_elements, omb_curr_datatype,
-                MPI_SUM, omb_comm, MPI_INFO_NULL, &request));
+                omb_curr_op, omb_comm, MPI_INFO_NULL, &request));
             MPI_CHECK(MPI_Barrier(omb_comm));
             timer = 0.0;
 
@@ -27,6 +27,7 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_SIGNED_CHAR;
+    MPI_Op omb_curr_op = MPI_SUM;
     int mpi_type_itr = 0, mpi_type_size = 0, mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     MPI_Datatype mpi_type_list[OMB_NUM_DATATYPES];
@@ -45,7 +46,6 @@ int main(int argc, char *argv[])
     options.subtype = REDUCE_SCATTER_P;
 
     po_ret = process_options(argc, argv);
-    omb_populate_mpi_type_list(mpi_type_list);
 
     if (PO_OKAY == po_ret && NONE != options.accel) {
         if (init_accel()) {
@@ -61,6 +61,7 @@ int main(int argc, char *argv[])
     }
     MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
     MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    omb_populate_mpi_type_list(mpi_type_list);
 
     omb_graph_options_init(&omb_graph_options);
     switch (po_ret) {
@@ -136,6 +137,7 @@ int main(int argc, char *argv[])
         MPI_CHECK(MPI_Type_size(mpi_type_list[mpi_type_itr], &mpi_type_size));
         omb_curr_datatype = mpi_type_list[mpi_type_itr];
         OMB_MPI_REDUCE_CHAR_CHECK(omb_curr_datatype);
+        omb_curr_op = omb_get_reduce_op(omb_curr_datatype);
         MPI_CHECK(MPI_Type_get_name(omb_curr_datatype, mpi_type_name_str,
                                     &mpi_type_name_length));
         OMB_MPI_RUN_AT_RANK_ZERO(
@@ -175,7 +177,7 @@ int main(int argc, char *argv[])
                 sendbuf = MPI_IN_PLACE;
             }
             MPI_CHECK(MPI_Reduce_scatter_init(
-                sendbuf, recvbuf, recvcounts, omb_curr_datatype, MPI_SUM,
+                sendbuf, recvbuf, recvcounts, omb_curr_datatype, omb_curr_op,
                 omb_comm, MPI_INFO_NULL, &request));
             MPI_CHECK(MPI_Barrier(omb_comm));
 
@@ -0,0 +1,246 @@
+#define BENCHMARK "OSU MPI%s Shared Memory Window Bandwidth Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#include <osu_util_mpi.h>
+
+/*
+ * Segment layout and flag handoff follow osu_shm_win_latency: one flag cache
+ * line in front of the data of every segment, polled only by its owner.
+ * Rank 0 moves window_size messages per iteration and rank 1 acknowledges
+ * every iteration.
+ */
+#define SHM_FLAG_BYTES 64
+
+enum shm_methods_t {
+    SHM_LOAD_STORE,
+    SHM_PUT,
+    SHM_GET,
+    SHM_SEND_RECV,
+    SHM_NUM_METHODS
+};
+
+static const char *shm_method_names[SHM_NUM_METHODS] = {
+    "Load/store(MB/s)", "MPI_Put(MB/s)", "MPI_Get(MB/s)", "Isend/Irecv(MB/s)"};
+
+MPI_Win win;
+MPI_Comm omb_comm = MPI_COMM_NULL;
+MPI_Request *requests = NULL;
+char *local_base = NULL, *peer_base = NULL, *buf = NULL;
+int peer = 0, seq = 0;
+
+static void wait_flag(void)
+{
+    volatile int *flag = (volatile int *)local_base;
+
+    while (*flag != seq) {
+        MPI_CHECK(MPI_Win_sync(win));
+    }
+    MPI_CHECK(MPI_Win_sync(win));
+}
+
+static void post_flag_store(void)
+{
+    MPI_CHECK(MPI_Win_sync(win));
+    *(volatile int *)peer_base = seq;
+    MPI_CHECK(MPI_Win_sync(win));
+}
+
+static void post_flag_put(void)
+{
+    MPI_CHECK(MPI_Put(&seq, 1, MPI_INT, peer, 0, 1, MPI_INT, win));
+    MPI_CHECK(MPI_Win_flush(peer, win));
+}
+
+static double run_method(int rank, int method, size_t size)
+{
+    int i = 0, j = 0, window_size = options.window_size;
+    double t_start = 0.0, t_end = 0.0;
+    char ack = 0;
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (i == options.skip) {
+            t_start = MPI_Wtime();
+        }
+        seq++;
+        switch (method) {
+            case SHM_LOAD_STORE:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        memcpy(peer_base + SHM_FLAG_BYTES + j * size,
+                               buf + j * size, size);
+                    }
+                    post_flag_store();
+                    wait_flag();
+                } else {
+                    wait_flag();
+                    post_flag_store();
+                }
+                break;
+            case SHM_PUT:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        MPI_CHECK(MPI_Put(buf + j * size, size, MPI_CHAR,
+                                          peer, SHM_FLAG_BYTES + j * size,
+                                          size, MPI_CHAR, win));
+                    }
+                    MPI_CHECK(MPI_Win_flush(peer, win));
+                    post_flag_put();
+                    wait_flag();
+                } else {
+                    wait_flag();
+                    post_flag_put();
+                }
+                break;
+            case SHM_GET:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        MPI_CHECK(MPI_Get(buf + j * size, size, MPI_CHAR,
+                                          peer, SHM_FLAG_BYTES + j * size,
+                                          size, MPI_CHAR, win));
+                    }
+                    MPI_CHECK(MPI_Win_flush(peer, win));
+                }
+                break;
+            case SHM_SEND_RECV:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        MPI_CHECK(MPI_Isend(buf + j * size, size, MPI_CHAR,
+                                            peer, 100, omb_comm,
+                                            requests + j));
+                    }
+                    MPI_CHECK(MPI_Waitall(window_size, requests,
+                                          MPI_STATUSES_IGNORE));
+                    MPI_CHECK(MPI_Recv(&ack, 1, MPI_CHAR, peer, 101, omb_comm,
+                                       MPI_STATUS_IGNORE));
+                } else {
+                    for (j = 0; j < window_size; j++) {
+                        MPI_CHECK(MPI_Irecv(buf + j * size, size, MPI_CHAR,
+                                            peer, 100, omb_comm,
+                                            requests + j));
+                    }
+                    MPI_CHECK(MPI_Waitall(window_size, requests,
+                                          MPI_STATUSES_IGNORE));
+                    MPI_CHECK(
+                        MPI_Send(&ack, 1, MPI_CHAR, peer, 101, omb_comm));
+                }
+                break;
+        }
+    }
+    t_end = MPI_Wtime();
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    return size / 1e6 * options.iterations * window_size / (t_end - t_start);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, nprocs = 0, method = 0, disp_unit = 0;
+    int po_ret = PO_OKAY;
+    size_t size = 0, seg_size = 0, buf_size = 0;
+    MPI_Aint peer_size = 0;
+    double bandwidth[SHM_NUM_METHODS];
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = ONE_SIDED;
+    options.subtype = SHM_WIN_BW;
+    set_header(HEADER);
+    set_benchmark_name("osu_shm_win_bw");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &nprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != nprocs || !omb_comm_is_node_local(omb_comm)) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes on the"
+                            " same node\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    peer = 1 - rank;
+
+    buf_size = MAX(options.max_message_size * options.window_size, 1);
+    seg_size = SHM_FLAG_BYTES + buf_size;
+    MPI_CHECK(MPI_Win_allocate_shared(seg_size, 1, MPI_INFO_NULL, omb_comm,
+                                      &local_base, &win));
+    MPI_CHECK(MPI_Win_shared_query(win, peer, &peer_size, &disp_unit,
+                                   &peer_base));
+    /* first touch places the segment on the owner's NUMA node */
+    memset(local_base, 0, seg_size);
+    /* rank 0 sends and gets through buf, rank 1 receives into it */
+    CHECK(posix_memalign((void **)&buf, getpagesize(), buf_size));
+    memset(buf, 'a', buf_size);
+    requests = malloc(options.window_size * sizeof(MPI_Request));
+    OMB_CHECK_NULL_AND_EXIT(requests, "Unable to allocate memory");
+    MPI_CHECK(MPI_Barrier(omb_comm));
+
+    print_preamble(rank);
+    omb_print_placement(omb_comm, local_base);
+    if (0 == rank) {
+        fprintf(stdout, "# Window size: %d\n", options.window_size);
+        fprintf(stdout, "%-*s", 10, "# Size");
+        for (method = 0; method < SHM_NUM_METHODS; method++) {
+            fprintf(stdout, "%*s", FIELD_WIDTH, shm_method_names[method]);
+        }
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+
+    MPI_CHECK(MPI_Win_lock_all(MPI_MODE_NOCHECK, win));
+    for (size = MAX(options.min_message_size, 1);
+         size <= options.max_message_size; size *= 2) {
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        for (method = 0; method < SHM_NUM_METHODS; method++) {
+            bandwidth[method] = run_method(rank, method, size);
+        }
+        if (0 == rank) {
+            fprintf(stdout, "%-*zu", 10, size);
+            for (method = 0; method < SHM_NUM_METHODS; method++) {
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        bandwidth[method]);
+            }
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+    MPI_CHECK(MPI_Win_unlock_all(win));
+
+    MPI_CHECK(MPI_Win_free(&win));
+    free(requests);
+    free(buf);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,233 @@
+#define BENCHMARK "OSU MPI%s Shared Memory Window Latency Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#include <osu_util_mpi.h>
+
+/*
+ * Each process owns one segment of an MPI_Win_allocate_shared window. The
+ * first cache line of a segment holds the handoff flag, the message data
+ * follows it. A flag is only ever written by the peer and polled by its
+ * owner; both processes advance the same sequence number so that flags never
+ * need to be reset.
+ */
+#define SHM_FLAG_BYTES 64
+
+enum shm_methods_t {
+    SHM_LOAD_STORE,
+    SHM_PUT,
+    SHM_GET,
+    SHM_SEND_RECV,
+    SHM_NUM_METHODS
+};
+
+static const char *shm_method_names[SHM_NUM_METHODS] = {
+    "Load/store(us)", "MPI_Put(us)", "MPI_Get(us)", "Send/Recv(us)"};
+
+MPI_Win win;
+MPI_Comm omb_comm = MPI_COMM_NULL;
+char *local_base = NULL, *peer_base = NULL, *sbuf = NULL, *rbuf = NULL;
+int peer = 0, seq = 0;
+
+static void wait_flag(void)
+{
+    volatile int *flag = (volatile int *)local_base;
+
+    while (*flag != seq) {
+        MPI_CHECK(MPI_Win_sync(win));
+    }
+    MPI_CHECK(MPI_Win_sync(win));
+}
+
+static void post_flag_store(void)
+{
+    MPI_CHECK(MPI_Win_sync(win));
+    *(volatile int *)peer_base = seq;
+    MPI_CHECK(MPI_Win_sync(win));
+}
+
+static void post_flag_put(void)
+{
+    MPI_CHECK(MPI_Put(&seq, 1, MPI_INT, peer, 0, 1, MPI_INT, win));
+    MPI_CHECK(MPI_Win_flush(peer, win));
+}
+
+/* Returns the one-way latency in us, or the Get round trip for SHM_GET. */
+static double run_method(int rank, int method, size_t size)
+{
+    int i = 0;
+    double t_start = 0.0, t_end = 0.0;
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (i == options.skip) {
+            t_start = MPI_Wtime();
+        }
+        seq++;
+        switch (method) {
+            case SHM_LOAD_STORE:
+                if (0 == rank) {
+                    memcpy(peer_base + SHM_FLAG_BYTES, sbuf, size);
+                    post_flag_store();
+                    wait_flag();
+                } else {
+                    wait_flag();
+                    memcpy(peer_base + SHM_FLAG_BYTES, sbuf, size);
+                    post_flag_store();
+                }
+                break;
+            case SHM_PUT:
+                if (0 == rank) {
+                    MPI_CHECK(MPI_Put(sbuf, size, MPI_CHAR, peer,
+                                      SHM_FLAG_BYTES, size, MPI_CHAR, win));
+                    MPI_CHECK(MPI_Win_flush(peer, win));
+                    post_flag_put();
+                    wait_flag();
+                } else {
+                    wait_flag();
+                    MPI_CHECK(MPI_Put(sbuf, size, MPI_CHAR, peer,
+                                      SHM_FLAG_BYTES, size, MPI_CHAR, win));
+                    MPI_CHECK(MPI_Win_flush(peer, win));
+                    post_flag_put();
+                }
+                break;
+            case SHM_GET:
+                if (0 == rank) {
+                    MPI_CHECK(MPI_Get(rbuf, size, MPI_CHAR, peer,
+                                      SHM_FLAG_BYTES, size, MPI_CHAR, win));
+                    MPI_CHECK(MPI_Win_flush(peer, win));
+                }
+                break;
+            case SHM_SEND_RECV:
+                if (0 == rank) {
+                    MPI_CHECK(
+                        MPI_Send(sbuf, size, MPI_CHAR, peer, 1, omb_comm));
+                    MPI_CHECK(MPI_Recv(rbuf, size, MPI_CHAR, peer, 1, omb_comm,
+                                       MPI_STATUS_IGNORE));
+                } else {
+                    MPI_CHECK(MPI_Recv(rbuf, size, MPI_CHAR, peer, 1, omb_comm,
+                                       MPI_STATUS_IGNORE));
+                    MPI_CHECK(
+                        MPI_Send(sbuf, size, MPI_CHAR, peer, 1, omb_comm));
+                }
+                break;
+        }
+    }
+    t_end = MPI_Wtime();
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    if (SHM_GET == method) {
+        return (t_end - t_start) * 1e6 / options.iterations;
+    }
+    return (t_end - t_start) * 1e6 / (2.0 * options.iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, nprocs = 0, method = 0, disp_unit = 0;
+    int po_ret = PO_OKAY;
+    size_t size = 0, seg_size = 0;
+    MPI_Aint peer_size = 0;
+    double latency[SHM_NUM_METHODS];
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = ONE_SIDED;
+    options.subtype = SHM_WIN_LAT;
+    set_header(HEADER);
+    set_benchmark_name("osu_shm_win_latency");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &nprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != nprocs || !omb_comm_is_node_local(omb_comm)) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes on the"
+                            " same node\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    peer = 1 - rank;
+
+    seg_size = SHM_FLAG_BYTES + options.max_message_size;
+    MPI_CHECK(MPI_Win_allocate_shared(seg_size, 1, MPI_INFO_NULL, omb_comm,
+                                      &local_base, &win));
+    MPI_CHECK(MPI_Win_shared_query(win, peer, &peer_size, &disp_unit,
+                                   &peer_base));
+    /* first touch places the segment on the owner's NUMA node */
+    memset(local_base, 0, seg_size);
+    CHECK(posix_memalign((void **)&sbuf, getpagesize(),
+                         MAX(options.max_message_size, 1)));
+    CHECK(posix_memalign((void **)&rbuf, getpagesize(),
+                         MAX(options.max_message_size, 1)));
+    memset(sbuf, 'a', options.max_message_size);
+    memset(rbuf, 'b', options.max_message_size);
+    MPI_CHECK(MPI_Barrier(omb_comm));
+
+    print_preamble(rank);
+    omb_print_placement(omb_comm, local_base);
+    if (0 == rank) {
+        fprintf(stdout, "%-*s", 10, "# Size");
+        for (method = 0; method < SHM_NUM_METHODS; method++) {
+            fprintf(stdout, "%*s", FIELD_WIDTH, shm_method_names[method]);
+        }
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+
+    MPI_CHECK(MPI_Win_lock_all(MPI_MODE_NOCHECK, win));
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size = (size ? size * 2 : 1)) {
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        for (method = 0; method < SHM_NUM_METHODS; method++) {
+            latency[method] = run_method(rank, method, size);
+        }
+        if (0 == rank) {
+            fprintf(stdout, "%-*zu", 10, size);
+            for (method = 0; method < SHM_NUM_METHODS; method++) {
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        latency[method]);
+            }
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+    MPI_CHECK(MPI_Win_unlock_all(win));
+
+    MPI_CHECK(MPI_Win_free(&win));
+    free(sbuf);
+    free(rbuf);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,420 @@
+#define BENCHMARK "OSU MPI%s Bisection Bandwidth Test"
+/*
+ * Copyright (C) 2002-2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#include <osu_util_mpi.h>
+
+#define BISECTION_TAG 103
+
+static int compare_name(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* Same generator as the traffic patterns, independent of the C library. */
+static unsigned int bisection_rand(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned int)(*state >> 33);
+}
+
+/*
+ * Node of every rank from the processor names, nodes numbered in the order
+ * of their sorted names. The names of the nodes are only set at rank 0.
+ */
+static int *bisection_node_ids(MPI_Comm comm, int n, int *num_nodes,
+                               char ***node_names)
+{
+    int rank = 0, r = 0, len = 0, node = 0;
+    int *node_ids = NULL;
+    char *proc_name = NULL, *all_names = NULL;
+    char **sorted = NULL;
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    proc_name = calloc(MPI_MAX_PROCESSOR_NAME, sizeof(char));
+    node_ids = malloc(sizeof(int) * n);
+    OMB_CHECK_NULL_AND_EXIT(proc_name, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(node_ids, "Unable to allocate memory");
+    MPI_CHECK(MPI_Get_processor_name(proc_name, &len));
+    if (0 == rank) {
+        all_names = malloc(sizeof(char) * MPI_MAX_PROCESSOR_NAME * n);
+        sorted = malloc(sizeof(char *) * n);
+        *node_names = malloc(sizeof(char *) * n);
+        OMB_CHECK_NULL_AND_EXIT(all_names, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(sorted, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(*node_names, "Unable to allocate memory");
+    }
+    MPI_CHECK(MPI_Gather(proc_name, MPI_MAX_PROCESSOR_NAME, MPI_CHAR,
+                         all_names, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, comm));
+    if (0 == rank) {
+        for (r = 0; r < n; r++) {
+            sorted[r] = all_names + MPI_MAX_PROCESSOR_NAME * r;
+        }
+        qsort(sorted, n, sizeof(char *), compare_name);
+        *num_nodes = 0;
+        for (r = 0; r < n; r++) {
+            if (0 == r || strcmp(sorted[r], sorted[r - 1])) {
+                (*node_names)[(*num_nodes)++] = strdup(sorted[r]);
+            }
+        }
+        for (r = 0; r < n; r++) {
+            for (node = 0; node < *num_nodes; node++) {
+                if (!strcmp(all_names + MPI_MAX_PROCESSOR_NAME * r,
+                            (*node_names)[node])) {
+                    node_ids[r] = node;
+                    break;
+                }
+            }
+        }
+        free(sorted);
+        free(all_names);
+    }
+    MPI_CHECK(MPI_Bcast(num_nodes, 1, MPI_INT, 0, comm));
+    MPI_CHECK(MPI_Bcast(node_ids, n, MPI_INT, 0, comm));
+    free(proc_name);
+    return node_ids;
+}
+
+/*
+ * Marks the nodes listed in the host file as the first half. Returns -1 if
+ * the file cannot be opened.
+ */
+static int bisection_read_file(int num_nodes, char **node_names, int *in_a)
+{
+    FILE *fp = NULL;
+    int node = 0;
+    char line[MPI_MAX_PROCESSOR_NAME + 2];
+    char *host = NULL;
+
+    fp = fopen(options.bisection_file, "r");
+    if (NULL == fp) {
+        fprintf(stderr, "Unable to open host file %s\n",
+                options.bisection_file);
+        return -1;
+    }
+    while (NULL != fgets(line, sizeof(line), fp)) {
+        host = strtok(line, " \t\r\n");
+        if (NULL == host || '#' == host[0]) {
+            continue;
+        }
+        for (node = 0; node < num_nodes; node++) {
+            if (!strcmp(host, node_names[node])) {
+                in_a[node] = 1;
+            }
+        }
+    }
+    fclose(fp);
+    return 0;
+}
+
+/*
+ * Partner of every rank for every split, -1 for ranks left without one when
+ * the halves run different numbers of processes. The i-th rank of the first
+ * half is paired with the i-th rank of the second, ranks taken node by node.
+ * Returns NULL if the host file does not describe a valid split.
+ */
+static int *bisection_partners(int n, int num_nodes, int *node_ids,
+                               char **node_names, int *active_nodes)
+{
+    int split = 0, i = 0, j = 0, r = 0, tmp = 0, num_a = 0, num_b = 0;
+    int num_in_a = 0;
+    int *partners = NULL, *order = NULL, *in_a = NULL, *ranks_a = NULL;
+    int *ranks_b = NULL, *active = NULL;
+    uint64_t state = options.bisection_seed;
+
+    partners = malloc(sizeof(int) * n * options.num_splits);
+    order = malloc(sizeof(int) * num_nodes);
+    in_a = malloc(sizeof(int) * num_nodes);
+    active = malloc(sizeof(int) * num_nodes);
+    ranks_a = malloc(sizeof(int) * n);
+    ranks_b = malloc(sizeof(int) * n);
+    OMB_CHECK_NULL_AND_EXIT(partners, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(order, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(in_a, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(active, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(ranks_a, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(ranks_b, "Unable to allocate memory");
+    for (split = 0; split < options.num_splits; split++) {
+        for (i = 0; i < num_nodes; i++) {
+            order[i] = i;
+            in_a[i] = 0;
+            active[i] = 0;
+        }
+        switch (options.bisection_split) {
+            case OMB_BISECTION_RANDOM:
+                for (i = num_nodes - 1; i > 0; i--) {
+                    j = bisection_rand(&state) % (i + 1);
+                    tmp = order[i];
+                    order[i] = order[j];
+                    order[j] = tmp;
+                }
+                /* fall through */
+            case OMB_BISECTION_NAME:
+                for (i = 0; i < num_nodes / 2; i++) {
+                    in_a[order[i]] = 1;
+                }
+                break;
+            case OMB_BISECTION_FILE:
+                if (bisection_read_file(num_nodes, node_names, in_a)) {
+                    free(partners);
+                    partners = NULL;
+                    goto exit_path;
+                }
+                break;
+        }
+        num_in_a = 0;
+        for (i = 0; i < num_nodes; i++) {
+            num_in_a += in_a[i];
+        }
+        if (0 == num_in_a || num_nodes == num_in_a) {
+            fprintf(stderr, "The host file must list some but not all"
+                            " nodes\n");
+            free(partners);
+            partners = NULL;
+            goto exit_path;
+        }
+        num_a = 0;
+        num_b = 0;
+        for (i = 0; i < num_nodes; i++) {
+            for (r = 0; r < n; r++) {
+                if (node_ids[r] != order[i]) {
+                    continue;
+                }
+                if (in_a[order[i]]) {
+                    ranks_a[num_a++] = r;
+                } else {
+                    ranks_b[num_b++] = r;
+                }
+            }
+        }
+        for (r = 0; r < n; r++) {
+            partners[split * n + r] = -1;
+        }
+        active_nodes[split] = 0;
+        for (i = 0; i < MIN(num_a, num_b); i++) {
+            partners[split * n + ranks_a[i]] = ranks_b[i];
+            partners[split * n + ranks_b[i]] = ranks_a[i];
+            active[node_ids[ranks_a[i]]] = 1;
+            active[node_ids[ranks_b[i]]] = 1;
+        }
+        for (i = 0; i < num_nodes; i++) {
+            active_nodes[split] += active[i];
+        }
+    }
+exit_path:
+    free(order);
+    free(in_a);
+    free(active);
+    free(ranks_a);
+    free(ranks_b);
+    return partners;
+}
+
+/*
+ * Seconds for the iterations of one split. Every rank with a partner keeps a
+ * window of messages in flight in each direction.
+ */
+static double run_split(int partner, char *s_buf, char *r_buf, int size,
+                        int window_size, int skip, int iterations,
+                        MPI_Request *req, MPI_Comm comm)
+{
+    int i = 0, j = 0;
+    double t_start = 0.0;
+
+    for (i = 0; i < skip + iterations; i++) {
+        if (i == skip) {
+            MPI_CHECK(MPI_Barrier(comm));
+            t_start = MPI_Wtime();
+        }
+        if (-1 == partner) {
+            continue;
+        }
+        for (j = 0; j < window_size; j++) {
+            MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, partner, BISECTION_TAG,
+                                comm, &req[j]));
+        }
+        for (j = 0; j < window_size; j++) {
+            MPI_CHECK(MPI_Isend(s_buf, size, MPI_CHAR, partner, BISECTION_TAG,
+                                comm, &req[window_size + j]));
+        }
+        MPI_CHECK(MPI_Waitall(2 * window_size, req, MPI_STATUSES_IGNORE));
+    }
+    return MPI_Wtime() - t_start;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = PO_OKAY, i = 0, size = 0;
+    int window_size = 0, iterations = 0, skip = 0, split = 0, num_nodes = 0;
+    int num_pairs = 0, split_error = 0;
+    int *node_ids = NULL, *partners = NULL, *active_nodes = NULL;
+    char *s_buf = NULL, *r_buf = NULL;
+    char **node_names = NULL;
+    double t_rank = 0.0, t_max = 0.0, bw = 0.0;
+    double bw_min = 0.0, bw_max = 0.0, bw_sum = 0.0, node_bw_sum = 0.0;
+    MPI_Request *req = NULL;
+    MPI_Comm omb_comm = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = CONG_BISECTION;
+    set_header(HEADER);
+    set_benchmark_name("osu_bisection");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+
+    node_ids = bisection_node_ids(omb_comm, numprocs, &num_nodes, &node_names);
+    if (num_nodes < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "Please run this benchmark on more than 1 node\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    active_nodes = malloc(sizeof(int) * options.num_splits);
+    OMB_CHECK_NULL_AND_EXIT(active_nodes, "Unable to allocate memory");
+    if (0 == rank) {
+        partners = bisection_partners(numprocs, num_nodes, node_ids,
+                                      node_names, active_nodes);
+        split_error = NULL == partners;
+    }
+    MPI_CHECK(MPI_Bcast(&split_error, 1, MPI_INT, 0, omb_comm));
+    if (split_error) {
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    if (0 != rank) {
+        partners = malloc(sizeof(int) * numprocs * options.num_splits);
+        OMB_CHECK_NULL_AND_EXIT(partners, "Unable to allocate memory");
+    }
+    MPI_CHECK(MPI_Bcast(partners, numprocs * options.num_splits, MPI_INT, 0,
+                        omb_comm));
+    MPI_CHECK(MPI_Bcast(active_nodes, options.num_splits, MPI_INT, 0,
+                        omb_comm));
+
+    window_size = options.window_size;
+    s_buf = malloc(options.max_message_size);
+    r_buf = malloc(options.max_message_size);
+    req = malloc(sizeof(MPI_Request) * 2 * window_size);
+    OMB_CHECK_NULL_AND_EXIT(s_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(r_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(req, "Unable to allocate memory");
+    memset(s_buf, 'a', options.max_message_size);
+    memset(r_buf, 'b', options.max_message_size);
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Nodes: %d, processes: %d\n", num_nodes, numprocs);
+        switch (options.bisection_split) {
+            case OMB_BISECTION_RANDOM:
+                fprintf(stdout, "# Split: %d random split(s), seed %u\n",
+                        options.num_splits, options.bisection_seed);
+                break;
+            case OMB_BISECTION_NAME:
+                fprintf(stdout, "# Split: by sorted host name\n");
+                break;
+            case OMB_BISECTION_FILE:
+                fprintf(stdout, "# Split: %s\n", options.bisection_file);
+                break;
+        }
+        fprintf(stdout, "# Window size: %d\n", window_size);
+        fprintf(stdout, "# Aggregate bandwidth over the splits, both"
+                        " directions counted\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Min (MB/s)", FIELD_WIDTH, "Avg (MB/s)", FIELD_WIDTH,
+                "Max (MB/s)", FIELD_WIDTH, "Per Node (MB/s)");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size *= 2) {
+        iterations = options.iterations;
+        skip = options.skip;
+        if (size > LARGE_MESSAGE_SIZE) {
+            iterations = options.iterations_large;
+            skip = options.skip_large;
+        }
+        bw_sum = 0.0;
+        node_bw_sum = 0.0;
+        for (split = 0; split < options.num_splits; split++) {
+            t_rank = run_split(partners[split * numprocs + rank], s_buf, r_buf,
+                               size, window_size, skip, iterations, req,
+                               omb_comm);
+            MPI_CHECK(MPI_Reduce(&t_rank, &t_max, 1, MPI_DOUBLE, MPI_MAX, 0,
+                                 omb_comm));
+            if (0 != rank) {
+                continue;
+            }
+            num_pairs = 0;
+            for (i = 0; i < numprocs; i++) {
+                num_pairs += -1 != partners[split * numprocs + i];
+            }
+            num_pairs /= 2;
+            bw = 2.0 * num_pairs * size / 1e6 * window_size * iterations /
+                 t_max;
+            if (0 == split || bw < bw_min) {
+                bw_min = bw;
+            }
+            if (0 == split || bw > bw_max) {
+                bw_max = bw;
+            }
+            bw_sum += bw;
+            node_bw_sum += bw / active_nodes[split];
+        }
+        if (0 == rank) {
+            fprintf(stdout, "%-*d", 10, size);
+            fprintf(stdout, "%*.*f%*.*f%*.*f%*.*f\n", FIELD_WIDTH,
+                    FLOAT_PRECISION, bw_min, FIELD_WIDTH, FLOAT_PRECISION,
+                    bw_sum / options.num_splits, FIELD_WIDTH, FLOAT_PRECISION,
+                    bw_max, FIELD_WIDTH, FLOAT_PRECISION,
+                    node_bw_sum / options.num_splits);
+            fflush(stdout);
+        }
+    }
+
+    if (0 == rank) {
+        for (i = 0; i < num_nodes; i++) {
+            free(node_names[i]);
+        }
+        free(node_names);
+    }
+    free(s_buf);
+    free(r_buf);
+    free(req);
+    free(node_ids);
+    free(partners);
+    free(active_nodes);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,261 @@
+#define BENCHMARK "OSU MPI%s Traffic Pattern Bandwidth Test"
+/*
+ * Copyright (C) 2002-2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#include <osu_util_mpi.h>
+#include "osu_traffic_pattern.h"
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * One iteration: every flow sends a window of messages. The time of a flow
+ * runs from the common start until its last message arrives, the time of
+ * the rank until all of its flows are done.
+ */
+static double run_pattern(traffic_info_t *traffic_info, char *s_buf,
+                          char *r_buf, int size, int window_size,
+                          MPI_Request *send_req, MPI_Request *recv_req,
+                          int *remaining, int *indices, double *flow_time,
+                          MPI_Comm comm)
+{
+    int i = 0, j = 0, done = 0, flow = 0;
+    int num_recvs = traffic_info->num_srcs * window_size;
+    double t_start = 0.0;
+
+    for (i = 0; i < traffic_info->num_srcs; i++) {
+        remaining[i] = window_size;
+        for (j = 0; j < window_size; j++) {
+            MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, traffic_info->srcs[i],
+                                TRAFFIC_PATTERN_TAG, comm,
+                                &recv_req[i * window_size + j]));
+        }
+    }
+    MPI_CHECK(MPI_Barrier(comm));
+    t_start = MPI_Wtime();
+    for (j = 0; j < window_size; j++) {
+        for (i = 0; i < traffic_info->num_dsts; i++) {
+            MPI_CHECK(MPI_Isend(s_buf, size, MPI_CHAR, traffic_info->dsts[i],
+                                TRAFFIC_PATTERN_TAG, comm,
+                                &send_req[j * traffic_info->num_dsts + i]));
+        }
+    }
+    while (num_recvs) {
+        MPI_CHECK(MPI_Waitsome(traffic_info->num_srcs * window_size, recv_req,
+                               &done, indices, MPI_STATUSES_IGNORE));
+        for (i = 0; i < done; i++) {
+            flow = indices[i] / window_size;
+            if (0 == --remaining[flow]) {
+                flow_time[flow] += MPI_Wtime() - t_start;
+            }
+        }
+        num_recvs -= done;
+    }
+    MPI_CHECK(MPI_Waitall(traffic_info->num_dsts * window_size, send_req,
+                          MPI_STATUSES_IGNORE));
+    return MPI_Wtime() - t_start;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = PO_OKAY, i = 0, size = 0;
+    int window_size = 0, iterations = 0, skip = 0;
+    int *remaining = NULL, *indices = NULL, *counts = NULL, *displs = NULL;
+    char *s_buf = NULL, *r_buf = NULL;
+    double t_rank = 0.0, t_max = 0.0;
+    double *flow_time = NULL, *flow_bw = NULL, *all_bw = NULL;
+    MPI_Request *send_req = NULL, *recv_req = NULL;
+    MPI_Comm omb_comm = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+    traffic_info_t traffic_info;
+
+    options.bench = PT2PT;
+    options.subtype = CONG_PATTERN;
+    set_header(HEADER);
+    set_benchmark_name("osu_bw_pattern");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    traffic_info = omb_traffic_init(omb_comm);
+    if (0 == traffic_info.total_flows) {
+        if (0 == rank) {
+            fprintf(stderr, "The %s pattern has no flows on %d processes\n",
+                    omb_traffic_name(), numprocs);
+        }
+        omb_traffic_free(traffic_info);
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    window_size = options.window_size;
+    s_buf = malloc(options.max_message_size);
+    r_buf = malloc(options.max_message_size);
+    send_req = malloc(sizeof(MPI_Request) *
+                      MAX(traffic_info.num_dsts * window_size, 1));
+    recv_req = malloc(sizeof(MPI_Request) *
+                      MAX(traffic_info.num_srcs * window_size, 1));
+    indices = malloc(sizeof(int) * MAX(traffic_info.num_srcs * window_size, 1));
+    remaining = malloc(sizeof(int) * MAX(traffic_info.num_srcs, 1));
+    flow_time = malloc(sizeof(double) * MAX(traffic_info.num_srcs, 1));
+    flow_bw = malloc(sizeof(double) * MAX(traffic_info.num_srcs, 1));
+    OMB_CHECK_NULL_AND_EXIT(s_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(r_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(send_req, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(recv_req, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(indices, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(remaining, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(flow_time, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(flow_bw, "Unable to allocate memory");
+    memset(s_buf, 'a', options.max_message_size);
+    memset(r_buf, 'b', options.max_message_size);
+
+    /* rank 0 collects the bandwidth of every flow at its receiver */
+    if (0 == rank) {
+        counts = malloc(sizeof(int) * numprocs);
+        displs = malloc(sizeof(int) * numprocs);
+        all_bw = malloc(sizeof(double) * traffic_info.total_flows);
+        OMB_CHECK_NULL_AND_EXIT(counts, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(displs, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(all_bw, "Unable to allocate memory");
+    }
+    MPI_CHECK(MPI_Gather(&traffic_info.num_srcs, 1, MPI_INT, counts, 1,
+                         MPI_INT, 0, omb_comm));
+    if (0 == rank) {
+        displs[0] = 0;
+        for (i = 1; i < numprocs; i++) {
+            displs[i] = displs[i - 1] + counts[i - 1];
+        }
+    }
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Pattern: %s", omb_traffic_name());
+        if (OMB_TRAFFIC_RANDOM == options.traffic_pattern ||
+            OMB_TRAFFIC_SHUFFLE == options.traffic_pattern) {
+            fprintf(stdout, " (seed %u)", options.traffic_seed);
+        }
+        if (traffic_info.active_ranks < numprocs) {
+            fprintf(stdout, " on the first %d ranks", traffic_info.active_ranks);
+        }
+        fprintf(stdout, "\n# Flows: %d, %d inter-node\n",
+                traffic_info.total_flows, traffic_info.inter_node_flows);
+        fprintf(stdout, "# Processes: %d on %d node(s), ", numprocs,
+                traffic_info.num_nodes);
+        if (traffic_info.min_ppn == traffic_info.max_ppn) {
+            fprintf(stdout, "%d per node\n", traffic_info.max_ppn);
+        } else {
+            fprintf(stdout, "%d to %d per node\n", traffic_info.min_ppn,
+                    traffic_info.max_ppn);
+        }
+        fprintf(stdout, "# Window size: %d\n", window_size);
+        fprintf(stdout, "%-*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Min (MB/s)", FIELD_WIDTH, "Median (MB/s)", FIELD_WIDTH,
+                "Max (MB/s)", FIELD_WIDTH, "Aggregate (MB/s)");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size *= 2) {
+        iterations = options.iterations;
+        skip = options.skip;
+        if (size > LARGE_MESSAGE_SIZE) {
+            iterations = options.iterations_large;
+            skip = options.skip_large;
+        }
+        for (i = 0; i < traffic_info.num_srcs; i++) {
+            flow_time[i] = 0.0;
+        }
+        t_rank = 0.0;
+        for (i = 0; i < skip; i++) {
+            run_pattern(&traffic_info, s_buf, r_buf, size, window_size,
+                        send_req, recv_req, remaining, indices, flow_time,
+                        omb_comm);
+        }
+        for (i = 0; i < traffic_info.num_srcs; i++) {
+            flow_time[i] = 0.0;
+        }
+        for (i = 0; i < iterations; i++) {
+            t_rank += run_pattern(&traffic_info, s_buf, r_buf, size,
+                                  window_size, send_req, recv_req, remaining,
+                                  indices, flow_time, omb_comm);
+        }
+        for (i = 0; i < traffic_info.num_srcs; i++) {
+            flow_bw[i] = size / 1e6 * window_size * iterations / flow_time[i];
+        }
+        MPI_CHECK(MPI_Gatherv(flow_bw, traffic_info.num_srcs, MPI_DOUBLE,
+                              all_bw, counts, displs, MPI_DOUBLE, 0,
+                              omb_comm));
+        MPI_CHECK(MPI_Reduce(&t_rank, &t_max, 1, MPI_DOUBLE, MPI_MAX, 0,
+                             omb_comm));
+        if (0 == rank) {
+            qsort(all_bw, traffic_info.total_flows, sizeof(double),
+                  compare_double);
+            fprintf(stdout, "%-*d", 10, size);
+            fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION, all_bw[0]);
+            fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                    all_bw[traffic_info.total_flows / 2]);
+            fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                    all_bw[traffic_info.total_flows - 1]);
+            fprintf(stdout, "%*.*f\n", FIELD_WIDTH, FLOAT_PRECISION,
+                    size / 1e6 * window_size * iterations *
+                        traffic_info.total_flows / t_max);
+            fflush(stdout);
+        }
+    }
+
+    free(s_buf);
+    free(r_buf);
+    free(send_req);
+    free(recv_req);
+    free(indices);
+    free(remaining);
+    free(flow_time);
+    free(flow_bw);
+    free(counts);
+    free(displs);
+    free(all_bw);
+    omb_traffic_free(traffic_info);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,353 @@
+#define BENCHMARK "OSU MPI%s Congestion Impact Test"
+/*
+ * Copyright (C) 2002-2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#include <osu_util_mpi.h>
+
+#define CONGESTOR_TAG 200
+#define VICTIM_TAG    201
+
+static const char *victim_names[] = {"allreduce", "pingpong"};
+static const char *congestor_names[] = {"incast", "alltoall", "put"};
+
+struct impact_stat_t {
+    double avg;
+    double p99;
+};
+
+/* Victims are spread evenly over the ranks, rank 0 is always one. */
+static int is_victim(int rank)
+{
+    return (rank * options.victim_pct) % 100 < options.victim_pct;
+}
+
+static int compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+/*
+ * Times every iteration of the victim kernel in us. Returns the number of
+ * samples, 0 for a pingpong victim without a partner.
+ */
+static int run_victim(MPI_Comm comm, char *s_buf, char *r_buf, size_t size,
+                      int skip, int iterations, double *lat)
+{
+    int i = 0, rank = 0, nprocs = 0, peer = 0;
+    double t_start = 0.0;
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Comm_size(comm, &nprocs));
+    peer = rank ^ 1;
+    if (OMB_VICTIM_PINGPONG == options.victim_kernel && peer >= nprocs) {
+        return 0;
+    }
+    for (i = 0; i < skip + iterations; i++) {
+        if (OMB_VICTIM_ALLREDUCE == options.victim_kernel) {
+            MPI_CHECK(MPI_Barrier(comm));
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Allreduce(s_buf, r_buf, size / sizeof(float),
+                                    MPI_FLOAT, MPI_SUM, comm));
+        } else {
+            t_start = MPI_Wtime();
+            if (rank < peer) {
+                MPI_CHECK(MPI_Send(s_buf, size, MPI_CHAR, peer, VICTIM_TAG,
+                                   comm));
+                MPI_CHECK(MPI_Recv(r_buf, size, MPI_CHAR, peer, VICTIM_TAG,
+                                   comm, MPI_STATUS_IGNORE));
+            } else {
+                MPI_CHECK(MPI_Recv(r_buf, size, MPI_CHAR, peer, VICTIM_TAG,
+                                   comm, MPI_STATUS_IGNORE));
+                MPI_CHECK(MPI_Send(s_buf, size, MPI_CHAR, peer, VICTIM_TAG,
+                                   comm));
+            }
+        }
+        if (i >= skip) {
+            lat[i - skip] = (MPI_Wtime() - t_start) * 1e6;
+            if (OMB_VICTIM_PINGPONG == options.victim_kernel) {
+                lat[i - skip] /= 2;
+            }
+        }
+    }
+    return iterations;
+}
+
+/* One round of the congestor on the communicator of the congestors. */
+static void run_congestor(MPI_Comm comm, MPI_Win win, char *s_buf,
+                          char *r_buf, MPI_Request *req, int round)
+{
+    int i = 0, rank = 0, nprocs = 0, target = 0;
+    size_t size = options.congestor_size;
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Comm_size(comm, &nprocs));
+    switch (options.congestor) {
+        case OMB_CONGESTOR_INCAST:
+            if (0 == rank) {
+                for (i = 1; i < nprocs; i++) {
+                    MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, i,
+                                        CONGESTOR_TAG, comm, &req[i - 1]));
+                }
+                MPI_CHECK(MPI_Waitall(nprocs - 1, req, MPI_STATUSES_IGNORE));
+            } else {
+                MPI_CHECK(MPI_Send(s_buf, size, MPI_CHAR, 0, CONGESTOR_TAG,
+                                   comm));
+            }
+            break;
+        case OMB_CONGESTOR_ALLTOALL:
+            MPI_CHECK(MPI_Alltoall(s_buf, size, MPI_CHAR, r_buf, size,
+                                   MPI_CHAR, comm));
+            break;
+        case OMB_CONGESTOR_PUT:
+            /* a different target in every round, never the origin */
+            target = (rank + 1 + round % (nprocs - 1)) % nprocs;
+            MPI_CHECK(MPI_Put(s_buf, size, MPI_CHAR, target, 0, size, MPI_CHAR,
+                              win));
+            MPI_CHECK(MPI_Win_flush(target, win));
+            break;
+    }
+}
+
+/*
+ * Runs the congestor until every victim is done. The victims enter the
+ * non-blocking barrier when they finish, the congestors when they start.
+ * Rank 0 of the congestors decides when to stop so that all of them run
+ * the same number of collective rounds.
+ */
+static void congest(MPI_Comm comm, MPI_Win win, char *s_buf, char *r_buf,
+                    MPI_Request *req)
+{
+    int round = 0, rank = 0, stop = 0;
+    MPI_Request done_req = MPI_REQUEST_NULL;
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Ibarrier(MPI_COMM_WORLD, &done_req));
+    while (!stop) {
+        run_congestor(comm, win, s_buf, r_buf, req, round++);
+        if (0 == rank) {
+            MPI_CHECK(MPI_Test(&done_req, &stop, MPI_STATUS_IGNORE));
+        }
+        MPI_CHECK(MPI_Bcast(&stop, 1, MPI_INT, 0, comm));
+    }
+    MPI_CHECK(MPI_Wait(&done_req, MPI_STATUS_IGNORE));
+}
+
+/* Statistics of the samples of all victims, valid at rank 0 of comm. */
+static struct impact_stat_t victim_stat(MPI_Comm comm, double *lat,
+                                        int num_samples)
+{
+    int i = 0, rank = 0, nprocs = 0, total = 0;
+    int *counts = NULL, *displs = NULL;
+    double *all_lat = NULL;
+    struct impact_stat_t stat = {0.0, 0.0};
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Comm_size(comm, &nprocs));
+    if (0 == rank) {
+        counts = malloc(sizeof(int) * nprocs);
+        displs = malloc(sizeof(int) * nprocs);
+        OMB_CHECK_NULL_AND_EXIT(counts, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(displs, "Unable to allocate memory");
+    }
+    MPI_CHECK(MPI_Gather(&num_samples, 1, MPI_INT, counts, 1, MPI_INT, 0,
+                         comm));
+    if (0 == rank) {
+        for (i = 0; i < nprocs; i++) {
+            displs[i] = total;
+            total += counts[i];
+        }
+        all_lat = malloc(sizeof(double) * total);
+        OMB_CHECK_NULL_AND_EXIT(all_lat, "Unable to allocate memory");
+    }
+    MPI_CHECK(MPI_Gatherv(lat, num_samples, MPI_DOUBLE, all_lat, counts,
+                          displs, MPI_DOUBLE, 0, comm));
+    if (0 == rank) {
+        qsort(all_lat, total, sizeof(double), compare_double);
+        for (i = 0; i < total; i++) {
+            stat.avg += all_lat[i];
+        }
+        stat.avg /= total;
+        stat.p99 = all_lat[(int)ceil(0.99 * total) - 1];
+        free(all_lat);
+        free(counts);
+        free(displs);
+    }
+    return stat;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = PO_OKAY, victim = 0;
+    int num_victims = 0, num_congestors = 0, iterations = 0, skip = 0;
+    int num_samples = 0;
+    size_t size = 0, bufsize = 0, cong_bufsize = 0;
+    char *s_buf = NULL, *r_buf = NULL, *cong_s_buf = NULL, *cong_r_buf = NULL;
+    double *lat = NULL;
+    struct impact_stat_t base = {0.0, 0.0}, loaded = {0.0, 0.0};
+    MPI_Request *req = NULL, done_req = MPI_REQUEST_NULL;
+    MPI_Comm group_comm = MPI_COMM_NULL;
+    MPI_Win win = MPI_WIN_NULL;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = CONG_IMPACT;
+    set_header(HEADER);
+    set_benchmark_name("osu_cong_impact");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    if (MPI_COMM_NULL == omb_init_h.omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+
+    victim = is_victim(rank);
+    MPI_CHECK(MPI_Allreduce(&victim, &num_victims, 1, MPI_INT, MPI_SUM,
+                            MPI_COMM_WORLD));
+    num_congestors = numprocs - num_victims;
+    if (num_victims < 2 || num_congestors < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test needs at least two victims and two"
+                            " congestors, got %d and %d. Use more processes"
+                            " or change the victim percentage\n",
+                    num_victims, num_congestors);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    MPI_CHECK(MPI_Comm_split(MPI_COMM_WORLD, victim, rank, &group_comm));
+
+    bufsize = options.max_message_size;
+    cong_bufsize = options.congestor_size;
+    if (OMB_CONGESTOR_ALLTOALL == options.congestor) {
+        cong_bufsize *= num_congestors;
+    }
+    s_buf = malloc(bufsize);
+    r_buf = malloc(bufsize);
+    lat = malloc(sizeof(double) *
+                 MAX(options.iterations, options.iterations_large));
+    OMB_CHECK_NULL_AND_EXIT(s_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(r_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(lat, "Unable to allocate memory");
+    memset(s_buf, 0, bufsize);
+    memset(r_buf, 0, bufsize);
+    if (!victim) {
+        cong_s_buf = malloc(cong_bufsize);
+        req = malloc(sizeof(MPI_Request) * num_congestors);
+        OMB_CHECK_NULL_AND_EXIT(cong_s_buf, "Unable to allocate memory");
+        OMB_CHECK_NULL_AND_EXIT(req, "Unable to allocate memory");
+        memset(cong_s_buf, 0, cong_bufsize);
+        if (OMB_CONGESTOR_PUT == options.congestor) {
+            MPI_CHECK(MPI_Win_allocate(cong_bufsize, 1, MPI_INFO_NULL,
+                                       group_comm, &cong_r_buf, &win));
+            MPI_CHECK(MPI_Win_lock_all(0, win));
+        } else {
+            cong_r_buf = malloc(cong_bufsize);
+            OMB_CHECK_NULL_AND_EXIT(cong_r_buf, "Unable to allocate memory");
+            memset(cong_r_buf, 0, cong_bufsize);
+        }
+    }
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Victims: %d running %s\n", num_victims,
+                victim_names[options.victim_kernel]);
+        fprintf(stdout, "# Congestors: %d running %s of %zu bytes\n",
+                num_congestors, congestor_names[options.congestor],
+                options.congestor_size);
+        fprintf(stdout, "# Impact is the congested over the isolated"
+                        " latency of the victims\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Base Avg(us)", FIELD_WIDTH, "Base P99(us)", FIELD_WIDTH,
+                "Cong Avg(us)", FIELD_WIDTH, "Cong P99(us)", FIELD_WIDTH,
+                "Avg Impact", FIELD_WIDTH, "P99 Impact");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size *= 2) {
+        if (OMB_VICTIM_ALLREDUCE == options.victim_kernel &&
+            0 == size / sizeof(float)) {
+            continue;
+        }
+        iterations = options.iterations;
+        skip = options.skip;
+        if (size > LARGE_MESSAGE_SIZE) {
+            iterations = options.iterations_large;
+            skip = options.skip_large;
+        }
+
+        /* isolated baseline, the congestors wait */
+        MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+        if (victim) {
+            num_samples = run_victim(group_comm, s_buf, r_buf, size, skip,
+                                     iterations, lat);
+            base = victim_stat(group_comm, lat, num_samples);
+        }
+        MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+
+        /* the same victim kernel under congestion */
+        if (victim) {
+            num_samples = run_victim(group_comm, s_buf, r_buf, size, skip,
+                                     iterations, lat);
+            MPI_CHECK(MPI_Ibarrier(MPI_COMM_WORLD, &done_req));
+            MPI_CHECK(MPI_Wait(&done_req, MPI_STATUS_IGNORE));
+            loaded = victim_stat(group_comm, lat, num_samples);
+        } else {
+            congest(group_comm, win, cong_s_buf, cong_r_buf, req);
+        }
+
+        if (0 == rank) {
+            fprintf(stdout, "%-*zu", 10, size);
+            fprintf(stdout, "%*.*f%*.*f%*.*f%*.*f%*.*f%*.*f\n", FIELD_WIDTH,
+                    FLOAT_PRECISION, base.avg, FIELD_WIDTH, FLOAT_PRECISION,
+                    base.p99, FIELD_WIDTH, FLOAT_PRECISION, loaded.avg,
+                    FIELD_WIDTH, FLOAT_PRECISION, loaded.p99, FIELD_WIDTH,
+                    FLOAT_PRECISION, loaded.avg / base.avg, FIELD_WIDTH,
+                    FLOAT_PRECISION, loaded.p99 / base.p99);
+            fflush(stdout);
+        }
+    }
+
+    if (MPI_WIN_NULL != win) {
+        MPI_CHECK(MPI_Win_unlock_all(win));
+        MPI_CHECK(MPI_Win_free(&win));
+    } else {
+        free(cong_r_buf);
+    }
+    free(cong_s_buf);
+    free(req);
+    free(s_buf);
+    free(r_buf);
+    free(lat);
+    MPI_CHECK(MPI_Comm_free(&group_comm));
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,309 @@
+/*
+ * Copyright (C) 2002-2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include "osu_util_mpi.h"
+#include "osu_traffic_pattern.h"
+
+/*
+ * Random numbers of the patterns. Every rank draws the same sequence for the
+ * same seed, independent of the C library.
+ */
+static unsigned int traffic_rand(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned int)(*state >> 33);
+}
+
+static int traffic_log2(int n)
+{
+    int k = 0;
+
+    while ((2 << k) <= n) {
+        k++;
+    }
+    return k;
+}
+
+/*
+ * Destination of every rank for the permutation patterns, -1 for the ranks
+ * that do not send. Ranks mapped onto themselves do not send either.
+ */
+static int *traffic_permutation(int n, int *active_ranks)
+{
+    int r = 0, j = 0, tmp = 0, k = 0, h = 0, bit = 0;
+    int *perm = NULL;
+    uint64_t state = options.traffic_seed;
+
+    perm = malloc(sizeof(int) * n);
+    OMB_CHECK_NULL_AND_EXIT(perm, "Unable to allocate memory");
+    *active_ranks = n;
+    switch (options.traffic_pattern) {
+        case OMB_TRAFFIC_RANDOM:
+            /* Sattolo's algorithm: a single cycle, so nobody maps to self */
+            for (r = 0; r < n; r++) {
+                perm[r] = r;
+            }
+            for (r = n - 1; r > 0; r--) {
+                j = traffic_rand(&state) % r;
+                tmp = perm[r];
+                perm[r] = perm[j];
+                perm[j] = tmp;
+            }
+            break;
+        case OMB_TRAFFIC_BITREV:
+        case OMB_TRAFFIC_TRANSPOSE:
+            /* defined on the largest power of two of ranks */
+            k = traffic_log2(n);
+            h = k / 2;
+            *active_ranks = 1 << k;
+            for (r = 0; r < n; r++) {
+                perm[r] = -1;
+                if (r >= *active_ranks) {
+                    continue;
+                }
+                if (OMB_TRAFFIC_BITREV == options.traffic_pattern) {
+                    perm[r] = 0;
+                    for (bit = 0; bit < k; bit++) {
+                        if (r & (1 << bit)) {
+                            perm[r] |= 1 << (k - 1 - bit);
+                        }
+                    }
+                } else {
+                    perm[r] = ((r & ((1 << h) - 1)) << (k - h)) | (r >> h);
+                }
+            }
+            break;
+        case OMB_TRAFFIC_RING:
+            for (r = 0; r < n; r++) {
+                perm[r] = (r + 1) % n;
+            }
+            break;
+        case OMB_TRAFFIC_TORNADO:
+            for (r = 0; r < n; r++) {
+                perm[r] = (r + (n + 1) / 2 - 1) % n;
+            }
+            break;
+        default:
+            OMB_ERROR_EXIT("Not a permutation pattern");
+            break;
+    }
+    for (r = 0; r < n; r++) {
+        if (perm[r] == r) {
+            perm[r] = -1;
+        }
+    }
+    return perm;
+}
+
+/*
+ * Reads the N x N pattern matrix at rank 0. Entry (i, j) other than 0 is a
+ * flow from rank i to rank j, lines starting with '#' are comments. Returns
+ * the flows as source and destination pairs. The other ranks are waiting in
+ * the broadcast of the flows, so errors abort comm.
+ */
+static int *traffic_read_file(MPI_Comm comm, int n, int *num_flows)
+{
+    FILE *fp = NULL;
+    int c = 0, value = 0, entries = 0;
+    int *flows = NULL;
+
+    fp = fopen(options.traffic_file, "r");
+    if (NULL == fp) {
+        fprintf(stderr, "ERROR: Unable to open traffic pattern file %s\n",
+                options.traffic_file);
+        MPI_CHECK(MPI_Abort(comm, EXIT_FAILURE));
+    }
+    flows = malloc(sizeof(int) * 2 * n * n);
+    OMB_CHECK_NULL_AND_EXIT(flows, "Unable to allocate memory");
+    *num_flows = 0;
+    while (EOF != (c = fgetc(fp))) {
+        if ('#' == c) {
+            while (EOF != c && '\n' != c) {
+                c = fgetc(fp);
+            }
+            continue;
+        }
+        if (isspace(c)) {
+            continue;
+        }
+        ungetc(c, fp);
+        if (1 != fscanf(fp, "%d", &value) || entries == n * n) {
+            fprintf(stderr, "ERROR: %s must hold a %d x %d matrix of"
+                            " integers\n", options.traffic_file, n, n);
+            MPI_CHECK(MPI_Abort(comm, EXIT_FAILURE));
+        }
+        if (value && entries / n != entries % n) {
+            flows[2 * *num_flows] = entries / n;
+            flows[2 * *num_flows + 1] = entries % n;
+            (*num_flows)++;
+        }
+        entries++;
+    }
+    fclose(fp);
+    if (entries != n * n) {
+        fprintf(stderr, "ERROR: %s has %d entries, expected a %d x %d"
+                        " matrix\n", options.traffic_file, entries, n, n);
+        MPI_CHECK(MPI_Abort(comm, EXIT_FAILURE));
+    }
+    return flows;
+}
+
+static void traffic_set_flows(traffic_info_t *traffic_info, MPI_Comm comm,
+                              int rank, int n)
+{
+    int r = 0, j = 0, tmp = 0, num_flows = 0;
+    int *perm = NULL, *flows = NULL;
+    uint64_t state = options.traffic_seed + rank;
+
+    traffic_info->dsts = malloc(sizeof(int) * n);
+    traffic_info->srcs = malloc(sizeof(int) * n);
+    OMB_CHECK_NULL_AND_EXIT(traffic_info->dsts, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(traffic_info->srcs, "Unable to allocate memory");
+    traffic_info->num_dsts = 0;
+    traffic_info->num_srcs = 0;
+    traffic_info->active_ranks = n;
+    switch (options.traffic_pattern) {
+        case OMB_TRAFFIC_SHUFFLE:
+            /* every rank sends to all others, in its own random order */
+            for (r = 0; r < n; r++) {
+                if (r != rank) {
+                    traffic_info->dsts[traffic_info->num_dsts++] = r;
+                    traffic_info->srcs[traffic_info->num_srcs++] = r;
+                }
+            }
+            for (r = traffic_info->num_dsts - 1; r > 0; r--) {
+                j = traffic_rand(&state) % (r + 1);
+                tmp = traffic_info->dsts[r];
+                traffic_info->dsts[r] = traffic_info->dsts[j];
+                traffic_info->dsts[j] = tmp;
+            }
+            break;
+        case OMB_TRAFFIC_FILE:
+            if (0 == rank) {
+                flows = traffic_read_file(comm, n, &num_flows);
+            }
+            MPI_CHECK(MPI_Bcast(&num_flows, 1, MPI_INT, 0, comm));
+            if (0 != rank) {
+                flows = malloc(sizeof(int) * 2 * MAX(num_flows, 1));
+                OMB_CHECK_NULL_AND_EXIT(flows, "Unable to allocate memory");
+            }
+            MPI_CHECK(MPI_Bcast(flows, 2 * num_flows, MPI_INT, 0, comm));
+            for (j = 0; j < num_flows; j++) {
+                if (flows[2 * j] == rank) {
+                    traffic_info->dsts[traffic_info->num_dsts++] =
+                        flows[2 * j + 1];
+                }
+                if (flows[2 * j + 1] == rank) {
+                    traffic_info->srcs[traffic_info->num_srcs++] = flows[2 * j];
+                }
+            }
+            free(flows);
+            break;
+        default:
+            perm = traffic_permutation(n, &traffic_info->active_ranks);
+            for (r = 0; r < n; r++) {
+                if (r == rank && -1 != perm[r]) {
+                    traffic_info->dsts[traffic_info->num_dsts++] = perm[r];
+                }
+                if (perm[r] == rank) {
+                    traffic_info->srcs[traffic_info->num_srcs++] = r;
+                }
+            }
+            free(perm);
+            break;
+    }
+}
+
+/*
+ * Node of every rank, numbered by the lowest world rank on the node. Nodes
+ * may run different numbers of processes.
+ */
+static int *traffic_node_ids(traffic_info_t *traffic_info, MPI_Comm comm,
+                             int rank, int n)
+{
+    int node = 0, local_rank = 0, local_size = 0, leader = 0;
+    int *node_ids = NULL;
+    MPI_Comm node_comm = MPI_COMM_NULL, leader_comm = MPI_COMM_NULL;
+
+    MPI_CHECK(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank,
+                                  MPI_INFO_NULL, &node_comm));
+    MPI_CHECK(MPI_Comm_rank(node_comm, &local_rank));
+    MPI_CHECK(MPI_Comm_size(node_comm, &local_size));
+    leader = 0 == local_rank;
+    MPI_CHECK(MPI_Comm_split(comm, leader ? 0 : MPI_UNDEFINED, rank,
+                             &leader_comm));
+    if (leader) {
+        MPI_CHECK(MPI_Comm_rank(leader_comm, &node));
+        MPI_CHECK(MPI_Comm_free(&leader_comm));
+    }
+    MPI_CHECK(MPI_Bcast(&node, 1, MPI_INT, 0, node_comm));
+    MPI_CHECK(MPI_Comm_free(&node_comm));
+
+    node_ids = malloc(sizeof(int) * n);
+    OMB_CHECK_NULL_AND_EXIT(node_ids, "Unable to allocate memory");
+    MPI_CHECK(MPI_Allgather(&node, 1, MPI_INT, node_ids, 1, MPI_INT,
+                            comm));
+    MPI_CHECK(MPI_Allreduce(&local_size, &traffic_info->min_ppn, 1, MPI_INT,
+                            MPI_MIN, comm));
+    MPI_CHECK(MPI_Allreduce(&local_size, &traffic_info->max_ppn, 1, MPI_INT,
+                            MPI_MAX, comm));
+    MPI_CHECK(MPI_Allreduce(&leader, &traffic_info->num_nodes, 1, MPI_INT,
+                            MPI_SUM, comm));
+    return node_ids;
+}
+
+traffic_info_t omb_traffic_init(MPI_Comm comm)
+{
+    int rank = 0, n = 0, i = 0, inter_node = 0;
+    int *node_ids = NULL;
+    traffic_info_t traffic_info;
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Comm_size(comm, &n));
+    traffic_set_flows(&traffic_info, comm, rank, n);
+    node_ids = traffic_node_ids(&traffic_info, comm, rank, n);
+    for (i = 0; i < traffic_info.num_dsts; i++) {
+        if (node_ids[traffic_info.dsts[i]] != node_ids[rank]) {
+            inter_node++;
+        }
+    }
+    MPI_CHECK(MPI_Allreduce(&traffic_info.num_dsts, &traffic_info.total_flows,
+                            1, MPI_INT, MPI_SUM, comm));
+    MPI_CHECK(MPI_Allreduce(&inter_node, &traffic_info.inter_node_flows, 1,
+                            MPI_INT, MPI_SUM, comm));
+    free(node_ids);
+    return traffic_info;
+}
+
+void omb_traffic_free(traffic_info_t traffic_info)
+{
+    free(traffic_info.dsts);
+    free(traffic_info.srcs);
+}
+
+const char *omb_traffic_name(void)
+{
+    switch (options.traffic_pattern) {
+        case OMB_TRAFFIC_RANDOM:
+            return "random permutation";
+        case OMB_TRAFFIC_BITREV:
+            return "bit reversal";
+        case OMB_TRAFFIC_TRANSPOSE:
+            return "transpose";
+        case OMB_TRAFFIC_RING:
+            return "nearest neighbor ring";
+        case OMB_TRAFFIC_TORNADO:
+            return "tornado";
+        case OMB_TRAFFIC_SHUFFLE:
+            return "all-to-all shuffle";
+        case OMB_TRAFFIC_FILE:
+            return options.traffic_file;
+    }
+    return "unknown";
+}
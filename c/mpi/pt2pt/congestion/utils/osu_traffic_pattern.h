@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2002-2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#ifndef OSU_TRAFFIC_PATTERN_H
+#define OSU_TRAFFIC_PATTERN_H
+
+#define TRAFFIC_PATTERN_TAG 100
+
+typedef struct traffic_info_t {
+    int num_dsts;       /* flows sent by this rank */
+    int *dsts;
+    int num_srcs;       /* flows received by this rank */
+    int *srcs;
+    int total_flows;    /* flows of all ranks */
+    int inter_node_flows;
+    int num_nodes;
+    int min_ppn;
+    int max_ppn;
+    int active_ranks;   /* ranks the pattern is defined on */
+} traffic_info_t;
+
+traffic_info_t omb_traffic_init(MPI_Comm comm);
+void omb_traffic_free(traffic_info_t traffic_info);
+const char *omb_traffic_name(void);
+
+#endif
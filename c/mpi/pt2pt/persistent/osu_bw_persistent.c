@@ -19,6 +19,7 @@ int main(int argc, char *argv[])
     int size;
     char **s_buf, **r_buf;
     double t_start = 0.0, t_end = 0.0, t_lo = 0.0, t_total = 0.0;
+    double bw_contended = 0.0;
     int window_size = 64;
     int po_ret = 0;
     int errors = 0;
@@ -36,6 +37,7 @@ int main(int argc, char *argv[])
     omb_mpi_init_data omb_init_h;
     options.bench = PT2PT;
     options.subtype = BW;
+    options.contention = 1;
     struct omb_buffer_sizes_t omb_buffer_sizes;
     double *omb_lat_arr = NULL;
     struct omb_stat_t omb_stat;
@@ -361,6 +363,12 @@ int main(int argc, char *argv[])
                 }
             }
             omb_papi_stop_and_print(&papi_eventset, size);
+            if (options.contention_threads) {
+                bw_contended = omb_contended_bw(
+                    omb_comm, 1, 0, s_buf[0], r_buf[0], num_elements,
+                    omb_curr_datatype,
+                    options.omb_enable_ddt ? omb_ddt_transmit_size : size);
+            }
             for (j = 0; j < window_size; j++) {
                 MPI_Request_free(request + j);
             }
@@ -388,6 +396,10 @@ int main(int argc, char *argv[])
                 if (options.omb_enable_ddt) {
                     fprintf(stdout, "%*zu", FIELD_WIDTH, omb_ddt_transmit_size);
                 }
+                if (options.contention_threads) {
+                    fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                            bw_contended);
+                }
                 fprintf(stdout, "\n");
                 fflush(stdout);
                 if (options.graph && 0 == myid) {
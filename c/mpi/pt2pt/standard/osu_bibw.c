@@ -18,6 +18,7 @@ int main(int argc, char *argv[])
     int size;
     char **s_buf, **r_buf;
     double t_start = 0.0, t_end = 0.0, t_lo = 0.0, t_total = 0.0;
+    double bw_contended = 0.0;
     int window_size = 64;
     int po_ret = 0;
     int errors = 0;
@@ -27,6 +28,7 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     options.bench = PT2PT;
     options.subtype = BW;
+    options.contention = 1;
     size_t num_elements = 0;
     MPI_Datatype omb_curr_datatype = MPI_CHAR;
     size_t omb_ddt_transmit_size = 0;
@@ -404,6 +406,12 @@ int main(int argc, char *argv[])
                 }
             }
             omb_papi_stop_and_print(&papi_eventset, size);
+            if (options.contention_threads) {
+                bw_contended = omb_contended_bw(
+                    omb_comm, 1, 1, s_buf[0], r_buf[0], num_elements,
+                    omb_curr_datatype,
+                    options.omb_enable_ddt ? omb_ddt_transmit_size : size);
+            }
 
             if (myid == 0) {
                 if (options.omb_enable_ddt) {
@@ -429,6 +437,10 @@ int main(int argc, char *argv[])
                 if (options.omb_enable_ddt) {
                     fprintf(stdout, "%*zu", FIELD_WIDTH, omb_ddt_transmit_size);
                 }
+                if (options.contention_threads) {
+                    fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                            bw_contended);
+                }
                 fprintf(stdout, "\n");
                 fflush(stdout);
                 if (options.graph && 0 == myid) {
@@ -16,9 +16,10 @@ double calculate_total(double, double, double, int);
 int main(int argc, char *argv[])
 {
     int myid = 0, numprocs = 0, i = 0, j = 0, k = 0, l = 0;
-    int size;
+    size_t size;
     char **s_buf, **r_buf;
     double t_start = 0.0, t_end = 0.0, t_lo = 0.0, t_total = 0.0;
+    double bw_contended = 0.0;
     int window_size = 64;
     int po_ret = 0;
     int errors = 0;
@@ -34,6 +35,9 @@ int main(int argc, char *argv[])
     int papi_eventset = OMB_PAPI_NULL;
     options.bench = PT2PT;
     options.subtype = BW;
+    options.large_count = OMB_LARGE_COUNT;
+    options.buffer_policies = 1;
+    options.contention = 1;
     MPI_Comm omb_comm = MPI_COMM_NULL;
     omb_mpi_init_data omb_init_h;
     struct omb_buffer_sizes_t omb_buffer_sizes;
@@ -202,6 +206,8 @@ int main(int argc, char *argv[])
             t_total = 0.0;
 
             for (i = 0; i < options.iterations + options.skip; i++) {
+                omb_buffer_policy_next((void **)&s_buf[0], (void **)&r_buf[0],
+                                       size);
                 if (i == options.skip) {
                     omb_papi_start(&papi_eventset);
                 }
@@ -235,13 +241,15 @@ int main(int argc, char *argv[])
 
                         for (j = 0; j < window_size; j++) {
                             if (options.buf_num == SINGLE) {
-                                MPI_CHECK(MPI_Isend(s_buf[0], num_elements,
-                                                    omb_curr_datatype, 1, 100,
-                                                    omb_comm, request + j));
+                                MPI_CHECK(OMB_MPI_LARGE(
+                                    MPI_Isend, num_elements,
+                                    (s_buf[0], num_elements, omb_curr_datatype,
+                                     1, 100, omb_comm, request + j)));
                             } else {
-                                MPI_CHECK(MPI_Isend(s_buf[j], num_elements,
-                                                    omb_curr_datatype, 1, 100,
-                                                    omb_comm, request + j));
+                                MPI_CHECK(OMB_MPI_LARGE(
+                                    MPI_Isend, num_elements,
+                                    (s_buf[j], num_elements, omb_curr_datatype,
+                                     1, 100, omb_comm, request + j)));
                             }
                         }
                         MPI_CHECK(MPI_Waitall(window_size, request, reqstat));
@@ -303,13 +311,15 @@ int main(int argc, char *argv[])
 #endif /* #ifdef _ENABLE_CUDA_KERNEL_ */
                         for (j = 0; j < window_size; j++) {
                             if (options.buf_num == SINGLE) {
-                                MPI_CHECK(MPI_Irecv(r_buf[0], num_elements,
-                                                    omb_curr_datatype, 0, 100,
-                                                    omb_comm, request + j));
+                                MPI_CHECK(OMB_MPI_LARGE(
+                                    MPI_Irecv, num_elements,
+                                    (r_buf[0], num_elements, omb_curr_datatype,
+                                     0, 100, omb_comm, request + j)));
                             } else {
-                                MPI_CHECK(MPI_Irecv(r_buf[j], num_elements,
-                                                    omb_curr_datatype, 0, 100,
-                                                    omb_comm, request + j));
+                                MPI_CHECK(OMB_MPI_LARGE(
+                                    MPI_Irecv, num_elements,
+                                    (r_buf[j], num_elements, omb_curr_datatype,
+                                     0, 100, omb_comm, request + j)));
                             }
                         }
                         MPI_CHECK(MPI_Waitall(window_size, request, reqstat));
@@ -358,7 +368,14 @@ int main(int argc, char *argv[])
                     }
                 }
             }
+            omb_buffer_policy_reset((void **)&s_buf[0], (void **)&r_buf[0]);
             omb_papi_stop_and_print(&papi_eventset, size);
+            if (options.contention_threads) {
+                bw_contended = omb_contended_bw(
+                    omb_comm, 1, 0, s_buf[0], r_buf[0], num_elements,
+                    omb_curr_datatype,
+                    options.omb_enable_ddt ? omb_ddt_transmit_size : size);
+            }
 
             if (myid == 0) {
                 if (options.omb_enable_ddt) {
@@ -367,7 +384,7 @@ int main(int argc, char *argv[])
                 } else {
                     tmp_total = size / 1e6 * options.iterations * window_size;
                 }
-                fprintf(stdout, "%-*d", 10, size);
+                fprintf(stdout, "%-*zu", 10, size);
                 if (options.validate) {
                     fprintf(stdout, "%*.*f%*s", FIELD_WIDTH, FLOAT_PRECISION,
                             tmp_total / t_total, FIELD_WIDTH,
@@ -383,6 +400,10 @@ int main(int argc, char *argv[])
                 if (options.omb_enable_ddt) {
                     fprintf(stdout, "%*zu", FIELD_WIDTH, omb_ddt_transmit_size);
                 }
+                if (options.contention_threads) {
+                    fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                            bw_contended);
+                }
                 fprintf(stdout, "\n");
                 fflush(stdout);
                 if (options.graph && 0 == myid) {
@@ -429,7 +450,7 @@ int main(int argc, char *argv[])
     if (0 != errors && options.validate && 0 == myid) {
         fprintf(stdout,
                 "DATA VALIDATION ERROR: %s exited with status %d on"
-                " message size %d.\n",
+                " message size %zu.\n",
                 argv[0], EXIT_FAILURE, size);
         exit(EXIT_FAILURE);
     }
@@ -15,7 +15,7 @@ double calculate_total(double, double, double);
 int main(int argc, char *argv[])
 {
     int myid, numprocs, i, j;
-    int size;
+    size_t size;
     MPI_Status reqstat;
     omb_graph_options_t omb_graph_options;
     omb_graph_data_t *omb_graph_data = NULL;
@@ -34,6 +34,8 @@ int main(int argc, char *argv[])
     omb_mpi_init_data omb_init_h;
     options.bench = PT2PT;
     options.subtype = LAT;
+    options.large_count = OMB_LARGE_COUNT;
+    options.buffer_policies = 1;
     struct omb_buffer_sizes_t omb_buffer_sizes;
     double *omb_lat_arr = NULL;
     struct omb_stat_t omb_stat;
@@ -175,6 +177,7 @@ int main(int argc, char *argv[])
             t_total = 0.0;
 
             for (i = 0; i < options.iterations + options.skip; i++) {
+                omb_buffer_policy_next((void **)&s_buf, (void **)&r_buf, size);
                 if (i == options.skip) {
                     omb_papi_start(&papi_eventset);
                 }
@@ -194,11 +197,14 @@ int main(int argc, char *argv[])
                             touch_managed_src_no_window(s_buf, size, ADD);
                         }
 #endif /* #ifdef _ENABLE_CUDA_KERNEL_ */
-                        MPI_CHECK(MPI_Send(s_buf, num_elements,
-                                           omb_curr_datatype, 1, 1, omb_comm));
-                        MPI_CHECK(MPI_Recv(r_buf, num_elements,
-                                           omb_curr_datatype, 1, 1, omb_comm,
-                                           &reqstat));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Send, num_elements,
+                            (s_buf, num_elements, omb_curr_datatype, 1, 1,
+                             omb_comm)));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Recv, num_elements,
+                            (r_buf, num_elements, omb_curr_datatype, 1, 1,
+                             omb_comm, &reqstat)));
 #ifdef _ENABLE_CUDA_KERNEL_
                         if (options.src == 'M') {
                             touch_managed_src_no_window(r_buf, size, SUB);
@@ -239,16 +245,19 @@ int main(int argc, char *argv[])
                             touch_managed_dst_no_window(s_buf, size, ADD);
                         }
 #endif /* #ifdef _ENABLE_CUDA_KERNEL_ */
-                        MPI_CHECK(MPI_Recv(r_buf, num_elements,
-                                           omb_curr_datatype, 0, 1, omb_comm,
-                                           &reqstat));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Recv, num_elements,
+                            (r_buf, num_elements, omb_curr_datatype, 0, 1,
+                             omb_comm, &reqstat)));
 #ifdef _ENABLE_CUDA_KERNEL_
                         if (options.dst == 'M') {
                             touch_managed_dst_no_window(r_buf, size, SUB);
                         }
 #endif /* #ifdef _ENABLE_CUDA_KERNEL_ */
-                        MPI_CHECK(MPI_Send(s_buf, num_elements,
-                                           omb_curr_datatype, 0, 1, omb_comm));
+                        MPI_CHECK(OMB_MPI_LARGE(
+                            MPI_Send, num_elements,
+                            (s_buf, num_elements, omb_curr_datatype, 0, 1,
+                             omb_comm)));
                     }
 #ifdef _ENABLE_CUDA_KERNEL_
                     if (options.validate &&
@@ -272,11 +281,12 @@ int main(int argc, char *argv[])
                 }
             }
 
+            omb_buffer_policy_reset((void **)&s_buf, (void **)&r_buf);
             omb_papi_stop_and_print(&papi_eventset, size);
 
             if (myid == 0) {
                 double latency = (t_total * 1e6) / (2.0 * options.iterations);
-                fprintf(stdout, "%-*d", 10, size);
+                fprintf(stdout, "%-*zu", 10, size);
                 if (options.validate) {
                     fprintf(stdout, "%*.*f%*s", FIELD_WIDTH, FLOAT_PRECISION,
                             latency, FIELD_WIDTH, VALIDATION_STATUS(errors));
@@ -332,7 +342,7 @@ int main(int argc, char *argv[])
     if (errors != 0 && options.validate && myid == 0) {
         fprintf(stdout,
                 "DATA VALIDATION ERROR: %s exited with status %d on"
-                " message size %d.\n",
+                " message size %zu.\n",
                 argv[0], EXIT_FAILURE, size);
         exit(EXIT_FAILURE);
     }
@@ -112,11 +112,13 @@ int main(int argc, char *argv[])
             sr_processes[i] = fork();
             if (sr_processes[i] == 0) {
                 is_child = 1;
+                omb_affinity_bind_thread(i + 1);
                 break;
             }
         }
 
         if (is_child == 0) {
+            omb_affinity_bind_thread(0);
             communicate(myid);
         } else {
             sleep(CHILD_SLEEP_SECONDS);
@@ -126,10 +128,12 @@ int main(int argc, char *argv[])
             sr_processes[i] = fork();
             if (sr_processes[i] == 0) {
                 is_child = 1;
+                omb_affinity_bind_thread(i + 1);
                 break;
             }
         }
         if (is_child == 0) {
+            omb_affinity_bind_thread(0);
             communicate(myid);
         } else {
             sleep(CHILD_SLEEP_SECONDS);
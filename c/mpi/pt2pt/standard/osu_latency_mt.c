@@ -156,6 +156,7 @@ int main(int argc, char *argv[])
     if (options.sender_thread != -1) {
         num_threads_sender = options.sender_thread;
     }
+    omb_affinity_init(omb_comm);
 
     pthread_barrier_init(&sender_barrier, NULL, num_threads_sender);
 
@@ -210,6 +211,7 @@ void *recv_thread(void *arg)
 
     thread_id = (thread_tag_t *)arg;
     val = thread_id->id;
+    omb_affinity_bind_thread(val);
 
     omb_comm = thread_id->omb_init_h.omb_comm;
     MPI_CHECK(MPI_Comm_rank(omb_comm, &myid));
@@ -350,6 +352,7 @@ void *send_thread(void *arg)
     struct omb_stat_t omb_stat;
 
     val = thread_id->id;
+    omb_affinity_bind_thread(val);
 
     omb_comm = thread_id->omb_init_h.omb_comm;
     MPI_CHECK(MPI_Comm_rank(omb_comm, &myid));
@@ -0,0 +1,381 @@
+#define BENCHMARK "OSU MPI%s LogGP Parameter Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+#define LOGGP_MAX_SIZES 64
+
+enum loggp_params_t {
+    LOGGP_RTT,
+    LOGGP_OS,
+    LOGGP_OR,
+    LOGGP_GAP,
+    LOGGP_NUM_PARAMS
+};
+
+static const char *loggp_param_names[LOGGP_NUM_PARAMS] = {
+    "RTT/2(us)", "o_s(us)", "o_r(us)", "g(us)"};
+
+struct loggp_fit {
+    double intercept;
+    double slope;
+    double residual;
+};
+
+MPI_Comm omb_comm = MPI_COMM_NULL;
+MPI_Request *requests = NULL;
+char *s_buf = NULL, *r_buf = NULL;
+
+static void spin(double seconds)
+{
+    double t_end = MPI_Wtime() + seconds;
+
+    while (MPI_Wtime() < t_end) {
+    }
+}
+
+/* Half of the ping-pong round trip time. */
+static double measure_rtt(int rank, size_t size)
+{
+    int i = 0, peer = 1 - rank;
+    double t_start = 0.0;
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (i == options.skip) {
+            t_start = MPI_Wtime();
+        }
+        if (0 == rank) {
+            MPI_CHECK(MPI_Send(s_buf, size, MPI_CHAR, peer, 1, omb_comm));
+            MPI_CHECK(MPI_Recv(r_buf, size, MPI_CHAR, peer, 1, omb_comm,
+                               MPI_STATUS_IGNORE));
+        } else {
+            MPI_CHECK(MPI_Recv(r_buf, size, MPI_CHAR, peer, 1, omb_comm,
+                               MPI_STATUS_IGNORE));
+            MPI_CHECK(MPI_Send(s_buf, size, MPI_CHAR, peer, 1, omb_comm));
+        }
+    }
+    return (MPI_Wtime() - t_start) / (2.0 * options.iterations);
+}
+
+/*
+ * o_s is the time rank 0 spends in MPI_Isend. o_r is the time rank 1 spends
+ * receiving a message that has already arrived: it waits for two round trips
+ * before posting the receive. A zero byte acknowledgement separates the
+ * iterations so that no two messages are in flight at once.
+ */
+static void measure_overheads(int rank, size_t size, double rtt, double *o_s,
+                              double *o_r)
+{
+    int i = 0, peer = 1 - rank;
+    double t_start = 0.0, timer = 0.0;
+    MPI_Request request;
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (0 == rank) {
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Isend(s_buf, size, MPI_CHAR, peer, 1, omb_comm,
+                                &request));
+            t_start = MPI_Wtime() - t_start;
+            MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+            MPI_CHECK(MPI_Recv(r_buf, 0, MPI_CHAR, peer, 2, omb_comm,
+                               MPI_STATUS_IGNORE));
+        } else {
+            spin(2 * rtt);
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, peer, 1, omb_comm,
+                                &request));
+            MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+            t_start = MPI_Wtime() - t_start;
+            MPI_CHECK(MPI_Send(s_buf, 0, MPI_CHAR, peer, 2, omb_comm));
+        }
+        if (i >= options.skip) {
+            timer += t_start;
+        }
+    }
+    timer /= options.iterations;
+    *o_s = (0 == rank) ? timer : 0.0;
+    *o_r = (0 == rank) ? 0.0 : timer;
+}
+
+/* Time for rank 0 to inject a train of count messages, acknowledged once. */
+static double measure_train(int rank, size_t size, int count)
+{
+    int i = 0, j = 0, peer = 1 - rank;
+    double t_start = 0.0;
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (i == options.skip) {
+            t_start = MPI_Wtime();
+        }
+        if (0 == rank) {
+            for (j = 0; j < count; j++) {
+                MPI_CHECK(MPI_Isend(s_buf, size, MPI_CHAR, peer, 1, omb_comm,
+                                    requests + j));
+            }
+            MPI_CHECK(MPI_Waitall(count, requests, MPI_STATUSES_IGNORE));
+            MPI_CHECK(MPI_Recv(r_buf, 0, MPI_CHAR, peer, 2, omb_comm,
+                               MPI_STATUS_IGNORE));
+        } else {
+            for (j = 0; j < count; j++) {
+                MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, peer, 1, omb_comm,
+                                    requests + j));
+            }
+            MPI_CHECK(MPI_Waitall(count, requests, MPI_STATUSES_IGNORE));
+            MPI_CHECK(MPI_Send(s_buf, 0, MPI_CHAR, peer, 2, omb_comm));
+        }
+    }
+    return (MPI_Wtime() - t_start) / options.iterations;
+}
+
+/*
+ * Fits y = intercept + slope * x over [first, last) by least squares on the
+ * relative error, so that small messages weigh as much as large ones.
+ * residual is the RMS relative error of the fit in percent.
+ */
+static void fit_linear(const double *x, const double *y, int first, int last,
+                       struct loggp_fit *fit)
+{
+    int i = 0;
+    double w = 0.0, sw = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    double det = 0.0, err = 0.0;
+
+    for (i = first; i < last; i++) {
+        w = 1.0 / (y[i] * y[i]);
+        sw += w;
+        sx += w * x[i];
+        sy += w * y[i];
+        sxx += w * x[i] * x[i];
+        sxy += w * x[i] * y[i];
+    }
+    det = sw * sxx - sx * sx;
+    if (0.0 == det) {
+        fit->slope = 0.0;
+        fit->intercept = sy / sw;
+    } else {
+        fit->slope = (sw * sxy - sx * sy) / det;
+        fit->intercept = (sy - fit->slope * sx) / sw;
+    }
+    fit->residual = 0.0;
+    for (i = first; i < last; i++) {
+        err = (y[i] - fit->intercept - fit->slope * x[i]) / y[i];
+        fit->residual += err * err;
+    }
+    fit->residual = 100.0 * sqrt(fit->residual / (last - first));
+}
+
+/*
+ * The eager/rendezvous switch is located as the split of the RTT/2 curve
+ * that minimizes the combined residual of two independent fits. Each side
+ * keeps at least three sizes; returns count when no split is possible.
+ */
+static int find_protocol_switch(const double *x, const double *y, int count)
+{
+    int split = 0, best = count;
+    double err = 0.0, best_err = 0.0;
+    struct loggp_fit lo, hi;
+
+    fit_linear(x, y, 0, count, &lo);
+    best_err = lo.residual * lo.residual * count;
+    for (split = 3; split <= count - 3; split++) {
+        fit_linear(x, y, 0, split, &lo);
+        fit_linear(x, y, split, count, &hi);
+        err = lo.residual * lo.residual * split +
+              hi.residual * hi.residual * (count - split);
+        if (err < best_err) {
+            best_err = err;
+            best = split;
+        }
+    }
+    return best;
+}
+
+static void print_fits(const char *range, const double *x,
+                       double (*y)[LOGGP_MAX_SIZES], int first, int last)
+{
+    int param = 0;
+    double latency = 0.0;
+    struct loggp_fit fit[LOGGP_NUM_PARAMS];
+
+    for (param = 0; param < LOGGP_NUM_PARAMS; param++) {
+        fit_linear(x, y[param], first, last, &fit[param]);
+    }
+    latency = fit[LOGGP_RTT].intercept - fit[LOGGP_OS].intercept -
+              fit[LOGGP_OR].intercept;
+    fprintf(stdout, "# %s range: %zu - %zu bytes\n", range, (size_t)x[first],
+            (size_t)x[last - 1]);
+    fprintf(stdout, "#   Hockney: alpha = %.*f us, beta = %.*f ns/byte"
+                    " (%.*f MB/s), residual %.*f%%\n",
+            FLOAT_PRECISION, fit[LOGGP_RTT].intercept, FLOAT_PRECISION + 2,
+            fit[LOGGP_RTT].slope * 1e3, FLOAT_PRECISION,
+            fit[LOGGP_RTT].slope > 0 ? 1.0 / fit[LOGGP_RTT].slope : 0.0,
+            FLOAT_PRECISION, fit[LOGGP_RTT].residual);
+    fprintf(stdout,
+            "#   LogGP:   L = %.*f us, o_s = %.*f us (+%.*f ns/byte, residual"
+            " %.*f%%),\n",
+            FLOAT_PRECISION, MAX(latency, 0.0), FLOAT_PRECISION,
+            fit[LOGGP_OS].intercept, FLOAT_PRECISION + 2,
+            fit[LOGGP_OS].slope * 1e3, FLOAT_PRECISION,
+            fit[LOGGP_OS].residual);
+    fprintf(stdout,
+            "#            o_r = %.*f us (+%.*f ns/byte, residual %.*f%%),\n",
+            FLOAT_PRECISION, fit[LOGGP_OR].intercept, FLOAT_PRECISION + 2,
+            fit[LOGGP_OR].slope * 1e3, FLOAT_PRECISION,
+            fit[LOGGP_OR].residual);
+    fprintf(stdout,
+            "#            g = %.*f us, G = %.*f ns/byte (%.*f MB/s),"
+            " residual %.*f%%\n",
+            FLOAT_PRECISION, fit[LOGGP_GAP].intercept, FLOAT_PRECISION + 2,
+            fit[LOGGP_GAP].slope * 1e3, FLOAT_PRECISION,
+            fit[LOGGP_GAP].slope > 0 ? 1.0 / fit[LOGGP_GAP].slope : 0.0,
+            FLOAT_PRECISION, fit[LOGGP_GAP].residual);
+    if (latency < 0.0) {
+        fprintf(stdout,
+                "#   Note: o_s + o_r exceed alpha by %.*f us, L is clamped"
+                " to 0\n",
+                FLOAT_PRECISION, -latency);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, param = 0, count = 0, split = 0;
+    int po_ret = PO_OKAY;
+    size_t size = 0;
+    double rtt = 0.0, train = 0.0, single = 0.0;
+    double sizes[LOGGP_MAX_SIZES];
+    double params[LOGGP_NUM_PARAMS][LOGGP_MAX_SIZES];
+    double local[LOGGP_NUM_PARAMS];
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = LOGGP;
+    set_header(HEADER);
+    set_benchmark_name("osu_loggp");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != numprocs) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    if (options.window_size < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "The message train needs a window size of at"
+                            " least 2\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    CHECK(posix_memalign((void **)&s_buf, getpagesize(),
+                         options.max_message_size));
+    CHECK(posix_memalign((void **)&r_buf, getpagesize(),
+                         options.max_message_size));
+    memset(s_buf, 'a', options.max_message_size);
+    memset(r_buf, 'b', options.max_message_size);
+    requests = malloc(options.window_size * sizeof(MPI_Request));
+    OMB_CHECK_NULL_AND_EXIT(requests, "Unable to allocate memory");
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Message train length: %d\n", options.window_size);
+        fprintf(stdout, "%-*s", 10, "# Size");
+        for (param = 0; param < LOGGP_NUM_PARAMS; param++) {
+            fprintf(stdout, "%*s", FIELD_WIDTH, loggp_param_names[param]);
+        }
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+
+    for (size = MAX(options.min_message_size, 1);
+         size <= options.max_message_size && count < LOGGP_MAX_SIZES;
+         size *= 2) {
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        rtt = measure_rtt(rank, size);
+        local[LOGGP_RTT] = (0 == rank) ? rtt : 0.0;
+        measure_overheads(rank, size, 2 * rtt, &local[LOGGP_OS],
+                          &local[LOGGP_OR]);
+        single = measure_train(rank, size, 1);
+        train = measure_train(rank, size, options.window_size);
+        local[LOGGP_GAP] =
+            (0 == rank) ? (train - single) / (options.window_size - 1) : 0.0;
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, local, LOGGP_NUM_PARAMS,
+                                MPI_DOUBLE, MPI_SUM, omb_comm));
+
+        sizes[count] = size;
+        for (param = 0; param < LOGGP_NUM_PARAMS; param++) {
+            /* keep the relative error fit defined for vanishing values */
+            params[param][count] = MAX(local[param] * 1e6, 1e-3);
+        }
+        if (0 == rank) {
+            fprintf(stdout, "%-*zu", 10, size);
+            for (param = 0; param < LOGGP_NUM_PARAMS; param++) {
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        params[param][count]);
+            }
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+        count++;
+    }
+
+    if (0 == rank && count >= 2) {
+        split = find_protocol_switch(sizes, params[LOGGP_RTT], count);
+        fprintf(stdout, "\n");
+        if (split < count) {
+            fprintf(stdout, "# Protocol switch detected at %zu bytes\n",
+                    (size_t)sizes[split]);
+            print_fits("Eager", sizes, params, 0, split);
+            print_fits("Rendezvous", sizes, params, split, count);
+        } else {
+            fprintf(stdout, "# No protocol switch detected\n");
+            print_fits("Full", sizes, params, 0, count);
+        }
+        fflush(stdout);
+    }
+
+    free(requests);
+    free(s_buf);
+    free(r_buf);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
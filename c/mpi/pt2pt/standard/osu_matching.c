@@ -0,0 +1,396 @@
+#define BENCHMARK "OSU MPI%s Message Matching Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+#define MATCHING_RECEIVER 0
+#define MATCHING_SENDER   1
+#define MATCHING_SEED     42
+
+enum matching_comms_t { MATCHING_PLAIN, MATCHING_HINTS, MATCHING_NUM_COMMS };
+
+static const char *match_pattern_names[] = {"exact", "any_tag", "any_source",
+                                            "random"};
+static const char *match_position_names[] = {"last", "random"};
+
+MPI_Comm omb_comm = MPI_COMM_NULL, ctrl_comm = MPI_COMM_NULL;
+MPI_Request *requests = NULL;
+int *tags = NULL, *queue_log = NULL;
+char *pending = NULL;
+int wildcard_tag = 0;
+
+static int is_wildcard_pattern(void)
+{
+    return OMB_MATCH_ANY_TAG == options.match_pattern ||
+           OMB_MATCH_ANY_SOURCE == options.match_pattern;
+}
+
+/*
+ * Fills tags with depth distinct tags below wildcard_tag. Random tags are
+ * spread over the whole tag space and shuffled, so neither their values nor
+ * their posting order follow a pattern.
+ */
+static void init_tags(int depth)
+{
+    int i = 0, j = 0, tmp = 0, stride = 0;
+    unsigned int seed = MATCHING_SEED;
+
+    if (OMB_MATCH_RANDOM_TAG != options.match_pattern) {
+        for (i = 0; i < depth; i++) {
+            tags[i] = i;
+        }
+        return;
+    }
+    stride = wildcard_tag / depth;
+    for (i = 0; i < depth; i++) {
+        tags[i] = i * stride + rand_r(&seed) % stride;
+    }
+    for (i = depth - 1; i > 0; i--) {
+        j = rand_r(&seed) % (i + 1);
+        tmp = tags[i];
+        tags[i] = tags[j];
+        tags[j] = tmp;
+    }
+}
+
+/*
+ * In the posted receive queue of the wildcard patterns the last entry is the
+ * wildcard receive, matched by messages carrying wildcard_tag; all other
+ * entries are exact receives that never match.
+ */
+static int posted_message_tag(int index, int depth)
+{
+    return (is_wildcard_pattern() && depth - 1 == index) ? wildcard_tag :
+                                                           tags[index];
+}
+
+static void post_receive(MPI_Comm comm, int index, int depth)
+{
+    int source = MATCHING_SENDER, tag = tags[index];
+
+    if (is_wildcard_pattern() && depth - 1 == index) {
+        if (OMB_MATCH_ANY_TAG == options.match_pattern) {
+            tag = MPI_ANY_TAG;
+        } else {
+            source = MPI_ANY_SOURCE;
+            tag = wildcard_tag;
+        }
+    }
+    MPI_CHECK(MPI_Irecv(NULL, 0, MPI_CHAR, source, tag, comm,
+                        &requests[index]));
+}
+
+/*
+ * A matched posted receive is reposted at the tail of the queue, so the last
+ * entry stays last and a random entry is on average in the middle.
+ */
+static int select_posted_entry(int index, int depth, unsigned int *seed)
+{
+    if (is_wildcard_pattern()) {
+        return depth - 1;
+    }
+    if (OMB_MATCH_RANDOM == options.match_position) {
+        return rand_r(seed) % depth;
+    }
+    return index;
+}
+
+/*
+ * Half round trip of a zero byte message matched in a posted receive queue
+ * of the given depth, in us. The acknowledgement travels on a communicator
+ * with empty queues.
+ */
+static double run_posted(MPI_Comm comm, int rank, int depth)
+{
+    int i = 0, index = depth - 1, ack = 0;
+    unsigned int seed = MATCHING_SEED;
+    double t_start = 0.0, timer = 0.0, latency = 0.0, sum = 0.0;
+
+    if (MATCHING_RECEIVER == rank) {
+        for (i = 0; i < depth; i++) {
+            post_receive(comm, i, depth);
+        }
+    }
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        index = select_posted_entry(index, depth, &seed);
+        if (MATCHING_SENDER == rank) {
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Send(NULL, 0, MPI_CHAR, MATCHING_RECEIVER,
+                               posted_message_tag(index, depth), comm));
+            MPI_CHECK(MPI_Recv(&ack, 1, MPI_INT, MATCHING_RECEIVER, 1,
+                               ctrl_comm, MPI_STATUS_IGNORE));
+            if (i >= options.skip) {
+                timer += MPI_Wtime() - t_start;
+            }
+        } else {
+            MPI_CHECK(MPI_Wait(&requests[index], MPI_STATUS_IGNORE));
+            post_receive(comm, index, depth);
+            MPI_CHECK(MPI_Send(&ack, 1, MPI_INT, MATCHING_SENDER, 1,
+                               ctrl_comm));
+        }
+    }
+    if (MATCHING_RECEIVER == rank) {
+        for (i = 0; i < depth; i++) {
+            MPI_CHECK(MPI_Cancel(&requests[i]));
+        }
+        MPI_CHECK(MPI_Waitall(depth, requests, MPI_STATUSES_IGNORE));
+    }
+    MPI_CHECK(MPI_Barrier(omb_comm));
+
+    latency = timer * 1e6 / (2.0 * options.iterations);
+    MPI_CHECK(MPI_Reduce(&latency, &sum, 1, MPI_DOUBLE, MPI_SUM,
+                         MATCHING_RECEIVER, omb_comm));
+    return sum;
+}
+
+/*
+ * Receives the unexpected messages that are still queued. queue_log holds
+ * the indices of all messages in the order they were sent; only the last
+ * occurrence of an index is still queued, so receiving those in order always
+ * matches the head of the queue.
+ */
+static void drain_unexpected(MPI_Comm comm, int num_logged, int depth)
+{
+    int i = 0;
+
+    memset(pending, 0, depth);
+    for (i = num_logged - 1; i >= 0; i--) {
+        if (pending[queue_log[i]]) {
+            queue_log[i] = -1;
+        } else {
+            pending[queue_log[i]] = 1;
+        }
+    }
+    for (i = 0; i < num_logged; i++) {
+        if (-1 != queue_log[i]) {
+            MPI_CHECK(MPI_Recv(NULL, 0, MPI_CHAR, MATCHING_SENDER,
+                               tags[queue_log[i]], comm, MPI_STATUS_IGNORE));
+        }
+    }
+}
+
+/*
+ * Time of the MPI_Recv that matches an entry of an unexpected message queue
+ * of the given depth, in us. The matched message is sent again afterwards
+ * and probed for outside of the timed region, so it is queued at the tail
+ * before the next receive. An MPI_ANY_TAG receive matches the head of the
+ * queue.
+ */
+static double run_unexpected(MPI_Comm comm, int rank, int depth)
+{
+    int i = 0, index = depth - 1, num_logged = 0;
+    int source = MATCHING_SENDER, tag = 0;
+    unsigned int seed = MATCHING_SEED;
+    double t_start = 0.0, timer = 0.0, latency = 0.0, sum = 0.0;
+    MPI_Status status;
+
+    if (MATCHING_SENDER == rank) {
+        for (i = 0; i < depth; i++) {
+            MPI_CHECK(MPI_Send(NULL, 0, MPI_CHAR, MATCHING_RECEIVER, tags[i],
+                               comm));
+        }
+    } else {
+        for (i = 0; i < depth; i++) {
+            queue_log[num_logged++] = i;
+        }
+        MPI_CHECK(MPI_Probe(MATCHING_SENDER, tags[depth - 1], comm,
+                            MPI_STATUS_IGNORE));
+    }
+    if (OMB_MATCH_ANY_SOURCE == options.match_pattern) {
+        source = MPI_ANY_SOURCE;
+    }
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (MATCHING_RECEIVER == rank) {
+            if (OMB_MATCH_RANDOM == options.match_position) {
+                index = rand_r(&seed) % depth;
+            }
+            tag = (OMB_MATCH_ANY_TAG == options.match_pattern) ? MPI_ANY_TAG :
+                                                                 tags[index];
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Recv(NULL, 0, MPI_CHAR, source, tag, comm, &status));
+            if (i >= options.skip) {
+                timer += MPI_Wtime() - t_start;
+            }
+            /* sequential tags are their own index */
+            if (OMB_MATCH_ANY_TAG == options.match_pattern) {
+                index = status.MPI_TAG;
+            }
+            queue_log[num_logged++] = index;
+            MPI_CHECK(MPI_Send(&index, 1, MPI_INT, MATCHING_SENDER, 1,
+                               ctrl_comm));
+            MPI_CHECK(MPI_Probe(MATCHING_SENDER, tags[index], comm,
+                                MPI_STATUS_IGNORE));
+        } else {
+            MPI_CHECK(MPI_Recv(&index, 1, MPI_INT, MATCHING_RECEIVER, 1,
+                               ctrl_comm, MPI_STATUS_IGNORE));
+            MPI_CHECK(MPI_Send(NULL, 0, MPI_CHAR, MATCHING_RECEIVER,
+                               tags[index], comm));
+        }
+    }
+    if (MATCHING_RECEIVER == rank) {
+        drain_unexpected(comm, num_logged, depth);
+    }
+    MPI_CHECK(MPI_Barrier(omb_comm));
+
+    latency = timer * 1e6 / options.iterations;
+    MPI_CHECK(MPI_Reduce(&latency, &sum, 1, MPI_DOUBLE, MPI_SUM,
+                         MATCHING_RECEIVER, omb_comm));
+    return sum;
+}
+
+/*
+ * Duplicates omb_comm with every matching assertion the selected pattern
+ * allows. Libraries that do not know the hints ignore them.
+ */
+static void create_hints_comm(MPI_Comm *comm, char *hints, size_t length)
+{
+    MPI_Info info;
+
+    hints[0] = '\0';
+    MPI_CHECK(MPI_Info_create(&info));
+    if (OMB_MATCH_ANY_SOURCE != options.match_pattern) {
+        MPI_CHECK(MPI_Info_set(info, "mpi_assert_no_any_source", "true"));
+        strncat(hints, " mpi_assert_no_any_source", length - strlen(hints));
+    }
+    if (OMB_MATCH_ANY_TAG != options.match_pattern) {
+        MPI_CHECK(MPI_Info_set(info, "mpi_assert_no_any_tag", "true"));
+        strncat(hints, " mpi_assert_no_any_tag", length - strlen(hints));
+    }
+    MPI_CHECK(MPI_Info_set(info, "mpi_assert_allow_overtaking", "true"));
+    strncat(hints, " mpi_assert_allow_overtaking", length - strlen(hints));
+    MPI_CHECK(MPI_Comm_dup_with_info(omb_comm, info, comm));
+    MPI_CHECK(MPI_Info_free(&info));
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, flag = 0, depth = 0, kind = 0;
+    int po_ret = PO_OKAY;
+    int *tag_ub = NULL;
+    size_t log_length = 0;
+    double posted[MATCHING_NUM_COMMS], unexpected[MATCHING_NUM_COMMS];
+    char hints[OMB_FILE_PATH_MAX_LENGTH];
+    MPI_Comm comms[MATCHING_NUM_COMMS];
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = MATCHING;
+    set_header(HEADER);
+    set_benchmark_name("osu_matching");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != numprocs) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    MPI_CHECK(MPI_Comm_get_attr(omb_comm, MPI_TAG_UB, &tag_ub, &flag));
+    wildcard_tag = flag ? *tag_ub : 32767;
+    if (options.min_message_size < 1 ||
+        options.max_message_size >= (size_t)wildcard_tag) {
+        if (0 == rank) {
+            fprintf(stderr, "The queue depth must be between 1 and %d\n",
+                    wildcard_tag - 1);
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    log_length = options.max_message_size + options.iterations +
+                 MAX(options.skip, options.skip_large);
+    requests = malloc(options.max_message_size * sizeof(MPI_Request));
+    tags = malloc(options.max_message_size * sizeof(int));
+    queue_log = malloc(log_length * sizeof(int));
+    pending = malloc(options.max_message_size);
+    OMB_CHECK_NULL_AND_EXIT(requests, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(tags, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(queue_log, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(pending, "Unable to allocate memory");
+    MPI_CHECK(MPI_Comm_dup(omb_comm, &ctrl_comm));
+    MPI_CHECK(MPI_Comm_dup(omb_comm, &comms[MATCHING_PLAIN]));
+    create_hints_comm(&comms[MATCHING_HINTS], hints, sizeof(hints));
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Pattern: %s, matched entry: %s\n",
+                match_pattern_names[options.match_pattern],
+                is_wildcard_pattern() ?
+                    "wildcard receive" :
+                    match_position_names[options.match_position]);
+        fprintf(stdout, "# Hints:%s\n", hints);
+        fprintf(stdout, "# Posted = half round trip, Unexpected = MPI_Recv"
+                        " time\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s\n", 10, "# Depth", FIELD_WIDTH,
+                "Posted(us)", FIELD_WIDTH, "Unexpected(us)", FIELD_WIDTH,
+                "Posted Hints(us)", FIELD_WIDTH, "Unexp. Hints(us)");
+        fflush(stdout);
+    }
+
+    for (depth = options.min_message_size; depth <= (int)options.max_message_size;
+         depth *= 2) {
+        if (depth > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        init_tags(depth);
+        for (kind = 0; kind < MATCHING_NUM_COMMS; kind++) {
+            posted[kind] = run_posted(comms[kind], rank, depth);
+            unexpected[kind] = run_unexpected(comms[kind], rank, depth);
+        }
+        if (0 == rank) {
+            fprintf(stdout, "%-*d", 10, depth);
+            for (kind = 0; kind < MATCHING_NUM_COMMS; kind++) {
+                fprintf(stdout, "%*.*f%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        posted[kind], FIELD_WIDTH, FLOAT_PRECISION,
+                        unexpected[kind]);
+            }
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+
+    for (kind = 0; kind < MATCHING_NUM_COMMS; kind++) {
+        MPI_CHECK(MPI_Comm_free(&comms[kind]));
+    }
+    MPI_CHECK(MPI_Comm_free(&ctrl_comm));
+    free(requests);
+    free(tags);
+    free(queue_log);
+    free(pending);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -35,6 +35,7 @@ MPI_Comm omb_comm = MPI_COMM_NULL;
 omb_mpi_init_data omb_init_h;
 double *omb_lat_arr = NULL;
 struct omb_stat_t omb_stat;
+double bw_contended = 0.0;
 
 int main(int argc, char *argv[])
 {
@@ -52,6 +53,7 @@ int main(int argc, char *argv[])
     int mpi_type_name_length = 0;
     char mpi_type_name_str[OMB_DATATYPE_STR_MAX_LEN];
     options.subtype = BW;
+    options.contention = 1;
 
     int po_ret = process_options(argc, argv);
     omb_populate_mpi_type_list(mpi_type_list);
@@ -165,6 +167,11 @@ int main(int argc, char *argv[])
         else {
             fprintf(stdout, "# [ pairs: %d ] [ window size: %d ]\n",
                     options.pairs, options.window_size);
+            if (options.contention_threads) {
+                fprintf(stdout, "# Memory contention: %d streaming threads"
+                                " per process, %zu MB per array\n",
+                        options.contention_threads, options.contention_mb);
+            }
         }
 
         fflush(stdout);
@@ -208,6 +215,9 @@ int main(int argc, char *argv[])
                 if (options.omb_enable_ddt) {
                     fprintf(stdout, "%*s", FIELD_WIDTH, "Transmit Size");
                 }
+                if (options.contention_threads) {
+                    fprintf(stdout, "%*s", FIELD_WIDTH, "Contended (MB/s)");
+                }
                 fprintf(stdout, "\n");
             }
         }
@@ -389,6 +399,10 @@ int main(int argc, char *argv[])
                         fprintf(stdout, "%*zu", FIELD_WIDTH,
                                 omb_ddt_transmit_size);
                     }
+                    if (options.contention_threads) {
+                        fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                                bw_contended);
+                    }
                     fprintf(stdout, "\n");
                 }
 
@@ -646,6 +660,12 @@ double calc_bw(int rank, int size, int num_pairs, int window_size, char **s_buf,
     }
     omb_stat = omb_calculate_tail_lat(omb_lat_arr, rank, 1);
     omb_papi_stop_and_print(&papi_eventset, size);
+    if (options.contention_threads) {
+        bw_contended = omb_contended_bw(
+            omb_comm, num_pairs, 0, s_buf[0], r_buf[0], num_elements,
+            omb_curr_datatype,
+            options.omb_enable_ddt ? omb_ddt_transmit_size : size);
+    }
     if (options.buf_num == MULTIPLE) {
         for (i = 0; i < window_size; i++) {
             free_memory_pt2pt_mul(s_buf[i], r_buf[i], rank, num_pairs);
@@ -0,0 +1,247 @@
+#define BENCHMARK "OSU MPI%s Multi-threaded Message Rate Test"
+/*
+ * Copyright (c) 2002-2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#include <osu_util_mpi.h>
+
+#define MT_MR_TAG 100
+
+/*
+ * How the threads reach MPI: all through one communicator, each through its
+ * own duplicate, or each through a duplicate carrying the MPI 4 assertions
+ * that let a library map it to an independent channel.
+ */
+enum mt_mr_modes_t { MT_MR_SHARED, MT_MR_DUP, MT_MR_HINTS, MT_MR_NUM_MODES };
+
+typedef struct thread_tag {
+    int id;
+    MPI_Comm comm;
+} thread_tag_t;
+
+pthread_barrier_t thread_barrier;
+
+int rank = 0, partner = 0, is_sender = 0, size = 0, num_threads = 0;
+int window_size = 0, iterations = 0, skip = 0;
+double t_start = 0.0, t_end = 0.0;
+
+/*
+ * Sets the timer of the rank at thread 0 once all threads of both ranks are
+ * ready, so thread creation and warmup stay out of the measurement.
+ */
+static void sync_threads(int id, double *t)
+{
+    pthread_barrier_wait(&thread_barrier);
+    if (0 == id) {
+        MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+        *t = MPI_Wtime();
+    }
+    pthread_barrier_wait(&thread_barrier);
+}
+
+/* The windowed loop of osu_mbw_mr, one window and ack per iteration. */
+void *rate_thread(void *arg)
+{
+    thread_tag_t *tag = (thread_tag_t *)arg;
+    int i = 0, j = 0, tag_id = MT_MR_TAG + tag->id;
+    char *s_buf = NULL, *r_buf = NULL;
+    MPI_Request *req = NULL;
+
+    omb_affinity_bind_thread(tag->id);
+    s_buf = malloc(MAX(size, 1));
+    r_buf = malloc(MAX(size, 1));
+    req = malloc(sizeof(MPI_Request) * window_size);
+    OMB_CHECK_NULL_AND_EXIT(s_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(r_buf, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(req, "Unable to allocate memory");
+    memset(s_buf, 'a', MAX(size, 1));
+    memset(r_buf, 'b', MAX(size, 1));
+
+    for (i = 0; i < skip + iterations; i++) {
+        if (i == skip) {
+            sync_threads(tag->id, &t_start);
+        }
+        if (is_sender) {
+            for (j = 0; j < window_size; j++) {
+                MPI_CHECK(MPI_Isend(s_buf, size, MPI_CHAR, partner, tag_id,
+                                    tag->comm, &req[j]));
+            }
+            MPI_CHECK(MPI_Waitall(window_size, req, MPI_STATUSES_IGNORE));
+            MPI_CHECK(MPI_Recv(r_buf, 1, MPI_CHAR, partner, tag_id, tag->comm,
+                               MPI_STATUS_IGNORE));
+        } else {
+            for (j = 0; j < window_size; j++) {
+                MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, partner, tag_id,
+                                    tag->comm, &req[j]));
+            }
+            MPI_CHECK(MPI_Waitall(window_size, req, MPI_STATUSES_IGNORE));
+            MPI_CHECK(MPI_Send(s_buf, 1, MPI_CHAR, partner, tag_id, tag->comm));
+        }
+    }
+    sync_threads(tag->id, &t_end);
+
+    free(s_buf);
+    free(r_buf);
+    free(req);
+    return NULL;
+}
+
+/* Powers of two up to max, then max itself. */
+static int next_threads(int n, int max)
+{
+    return n == max ? max + 1 : MIN(2 * n, max);
+}
+
+/* Messages per second of all pairs and threads, valid at rank 0. */
+static double run_mode(int mode, int num_pairs, MPI_Info hints)
+{
+    int i = 0;
+    double t = 0.0, t_max = 0.0;
+    pthread_t threads[MAX_NUM_THREADS];
+    thread_tag_t tags[MAX_NUM_THREADS];
+
+    for (i = 0; i < num_threads; i++) {
+        tags[i].id = i;
+        tags[i].comm = MPI_COMM_WORLD;
+        if (MT_MR_DUP == mode) {
+            MPI_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, &tags[i].comm));
+        } else if (MT_MR_HINTS == mode) {
+            MPI_CHECK(
+                MPI_Comm_dup_with_info(MPI_COMM_WORLD, hints, &tags[i].comm));
+        }
+    }
+    pthread_barrier_init(&thread_barrier, NULL, num_threads);
+    for (i = 0; i < num_threads; i++) {
+        pthread_create(&threads[i], NULL, rate_thread, &tags[i]);
+    }
+    for (i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&thread_barrier);
+    for (i = 0; i < num_threads; i++) {
+        if (MPI_COMM_WORLD != tags[i].comm) {
+            MPI_CHECK(MPI_Comm_free(&tags[i].comm));
+        }
+    }
+
+    t = is_sender ? t_end - t_start : 0.0;
+    MPI_CHECK(
+        MPI_Reduce(&t, &t_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD));
+    return (double)num_pairs * num_threads * window_size * iterations / t_max;
+}
+
+int main(int argc, char *argv[])
+{
+    int numprocs = 0, provided = 0, po_ret = PO_OKAY, mode = 0;
+    int num_pairs = 0, max_threads = 0;
+    double rate[MT_MR_NUM_MODES];
+    MPI_Info hints = MPI_INFO_NULL;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = MT_MBW_MR;
+    set_header(HEADER);
+    set_benchmark_name("osu_mt_mbw_mr");
+    po_ret = process_options(argc, argv);
+
+    MPI_CHECK(MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided));
+    omb_init_h.omb_comm = MPI_COMM_WORLD;
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (provided != MPI_THREAD_MULTIPLE) {
+        if (0 == rank) {
+            fprintf(stderr,
+                    "MPI_Init_thread must return MPI_THREAD_MULTIPLE!\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    if (numprocs < 2 || numprocs % 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires an even number of processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    /* rank r sends to rank r + numprocs / 2, as in osu_mbw_mr */
+    num_pairs = numprocs / 2;
+    is_sender = rank < num_pairs;
+    partner = is_sender ? rank + num_pairs : rank - num_pairs;
+    window_size = options.window_size;
+    max_threads = options.num_threads;
+    MPI_CHECK(MPI_Info_create(&hints));
+    MPI_CHECK(MPI_Info_set(hints, "mpi_assert_no_any_source", "true"));
+    MPI_CHECK(MPI_Info_set(hints, "mpi_assert_no_any_tag", "true"));
+    MPI_CHECK(MPI_Info_set(hints, "mpi_assert_allow_overtaking", "true"));
+
+    omb_affinity_init(MPI_COMM_WORLD);
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# [ pairs: %d ] [ window size: %d ]\n", num_pairs,
+                window_size);
+        fprintf(stdout, "# Shared: all threads use one communicator, one tag"
+                        " per thread\n");
+        fprintf(stdout, "# Dup: one duplicated communicator per thread\n");
+        fprintf(stdout, "# Hints: Dup with the no_any_source, no_any_tag and"
+                        " allow_overtaking assertions\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Threads", FIELD_WIDTH, "Shared (msg/s)", FIELD_WIDTH,
+                "Dup (msg/s)", FIELD_WIDTH, "Hints (msg/s)");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size = (size ? size * 2 : 1)) {
+        iterations = options.iterations;
+        skip = options.skip;
+        if (size > LARGE_MESSAGE_SIZE) {
+            iterations = options.iterations_large;
+            skip = options.skip_large;
+        }
+        for (num_threads = 1; num_threads <= max_threads;
+             num_threads = next_threads(num_threads, max_threads)) {
+            for (mode = 0; mode < MT_MR_NUM_MODES; mode++) {
+                rate[mode] = run_mode(mode, num_pairs, hints);
+            }
+            if (0 == rank) {
+                fprintf(stdout, "%-*d%*d", 10, size, FIELD_WIDTH,
+                        num_threads);
+                for (mode = 0; mode < MT_MR_NUM_MODES; mode++) {
+                    fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                            rate[mode]);
+                }
+                fprintf(stdout, "\n");
+                fflush(stdout);
+            }
+        }
+    }
+
+    MPI_CHECK(MPI_Info_free(&hints));
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
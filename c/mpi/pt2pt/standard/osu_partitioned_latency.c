@@ -128,6 +128,7 @@ int main(int argc, char *argv[])
         omb_mpi_finalize(omb_init_h);
         exit(EXIT_FAILURE);
     }
+    omb_affinity_init(omb_comm);
 
     if (options.buf_num == SINGLE) {
         if (allocate_memory_pt2pt(&s_buf, &r_buf, myid)) {
@@ -0,0 +1,263 @@
+#define BENCHMARK "OSU MPI%s Point-to-Point Overlap Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+enum overlap_modes_t {
+    OVERLAP_NO_TEST,
+    OVERLAP_TEST,
+    OVERLAP_THREAD,
+    OVERLAP_NUM_MODES
+};
+
+static const char *overlap_mode_names[OVERLAP_NUM_MODES] = {
+    "No Test(%)", "MPI_Test(%)", "Thread(%)"};
+
+MPI_Comm omb_comm = MPI_COMM_NULL, progress_comm = MPI_COMM_NULL;
+char *s_buf = NULL, *r_buf = NULL;
+int progress_active = 0, num_probes = 0;
+
+/*
+ * Drives the progress engine of the library without touching the request
+ * owned by the main thread.
+ */
+static void *progress_loop(void *arg)
+{
+    int flag = 0;
+
+    omb_affinity_bind_thread(1);
+    while (__atomic_load_n(&progress_active, __ATOMIC_ACQUIRE)) {
+        MPI_CHECK(MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, progress_comm, &flag,
+                             MPI_STATUS_IGNORE));
+    }
+    return NULL;
+}
+
+static void post(int rank, size_t size, MPI_Request *request)
+{
+    if (0 == rank) {
+        MPI_CHECK(MPI_Isend(s_buf, size, MPI_CHAR, 1, 1, omb_comm, request));
+    } else {
+        MPI_CHECK(MPI_Irecv(r_buf, size, MPI_CHAR, 0, 1, omb_comm, request));
+    }
+}
+
+/* Time from posting to completion without computation, in seconds. */
+static double run_pure(int rank, size_t size)
+{
+    int i = 0;
+    double t_start = 0.0, timer = 0.0;
+    MPI_Request request;
+
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        MPI_CHECK(MPI_Barrier(omb_comm));
+        t_start = MPI_Wtime();
+        post(rank, size, &request);
+        MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+        if (i >= options.skip) {
+            timer += MPI_Wtime() - t_start;
+        }
+    }
+    return timer / options.iterations;
+}
+
+/*
+ * Both ranks post, compute for the pure communication time and wait. The
+ * overlap follows the non-blocking collective benchmarks: MPI_Test time is
+ * counted as overhead, not as computation. Returns the average of both ranks.
+ */
+static double run_overlap(int rank, size_t size, int mode, double pure)
+{
+    int i = 0;
+    double t_start = 0.0, t_comp = 0.0, test_time = 0.0;
+    double overall = 0.0, compute = 0.0, overlap = 0.0, sum = 0.0;
+    MPI_Request request;
+    pthread_t thread;
+
+    options.num_probes = (OVERLAP_TEST == mode) ? num_probes : 0;
+    if (OVERLAP_THREAD == mode) {
+        __atomic_store_n(&progress_active, 1, __ATOMIC_RELEASE);
+        if (pthread_create(&thread, NULL, progress_loop, NULL)) {
+            OMB_ERROR_EXIT("Unable to create progress thread");
+        }
+    }
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        MPI_CHECK(MPI_Barrier(omb_comm));
+        t_start = MPI_Wtime();
+        post(rank, size, &request);
+        t_comp = MPI_Wtime();
+        test_time = dummy_compute(pure, &request);
+        t_comp = MPI_Wtime() - t_comp;
+        MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+        if (i >= options.skip) {
+            overall += MPI_Wtime() - t_start;
+            compute += t_comp - test_time;
+        }
+    }
+    if (OVERLAP_THREAD == mode) {
+        __atomic_store_n(&progress_active, 0, __ATOMIC_RELEASE);
+        pthread_join(thread, NULL);
+    }
+    options.num_probes = num_probes;
+
+    overall /= options.iterations;
+    compute /= options.iterations;
+    overlap = MAX(0, 100 - ((overall - compute) / pure) * 100);
+    MPI_CHECK(
+        MPI_Reduce(&overlap, &sum, 1, MPI_DOUBLE, MPI_SUM, 0, omb_comm));
+    return sum / 2;
+}
+
+/*
+ * The receiver computes for the pure communication time before posting its
+ * receive while the sender computes twice as long after its MPI_Isend without
+ * entering the library. Returns the time the sender then spends in MPI_Wait,
+ * in us: close to zero for eager messages or asynchronous rendezvous
+ * progress, close to the transfer time otherwise.
+ */
+static double run_receiver_late(int rank, size_t size, double pure)
+{
+    int i = 0;
+    double t_wait = 0.0, wait_total = 0.0;
+    MPI_Request request = MPI_REQUEST_NULL;
+
+    options.num_probes = 0;
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        MPI_CHECK(MPI_Barrier(omb_comm));
+        if (0 == rank) {
+            post(rank, size, &request);
+            dummy_compute(2 * pure, &request);
+            t_wait = MPI_Wtime();
+            MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+            t_wait = MPI_Wtime() - t_wait;
+        } else {
+            dummy_compute(pure, &request);
+            post(rank, size, &request);
+            MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+        }
+        if (i >= options.skip) {
+            wait_total += t_wait;
+        }
+    }
+    options.num_probes = num_probes;
+    return wait_total * 1e6 / options.iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, provided = 0, mode = 0, num_modes = 0;
+    int po_ret = PO_OKAY;
+    size_t size = 0;
+    double pure = 0.0, late_wait = 0.0;
+    double overlap[OVERLAP_NUM_MODES];
+
+    options.bench = PT2PT;
+    options.subtype = PT2PT_OVERLAP;
+    set_header(HEADER);
+    set_benchmark_name("osu_pt2pt_overlap");
+    po_ret = process_options(argc, argv);
+    MPI_CHECK(MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided));
+    omb_comm = MPI_COMM_WORLD;
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            MPI_CHECK(MPI_Finalize());
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            MPI_CHECK(MPI_Finalize());
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            MPI_CHECK(MPI_Finalize());
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != numprocs) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes\n");
+        }
+        MPI_CHECK(MPI_Finalize());
+        exit(EXIT_FAILURE);
+    }
+
+    num_probes = options.num_probes;
+    num_modes = (MPI_THREAD_MULTIPLE == provided) ? OVERLAP_NUM_MODES :
+                                                    OVERLAP_THREAD;
+    MPI_CHECK(MPI_Comm_dup(omb_comm, &progress_comm));
+    CHECK(posix_memalign((void **)&s_buf, getpagesize(),
+                         MAX(options.max_message_size, 1)));
+    CHECK(posix_memalign((void **)&r_buf, getpagesize(),
+                         MAX(options.max_message_size, 1)));
+    memset(s_buf, 'a', options.max_message_size);
+    memset(r_buf, 'b', options.max_message_size);
+    allocate_host_arrays();
+
+    omb_affinity_init(omb_comm);
+    omb_affinity_bind_thread(0);
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# MPI_Test calls during computation: %d\n",
+                num_probes);
+        if (OVERLAP_NUM_MODES != num_modes) {
+            fprintf(stdout, "# MPI_THREAD_MULTIPLE not provided, progress"
+                            " thread skipped\n");
+        }
+        fprintf(stdout, "# Late Wait = sender MPI_Wait time when the receive"
+                        " is posted late\n");
+        fprintf(stdout, "%-*s%*s", 10, "# Size", FIELD_WIDTH,
+                "Pure Comm.(us)");
+        for (mode = 0; mode < num_modes; mode++) {
+            fprintf(stdout, "%*s", FIELD_WIDTH, overlap_mode_names[mode]);
+        }
+        fprintf(stdout, "%*s\n", FIELD_WIDTH, "Late Wait(us)");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size = (size ? size * 2 : 1)) {
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        /* both ranks compute for the same, averaged, time */
+        pure = run_pure(rank, size);
+        MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &pure, 1, MPI_DOUBLE, MPI_SUM,
+                                omb_comm));
+        pure /= 2;
+        init_arrays(pure);
+        for (mode = 0; mode < num_modes; mode++) {
+            overlap[mode] = run_overlap(rank, size, mode, pure);
+        }
+        late_wait = run_receiver_late(rank, size, pure);
+        if (0 == rank) {
+            fprintf(stdout, "%-*zu%*.*f", 10, size, FIELD_WIDTH,
+                    FLOAT_PRECISION, pure * 1e6);
+            for (mode = 0; mode < num_modes; mode++) {
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        overlap[mode]);
+            }
+            fprintf(stdout, "%*.*f\n", FIELD_WIDTH, FLOAT_PRECISION,
+                    late_wait);
+            fflush(stdout);
+        }
+    }
+
+    MPI_CHECK(MPI_Comm_free(&progress_comm));
+    free(s_buf);
+    free(r_buf);
+    MPI_CHECK(MPI_Finalize());
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,210 @@
+#define BENCHMARK "OSU MPI%s Shared Memory Baseline Bandwidth Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_shm.h>
+
+enum shm_bw_methods_t {
+    SHM_BW_MPI,
+    SHM_BW_DIRECT,
+    SHM_BW_DIRECT_NT,
+    SHM_BW_RING,
+    SHM_BW_RING_NT,
+    SHM_BW_NUM_METHODS
+};
+
+static const char *shm_bw_names[SHM_BW_NUM_METHODS] = {
+    "MPI(MB/s)", "1-copy(MB/s)", "1-copy NT(MB/s)", "2-copy(MB/s)",
+    "2-copy NT(MB/s)"};
+
+omb_shm_channel_t channel;
+MPI_Comm omb_comm = MPI_COMM_NULL;
+MPI_Request *requests = NULL;
+char *sbuf = NULL, *rbuf = NULL;
+
+/*
+ * Rank 0 sends window_size messages per iteration and rank 1 acknowledges
+ * every iteration, as in osu_bw. Direct copies all land in the same receive
+ * buffer, like the MPI receives.
+ */
+static double run_method(int rank, int method, size_t size)
+{
+    int i = 0, j = 0, peer = 1 - rank, window_size = options.window_size;
+    double t_start = 0.0, t_end = 0.0;
+    char ack = 0;
+    omb_shm_copy_fn copy = memcpy;
+
+    if (SHM_BW_DIRECT_NT == method || SHM_BW_RING_NT == method) {
+        copy = omb_shm_copy_nt;
+    }
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (i == options.skip) {
+            t_start = MPI_Wtime();
+        }
+        switch (method) {
+            case SHM_BW_MPI:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        MPI_CHECK(MPI_Isend(sbuf, size, MPI_CHAR, peer, 100,
+                                            omb_comm, requests + j));
+                    }
+                    MPI_CHECK(MPI_Waitall(window_size, requests,
+                                          MPI_STATUSES_IGNORE));
+                    MPI_CHECK(MPI_Recv(&ack, 1, MPI_CHAR, peer, 101, omb_comm,
+                                       MPI_STATUS_IGNORE));
+                } else {
+                    for (j = 0; j < window_size; j++) {
+                        MPI_CHECK(MPI_Irecv(rbuf, size, MPI_CHAR, peer, 100,
+                                            omb_comm, requests + j));
+                    }
+                    MPI_CHECK(MPI_Waitall(window_size, requests,
+                                          MPI_STATUSES_IGNORE));
+                    MPI_CHECK(
+                        MPI_Send(&ack, 1, MPI_CHAR, peer, 101, omb_comm));
+                }
+                break;
+            case SHM_BW_DIRECT:
+            case SHM_BW_DIRECT_NT:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        copy(channel.out_buf, sbuf, size);
+                    }
+                    omb_shm_send(&channel, NULL, 0, memcpy);
+                    omb_shm_recv(&channel, NULL, 0);
+                } else {
+                    omb_shm_recv(&channel, NULL, 0);
+                    omb_shm_send(&channel, NULL, 0, memcpy);
+                }
+                break;
+            case SHM_BW_RING:
+            case SHM_BW_RING_NT:
+                if (0 == rank) {
+                    for (j = 0; j < window_size; j++) {
+                        omb_shm_send(&channel, sbuf, size, copy);
+                    }
+                    omb_shm_recv(&channel, NULL, 0);
+                } else {
+                    for (j = 0; j < window_size; j++) {
+                        omb_shm_recv(&channel, rbuf, size);
+                    }
+                    omb_shm_send(&channel, NULL, 0, memcpy);
+                }
+                break;
+        }
+    }
+    t_end = MPI_Wtime();
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    return size / 1e6 * options.iterations * window_size / (t_end - t_start);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, nprocs = 0, method = 0;
+    int po_ret = PO_OKAY;
+    size_t size = 0, buf_size = 0;
+    double bandwidth[SHM_BW_NUM_METHODS], baseline = 0.0;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = SHM_BASELINE_BW;
+    set_header(HEADER);
+    set_benchmark_name("osu_shm_bw");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &nprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != nprocs || !omb_comm_is_node_local(omb_comm)) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes on the"
+                            " same node\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    buf_size = MAX(options.max_message_size, 1);
+    omb_shm_channel_create(omb_comm, buf_size, &channel);
+    CHECK(posix_memalign((void **)&sbuf, getpagesize(), buf_size));
+    CHECK(posix_memalign((void **)&rbuf, getpagesize(), buf_size));
+    memset(sbuf, 'a', buf_size);
+    memset(rbuf, 'b', buf_size);
+    requests = malloc(options.window_size * sizeof(MPI_Request));
+    OMB_CHECK_NULL_AND_EXIT(requests, "Unable to allocate memory");
+
+    print_preamble(rank);
+    omb_print_placement(omb_comm, channel.in);
+    if (0 == rank) {
+#ifndef _ENABLE_NT_STORES_
+        fprintf(stdout, "# Non-temporal stores not available, NT columns use"
+                        " memcpy\n");
+#endif
+        fprintf(stdout, "# Window size: %d\n", options.window_size);
+        fprintf(stdout, "%-*s", 10, "# Size");
+        for (method = 0; method < SHM_BW_NUM_METHODS; method++) {
+            fprintf(stdout, "%*s", FIELD_WIDTH, shm_bw_names[method]);
+        }
+        fprintf(stdout, "%*s\n", FIELD_WIDTH, "MPI/Best(%)");
+        fflush(stdout);
+    }
+
+    for (size = MAX(options.min_message_size, 1);
+         size <= options.max_message_size; size *= 2) {
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        for (method = 0; method < SHM_BW_NUM_METHODS; method++) {
+            bandwidth[method] = run_method(rank, method, size);
+        }
+        if (0 == rank) {
+            baseline = 0.0;
+            fprintf(stdout, "%-*zu", 10, size);
+            for (method = 0; method < SHM_BW_NUM_METHODS; method++) {
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        bandwidth[method]);
+                if (SHM_BW_MPI != method) {
+                    baseline = MAX(baseline, bandwidth[method]);
+                }
+            }
+            fprintf(stdout, "%*.*f\n", FIELD_WIDTH, FLOAT_PRECISION,
+                    100.0 * bandwidth[SHM_BW_MPI] / baseline);
+            fflush(stdout);
+        }
+    }
+
+    omb_shm_channel_free(&channel);
+    free(requests);
+    free(sbuf);
+    free(rbuf);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
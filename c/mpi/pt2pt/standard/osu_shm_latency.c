@@ -0,0 +1,173 @@
+#define BENCHMARK "OSU MPI%s Shared Memory Baseline Latency Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_shm.h>
+
+enum shm_lat_methods_t {
+    SHM_LAT_MPI,
+    SHM_LAT_RING,
+    SHM_LAT_DIRECT,
+    SHM_LAT_NUM_METHODS
+};
+
+static const char *shm_lat_names[SHM_LAT_NUM_METHODS] = {
+    "MPI(us)", "Ring 2-copy(us)", "Direct 1-copy(us)"};
+
+omb_shm_channel_t channel;
+MPI_Comm omb_comm = MPI_COMM_NULL;
+char *sbuf = NULL, *rbuf = NULL;
+
+/* Returns the one-way latency of a ping-pong in us. */
+static double run_method(int rank, int method, size_t size)
+{
+    int i = 0, peer = 1 - rank;
+    double t_start = 0.0, t_end = 0.0;
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    for (i = 0; i < options.skip + options.iterations; i++) {
+        if (i == options.skip) {
+            t_start = MPI_Wtime();
+        }
+        switch (method) {
+            case SHM_LAT_MPI:
+                if (0 == rank) {
+                    MPI_CHECK(
+                        MPI_Send(sbuf, size, MPI_CHAR, peer, 1, omb_comm));
+                    MPI_CHECK(MPI_Recv(rbuf, size, MPI_CHAR, peer, 1, omb_comm,
+                                       MPI_STATUS_IGNORE));
+                } else {
+                    MPI_CHECK(MPI_Recv(rbuf, size, MPI_CHAR, peer, 1, omb_comm,
+                                       MPI_STATUS_IGNORE));
+                    MPI_CHECK(
+                        MPI_Send(sbuf, size, MPI_CHAR, peer, 1, omb_comm));
+                }
+                break;
+            case SHM_LAT_RING:
+                if (0 == rank) {
+                    omb_shm_send(&channel, sbuf, size, memcpy);
+                    omb_shm_recv(&channel, rbuf, size);
+                } else {
+                    omb_shm_recv(&channel, rbuf, size);
+                    omb_shm_send(&channel, sbuf, size, memcpy);
+                }
+                break;
+            case SHM_LAT_DIRECT:
+                if (0 == rank) {
+                    memcpy(channel.out_buf, sbuf, size);
+                    omb_shm_send(&channel, NULL, 0, memcpy);
+                    omb_shm_recv(&channel, NULL, 0);
+                } else {
+                    omb_shm_recv(&channel, NULL, 0);
+                    memcpy(channel.out_buf, sbuf, size);
+                    omb_shm_send(&channel, NULL, 0, memcpy);
+                }
+                break;
+        }
+    }
+    t_end = MPI_Wtime();
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    return (t_end - t_start) * 1e6 / (2.0 * options.iterations);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, nprocs = 0, method = 0;
+    int po_ret = PO_OKAY;
+    size_t size = 0, buf_size = 0;
+    double latency[SHM_LAT_NUM_METHODS], baseline = 0.0;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = PT2PT;
+    options.subtype = SHM_BASELINE_LAT;
+    set_header(HEADER);
+    set_benchmark_name("osu_shm_latency");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &nprocs));
+
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (2 != nprocs || !omb_comm_is_node_local(omb_comm)) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires exactly two processes on the"
+                            " same node\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    buf_size = MAX(options.max_message_size, 1);
+    omb_shm_channel_create(omb_comm, buf_size, &channel);
+    CHECK(posix_memalign((void **)&sbuf, getpagesize(), buf_size));
+    CHECK(posix_memalign((void **)&rbuf, getpagesize(), buf_size));
+    memset(sbuf, 'a', buf_size);
+    memset(rbuf, 'b', buf_size);
+
+    print_preamble(rank);
+    omb_print_placement(omb_comm, channel.in);
+    if (0 == rank) {
+        fprintf(stdout, "%-*s", 10, "# Size");
+        for (method = 0; method < SHM_LAT_NUM_METHODS; method++) {
+            fprintf(stdout, "%*s", FIELD_WIDTH, shm_lat_names[method]);
+        }
+        fprintf(stdout, "%*s%*s\n", FIELD_WIDTH, "Overhead(us)", FIELD_WIDTH,
+                "MPI/Baseline");
+        fflush(stdout);
+    }
+
+    for (size = options.min_message_size; size <= options.max_message_size;
+         size = (size ? size * 2 : 1)) {
+        if (size > LARGE_MESSAGE_SIZE) {
+            options.iterations = options.iterations_large;
+            options.skip = options.skip_large;
+        }
+        for (method = 0; method < SHM_LAT_NUM_METHODS; method++) {
+            latency[method] = run_method(rank, method, size);
+        }
+        if (0 == rank) {
+            baseline = MIN(latency[SHM_LAT_RING], latency[SHM_LAT_DIRECT]);
+            fprintf(stdout, "%-*zu", 10, size);
+            for (method = 0; method < SHM_LAT_NUM_METHODS; method++) {
+                fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                        latency[method]);
+            }
+            fprintf(stdout, "%*.*f%*.*f\n", FIELD_WIDTH, FLOAT_PRECISION,
+                    latency[SHM_LAT_MPI] - baseline, FIELD_WIDTH,
+                    FLOAT_PRECISION, latency[SHM_LAT_MPI] / baseline);
+            fflush(stdout);
+        }
+    }
+
+    omb_shm_channel_free(&channel);
+    free(sbuf);
+    free(rbuf);
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
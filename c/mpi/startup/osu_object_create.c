@@ -0,0 +1,421 @@
+#define BENCHMARK "OSU MPI%s Object Creation Cost Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+/*
+ * Every object kind is created options.iterations times without freeing any
+ * of them, so that the resident memory growth can be attributed per object,
+ * and then all of them are freed. options.skip untimed create/free pairs run
+ * first.
+ */
+enum obj_comm_ops_t {
+    OBJ_COMM_DUP,
+    OBJ_COMM_SPLIT,
+    OBJ_COMM_IDUP,
+    OBJ_COMM_CREATE_GROUP,
+    OBJ_COMM_NUM_OPS
+};
+
+enum obj_dtypes_t {
+    OBJ_DTYPE_CONTIGUOUS,
+    OBJ_DTYPE_VECTOR,
+    OBJ_DTYPE_INDEXED,
+    OBJ_DTYPE_STRUCT,
+    OBJ_DTYPE_NUM_TYPES
+};
+
+#define OBJ_DTYPE_INDEXED_BLOCKS 64
+
+static const char *obj_comm_names[OBJ_COMM_NUM_OPS] = {
+    "MPI_Comm_dup", "MPI_Comm_split", "MPI_Comm_idup",
+    "MPI_Comm_create_group"};
+static const char *obj_dtype_names[OBJ_DTYPE_NUM_TYPES] = {
+    "MPI_Type_contiguous", "MPI_Type_vector", "MPI_Type_indexed",
+    "MPI_Type_create_struct"};
+
+typedef struct obj_cost {
+    double create;
+    double free;
+    double rss;
+} obj_cost_t;
+
+static double obj_rss_per_object(size_t rss_before)
+{
+    size_t rss_after = omb_get_resident_memory();
+
+    if (rss_after <= rss_before) {
+        return 0.0;
+    }
+    return (double)(rss_after - rss_before) / options.iterations;
+}
+
+static void print_cost_header(int rank, const char *first_column)
+{
+    if (rank) {
+        return;
+    }
+    fprintf(stdout, "\n%-*s%-*s%*s%*s%*s\n", 12, first_column, 26, "Operation",
+            FIELD_WIDTH, "Create(us)", FIELD_WIDTH, "Free(us)", FIELD_WIDTH,
+            "RSS/object(B)");
+    fflush(stdout);
+}
+
+static void print_cost(MPI_Comm comm, int rank, size_t key, const char *name,
+                       obj_cost_t cost)
+{
+    int numprocs = 0;
+    double sum[2] = {0.0, 0.0}, local[2] = {cost.create, cost.free};
+    double rss_max = 0.0;
+
+    MPI_CHECK(MPI_Comm_size(comm, &numprocs));
+    MPI_CHECK(MPI_Reduce(local, sum, 2, MPI_DOUBLE, MPI_SUM, 0, comm));
+    MPI_CHECK(
+        MPI_Reduce(&cost.rss, &rss_max, 1, MPI_DOUBLE, MPI_MAX, 0, comm));
+    if (0 == rank) {
+        fprintf(stdout, "%-*zu%-*s%*.*f%*.*f%*.*f\n", 12, key, 26, name,
+                FIELD_WIDTH, FLOAT_PRECISION, sum[0] / numprocs, FIELD_WIDTH,
+                FLOAT_PRECISION, sum[1] / numprocs, FIELD_WIDTH,
+                FLOAT_PRECISION, rss_max);
+        fflush(stdout);
+    }
+}
+
+static void obj_comm_create(MPI_Comm parent, int op, MPI_Group group,
+                            MPI_Comm *newcomm)
+{
+    int prank = 0;
+    MPI_Request request = MPI_REQUEST_NULL;
+
+    MPI_CHECK(MPI_Comm_rank(parent, &prank));
+    switch (op) {
+        case OBJ_COMM_DUP:
+            MPI_CHECK(MPI_Comm_dup(parent, newcomm));
+            break;
+        case OBJ_COMM_SPLIT:
+            MPI_CHECK(MPI_Comm_split(parent, prank % 2, prank, newcomm));
+            break;
+        case OBJ_COMM_IDUP:
+            MPI_CHECK(MPI_Comm_idup(parent, newcomm, &request));
+            MPI_CHECK(MPI_Wait(&request, MPI_STATUS_IGNORE));
+            break;
+        case OBJ_COMM_CREATE_GROUP:
+            MPI_CHECK(MPI_Comm_create_group(parent, group, 0, newcomm));
+            break;
+    }
+}
+
+static obj_cost_t time_comm_op(MPI_Comm parent, int op, MPI_Comm *objs)
+{
+    int i = 0;
+    size_t rss_before = 0;
+    double t_start = 0.0;
+    obj_cost_t cost = {0.0, 0.0, 0.0};
+    MPI_Group group = MPI_GROUP_NULL;
+
+    MPI_CHECK(MPI_Comm_group(parent, &group));
+    for (i = 0; i < options.skip; i++) {
+        obj_comm_create(parent, op, group, &objs[0]);
+        MPI_CHECK(MPI_Comm_free(&objs[0]));
+    }
+    rss_before = omb_get_resident_memory();
+    for (i = 0; i < options.iterations; i++) {
+        MPI_CHECK(MPI_Barrier(parent));
+        t_start = MPI_Wtime();
+        obj_comm_create(parent, op, group, &objs[i]);
+        cost.create += MPI_Wtime() - t_start;
+    }
+    cost.rss = obj_rss_per_object(rss_before);
+    for (i = 0; i < options.iterations; i++) {
+        MPI_CHECK(MPI_Barrier(parent));
+        t_start = MPI_Wtime();
+        MPI_CHECK(MPI_Comm_free(&objs[i]));
+        cost.free += MPI_Wtime() - t_start;
+    }
+    MPI_CHECK(MPI_Group_free(&group));
+    cost.create = cost.create * 1e6 / options.iterations;
+    cost.free = cost.free * 1e6 / options.iterations;
+    return cost;
+}
+
+static void run_comm_sweep(MPI_Comm comm, int rank, int numprocs)
+{
+    int n = 0, op = 0, last = 0;
+    obj_cost_t cost;
+    MPI_Comm parent = MPI_COMM_NULL;
+    MPI_Comm *objs = NULL;
+
+    objs = malloc(MAX(options.iterations, 1) * sizeof(MPI_Comm));
+    OMB_CHECK_NULL_AND_EXIT(objs, "Unable to allocate memory");
+    print_cost_header(rank, "# Comm size");
+    for (n = 2; !last; n *= 2) {
+        if (n >= numprocs) {
+            n = numprocs;
+            last = 1;
+        }
+        MPI_CHECK(MPI_Comm_split(comm, rank < n ? 0 : MPI_UNDEFINED, rank,
+                                 &parent));
+        if (MPI_COMM_NULL != parent) {
+            for (op = 0; op < OBJ_COMM_NUM_OPS; op++) {
+                cost = time_comm_op(parent, op, objs);
+                print_cost(parent, rank, n, obj_comm_names[op], cost);
+            }
+            MPI_CHECK(MPI_Comm_free(&parent));
+        }
+        MPI_CHECK(MPI_Barrier(comm));
+    }
+    free(objs);
+}
+
+/*
+ * A dynamic window is timed on MPI_Win_create_dynamic alone; attaching
+ * memory is reported in its own MPI_Win_attach/detach row.
+ */
+static void obj_win_create(int rank, char **base, size_t size,
+                           enum WINDOW kind, MPI_Win *win)
+{
+#if MPI_VERSION >= 3
+    if (WIN_DYNAMIC == kind) {
+        MPI_CHECK(MPI_Win_create_dynamic(MPI_INFO_NULL, MPI_COMM_WORLD, win));
+        return;
+    }
+#endif
+    omb_win_create_one_sided(rank, base, size, kind, MPI_COMM_WORLD, win);
+}
+
+/*
+ * Windows are created over MPI_COMM_WORLD like the rest of the one-sided
+ * suite. allocate_memory_one_sided() provides the buffers and a first window;
+ * the timed windows reuse its base buffer for the kinds that need one.
+ */
+static void run_win_kind(int rank, enum WINDOW kind, const char *name,
+                         char **bases, MPI_Win *wins)
+{
+    int i = 0;
+    size_t size = 0, rss_before = 0;
+    double t_start = 0.0;
+    char *user_buf = NULL, *win_base = NULL, *attach_buf = NULL;
+    obj_cost_t cost, attach_cost;
+    MPI_Win win;
+
+    for (size = MAX(options.min_message_size, 1);
+         size <= options.max_message_size; size *= 2) {
+        allocate_memory_one_sided(rank, &user_buf, &win_base, size, kind, &win);
+        cost.create = cost.free = 0.0;
+        for (i = 0; i < options.skip; i++) {
+            bases[0] = win_base;
+            obj_win_create(rank, &bases[0], size, kind, &wins[0]);
+            MPI_CHECK(MPI_Win_free(&wins[0]));
+        }
+        rss_before = omb_get_resident_memory();
+        for (i = 0; i < options.iterations; i++) {
+            bases[i] = win_base;
+            MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+            t_start = MPI_Wtime();
+            obj_win_create(rank, &bases[i], size, kind, &wins[i]);
+            cost.create += MPI_Wtime() - t_start;
+        }
+        cost.rss = obj_rss_per_object(rss_before);
+        for (i = 0; i < options.iterations; i++) {
+            MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Win_free(&wins[i]));
+            cost.free += MPI_Wtime() - t_start;
+        }
+        cost.create = cost.create * 1e6 / options.iterations;
+        cost.free = cost.free * 1e6 / options.iterations;
+        print_cost(MPI_COMM_WORLD, rank, size, name, cost);
+
+#if MPI_VERSION >= 3
+        if (WIN_DYNAMIC == kind) {
+            attach_cost.create = attach_cost.free = attach_cost.rss = 0.0;
+            CHECK(posix_memalign((void **)&attach_buf, getpagesize(), size));
+            memset(attach_buf, 'a', size);
+            for (i = 0; i < options.iterations; i++) {
+                t_start = MPI_Wtime();
+                MPI_CHECK(MPI_Win_attach(win, attach_buf, size));
+                attach_cost.create += MPI_Wtime() - t_start;
+                t_start = MPI_Wtime();
+                MPI_CHECK(MPI_Win_detach(win, attach_buf));
+                attach_cost.free += MPI_Wtime() - t_start;
+            }
+            attach_cost.create = attach_cost.create * 1e6 / options.iterations;
+            attach_cost.free = attach_cost.free * 1e6 / options.iterations;
+            print_cost(MPI_COMM_WORLD, rank, size, "MPI_Win_attach/detach",
+                       attach_cost);
+            free(attach_buf);
+        }
+#endif
+        free_memory_one_sided(user_buf, win_base, kind, win, rank);
+    }
+}
+
+static void run_win_sweep(int rank)
+{
+    char **bases = NULL;
+    MPI_Win *wins = NULL;
+
+    bases = malloc(MAX(options.iterations, 1) * sizeof(char *));
+    wins = malloc(MAX(options.iterations, 1) * sizeof(MPI_Win));
+    OMB_CHECK_NULL_AND_EXIT(bases, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(wins, "Unable to allocate memory");
+    print_cost_header(rank, "# Win size");
+    run_win_kind(rank, WIN_CREATE, "MPI_Win_create", bases, wins);
+#if MPI_VERSION >= 3
+    run_win_kind(rank, WIN_ALLOCATE, "MPI_Win_allocate", bases, wins);
+    if (omb_comm_is_node_local(MPI_COMM_WORLD)) {
+        run_win_kind(rank, WIN_ALLOCATE_SHARED, "MPI_Win_allocate_shared",
+                     bases, wins);
+    } else if (0 == rank) {
+        fprintf(stdout, "# MPI_Win_allocate_shared skipped: processes span"
+                        " more than one node\n");
+        fflush(stdout);
+    }
+    run_win_kind(rank, WIN_DYNAMIC, "MPI_Win_create_dynamic", bases, wins);
+#endif
+    free(bases);
+    free(wins);
+}
+
+static void obj_dtype_create(int type, MPI_Datatype *newtype)
+{
+    int i = 0;
+    int blocklens[OBJ_DTYPE_INDEXED_BLOCKS], displs[OBJ_DTYPE_INDEXED_BLOCKS];
+    int struct_blocklens[3] = {1, 1, 16};
+    MPI_Aint struct_displs[3] = {0, sizeof(double), 2 * sizeof(double)};
+    MPI_Datatype struct_types[3] = {MPI_INT, MPI_DOUBLE, MPI_CHAR};
+
+    switch (type) {
+        case OBJ_DTYPE_CONTIGUOUS:
+            MPI_CHECK(MPI_Type_contiguous(1024, MPI_CHAR, newtype));
+            break;
+        case OBJ_DTYPE_VECTOR:
+            MPI_CHECK(MPI_Type_vector(256, 1, 4, MPI_INT, newtype));
+            break;
+        case OBJ_DTYPE_INDEXED:
+            for (i = 0; i < OBJ_DTYPE_INDEXED_BLOCKS; i++) {
+                blocklens[i] = 2;
+                displs[i] = 4 * i;
+            }
+            MPI_CHECK(MPI_Type_indexed(OBJ_DTYPE_INDEXED_BLOCKS, blocklens,
+                                       displs, MPI_INT, newtype));
+            break;
+        case OBJ_DTYPE_STRUCT:
+            MPI_CHECK(MPI_Type_create_struct(3, struct_blocklens,
+                                             struct_displs, struct_types,
+                                             newtype));
+            break;
+    }
+    MPI_CHECK(MPI_Type_commit(newtype));
+}
+
+static void run_dtype_sweep(int rank)
+{
+    int type = 0, i = 0;
+    size_t rss_before = 0;
+    double t_start = 0.0;
+    obj_cost_t cost;
+    MPI_Datatype *objs = NULL;
+
+    objs = malloc(MAX(options.iterations, 1) * sizeof(MPI_Datatype));
+    OMB_CHECK_NULL_AND_EXIT(objs, "Unable to allocate memory");
+    print_cost_header(rank, "# Type size");
+    for (type = 0; type < OBJ_DTYPE_NUM_TYPES; type++) {
+        int type_size = 0;
+
+        cost.create = cost.free = 0.0;
+        for (i = 0; i < options.skip; i++) {
+            obj_dtype_create(type, &objs[0]);
+            MPI_CHECK(MPI_Type_free(&objs[0]));
+        }
+        rss_before = omb_get_resident_memory();
+        for (i = 0; i < options.iterations; i++) {
+            t_start = MPI_Wtime();
+            obj_dtype_create(type, &objs[i]);
+            cost.create += MPI_Wtime() - t_start;
+        }
+        cost.rss = obj_rss_per_object(rss_before);
+        MPI_CHECK(MPI_Type_size(objs[0], &type_size));
+        for (i = 0; i < options.iterations; i++) {
+            t_start = MPI_Wtime();
+            MPI_CHECK(MPI_Type_free(&objs[i]));
+            cost.free += MPI_Wtime() - t_start;
+        }
+        cost.create = cost.create * 1e6 / options.iterations;
+        cost.free = cost.free * 1e6 / options.iterations;
+        print_cost(MPI_COMM_WORLD, rank, type_size, obj_dtype_names[type],
+                   cost);
+    }
+    free(objs);
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = 0;
+    MPI_Comm omb_comm = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+
+    options.bench = STARTUP;
+    options.subtype = OBJ_CREATE;
+    set_header(HEADER);
+    set_benchmark_name("osu_object_create");
+    po_ret = process_options(argc, argv);
+    omb_init_h = omb_mpi_init(&argc, &argv);
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    if (1 == options.omb_enable_session) {
+        if (0 == rank) {
+            fprintf(stderr, "Windows are created over MPI_COMM_WORLD, session"
+                            " based initialization is not supported\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Objects per measurement: %zu\n", options.iterations);
+        fflush(stdout);
+    }
+    run_comm_sweep(omb_comm, rank, numprocs);
+    run_win_sweep(rank);
+    run_dtype_sweep(rank);
+
+    omb_mpi_finalize(omb_init_h);
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -0,0 +1,336 @@
+#define BENCHMARK "OSU MPI%s Startup Test"
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include <osu_util_mpi.h>
+
+/* Number of exchanges used for the warm per-peer latency */
+#define STARTUP_WARM_MESSAGES 10
+
+enum startup_comm_ops_t {
+    STARTUP_COMM_DUP,
+    STARTUP_COMM_SPLIT,
+    STARTUP_COMM_SPLIT_TYPE,
+    STARTUP_COMM_CREATE_GROUP,
+    STARTUP_COMM_NUM_OPS
+};
+
+/* MPI_Wtime cannot be used before MPI is initialized */
+static double startup_wtime_us(void)
+{
+    struct timespec tp;
+
+    clock_gettime(CLOCK_MONOTONIC, &tp);
+    return tp.tv_sec * 1e6 + tp.tv_nsec / 1e3;
+}
+
+static void print_phase(MPI_Comm comm, int rank, int numprocs,
+                        const char *phase, double value)
+{
+    double min = 0.0, max = 0.0, sum = 0.0;
+
+    MPI_CHECK(MPI_Reduce(&value, &min, 1, MPI_DOUBLE, MPI_MIN, 0, comm));
+    MPI_CHECK(MPI_Reduce(&value, &max, 1, MPI_DOUBLE, MPI_MAX, 0, comm));
+    MPI_CHECK(MPI_Reduce(&value, &sum, 1, MPI_DOUBLE, MPI_SUM, 0, comm));
+    if (0 == rank) {
+        fprintf(stdout, "%-*s%*.*f%*.*f%*.*f\n", 28, phase, FIELD_WIDTH,
+                FLOAT_PRECISION, sum / numprocs, FIELD_WIDTH, FLOAT_PRECISION,
+                min, FIELD_WIDTH, FLOAT_PRECISION, max);
+        fflush(stdout);
+    }
+}
+
+static double time_collective(MPI_Comm comm, int is_barrier, int count)
+{
+    int i = 0;
+    double t_start = 0.0, timer = 0.0;
+    long sendval = 1, recvval = 0;
+
+    for (i = 0; i < count; i++) {
+        t_start = MPI_Wtime();
+        if (is_barrier) {
+            MPI_CHECK(MPI_Barrier(comm));
+        } else {
+            MPI_CHECK(MPI_Allreduce(&sendval, &recvval, 1, MPI_LONG, MPI_SUM,
+                                    comm));
+        }
+        timer += MPI_Wtime() - t_start;
+    }
+    return timer * 1e6 / count;
+}
+
+/*
+ * In round d every process exchanges one byte with the processes d ranks
+ * away. Round d and round numprocs - d touch the same pairs, so only the
+ * rounds up to numprocs / 2 are run and each pair is timed on its first
+ * contact only.
+ */
+static void run_first_message(MPI_Comm comm, int rank, int numprocs)
+{
+    int d = 0, i = 0, dst = 0, src = 0, rounds = numprocs / 2;
+    char sbuf = 'a', rbuf = 0;
+    double t_start = 0.0, cold = 0.0, warm = 0.0;
+    double cold_min = 0.0, cold_max = 0.0, cold_sum = 0.0, warm_sum = 0.0;
+    double *cold_dist = NULL, *cold_dist_sum = NULL, *cold_dist_max = NULL;
+
+    cold_dist = malloc(numprocs * sizeof(double));
+    cold_dist_sum = malloc(numprocs * sizeof(double));
+    cold_dist_max = malloc(numprocs * sizeof(double));
+    OMB_CHECK_NULL_AND_EXIT(cold_dist, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(cold_dist_sum, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(cold_dist_max, "Unable to allocate memory");
+    cold_min = 1e30;
+    cold_dist[0] = 0.0;
+    for (d = 1; d <= rounds; d++) {
+        dst = (rank + d) % numprocs;
+        src = (rank - d + numprocs) % numprocs;
+        t_start = MPI_Wtime();
+        MPI_CHECK(MPI_Sendrecv(&sbuf, 1, MPI_CHAR, dst, 1, &rbuf, 1, MPI_CHAR,
+                               src, 1, comm, MPI_STATUS_IGNORE));
+        cold = (MPI_Wtime() - t_start) * 1e6;
+        t_start = MPI_Wtime();
+        for (i = 0; i < STARTUP_WARM_MESSAGES; i++) {
+            MPI_CHECK(MPI_Sendrecv(&sbuf, 1, MPI_CHAR, dst, 1, &rbuf, 1,
+                                   MPI_CHAR, src, 1, comm, MPI_STATUS_IGNORE));
+        }
+        warm = (MPI_Wtime() - t_start) * 1e6 / STARTUP_WARM_MESSAGES;
+        cold_dist[d] = cold;
+        cold_min = MIN(cold_min, cold);
+        cold_max = MAX(cold_max, cold);
+        cold_sum += cold;
+        warm_sum += warm;
+    }
+    print_phase(comm, rank, numprocs, "First message (min)", cold_min);
+    print_phase(comm, rank, numprocs, "First message (avg)",
+                cold_sum / rounds);
+    print_phase(comm, rank, numprocs, "First message (max)", cold_max);
+    print_phase(comm, rank, numprocs, "Warm message (avg)",
+                warm_sum / rounds);
+
+    if (options.show_full) {
+        MPI_CHECK(MPI_Reduce(cold_dist, cold_dist_sum, rounds + 1, MPI_DOUBLE,
+                             MPI_SUM, 0, comm));
+        MPI_CHECK(MPI_Reduce(cold_dist, cold_dist_max, rounds + 1, MPI_DOUBLE,
+                             MPI_MAX, 0, comm));
+        if (0 == rank) {
+            fprintf(stdout, "\n%-*s%*s%*s\n", 12, "# Distance", FIELD_WIDTH,
+                    "First avg(us)", FIELD_WIDTH, "First max(us)");
+            for (d = 1; d <= rounds; d++) {
+                fprintf(stdout, "%-*d%*.*f%*.*f\n", 12, d, FIELD_WIDTH,
+                        FLOAT_PRECISION, cold_dist_sum[d] / numprocs,
+                        FIELD_WIDTH, FLOAT_PRECISION, cold_dist_max[d]);
+            }
+            fflush(stdout);
+        }
+    }
+    free(cold_dist);
+    free(cold_dist_sum);
+    free(cold_dist_max);
+}
+
+static double time_comm_op(MPI_Comm parent, int op)
+{
+    int i = 0, prank = 0;
+    double t_start = 0.0, timer = 0.0;
+    MPI_Comm newcomm = MPI_COMM_NULL;
+    MPI_Group group = MPI_GROUP_NULL;
+
+    MPI_CHECK(MPI_Comm_rank(parent, &prank));
+    MPI_CHECK(MPI_Comm_group(parent, &group));
+    for (i = 0; i < options.iterations + options.skip; i++) {
+        MPI_CHECK(MPI_Barrier(parent));
+        t_start = MPI_Wtime();
+        switch (op) {
+            case STARTUP_COMM_DUP:
+                MPI_CHECK(MPI_Comm_dup(parent, &newcomm));
+                break;
+            case STARTUP_COMM_SPLIT:
+                MPI_CHECK(MPI_Comm_split(parent, prank % 2, prank, &newcomm));
+                break;
+            case STARTUP_COMM_SPLIT_TYPE:
+                MPI_CHECK(MPI_Comm_split_type(parent, MPI_COMM_TYPE_SHARED,
+                                              prank, MPI_INFO_NULL, &newcomm));
+                break;
+            case STARTUP_COMM_CREATE_GROUP:
+                MPI_CHECK(MPI_Comm_create_group(parent, group, 0, &newcomm));
+                break;
+        }
+        if (i >= options.skip) {
+            timer += MPI_Wtime() - t_start;
+        }
+        MPI_CHECK(MPI_Comm_free(&newcomm));
+    }
+    MPI_CHECK(MPI_Group_free(&group));
+    return timer * 1e6 / options.iterations;
+}
+
+static void run_comm_sweep(MPI_Comm comm, int rank, int numprocs)
+{
+    int n = 0, op = 0, last = 0;
+    double latency[STARTUP_COMM_NUM_OPS], avg[STARTUP_COMM_NUM_OPS];
+    MPI_Comm parent = MPI_COMM_NULL;
+
+    if (0 == rank) {
+        fprintf(stdout, "\n%-*s%*s%*s%*s%*s\n", 12, "# Comm size", FIELD_WIDTH,
+                "Dup(us)", FIELD_WIDTH, "Split(us)", FIELD_WIDTH,
+                "Split_type(us)", FIELD_WIDTH, "Create_group(us)");
+        fflush(stdout);
+    }
+    for (n = 2; !last; n *= 2) {
+        if (n >= numprocs) {
+            n = numprocs;
+            last = 1;
+        }
+        MPI_CHECK(MPI_Comm_split(comm, rank < n ? 0 : MPI_UNDEFINED, rank,
+                                 &parent));
+        if (MPI_COMM_NULL != parent) {
+            for (op = 0; op < STARTUP_COMM_NUM_OPS; op++) {
+                latency[op] = time_comm_op(parent, op);
+            }
+            MPI_CHECK(MPI_Reduce(latency, avg, STARTUP_COMM_NUM_OPS,
+                                 MPI_DOUBLE, MPI_SUM, 0, parent));
+            MPI_CHECK(MPI_Comm_free(&parent));
+            if (0 == rank) {
+                fprintf(stdout, "%-*d", 12, n);
+                for (op = 0; op < STARTUP_COMM_NUM_OPS; op++) {
+                    fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                            avg[op] / n);
+                }
+                fprintf(stdout, "\n");
+                fflush(stdout);
+            }
+        }
+        MPI_CHECK(MPI_Barrier(comm));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int rank = 0, numprocs = 0, po_ret = 0;
+    double t_init_start = 0.0, t_init = 0.0, t_first_coll = 0.0;
+    double t_finalize = 0.0;
+    double first_barrier = 0.0, first_allreduce = 0.0;
+    MPI_Comm omb_comm = MPI_COMM_NULL;
+    omb_mpi_init_data omb_init_h;
+#ifdef _ENABLE_MPI4_
+    MPI_Group wgroup = MPI_GROUP_NULL;
+    double t_session = 0.0, t_group = 0.0, t_comm = 0.0, t_phase = 0.0;
+#endif
+
+    options.bench = STARTUP;
+    options.subtype = LAT;
+    set_header(HEADER);
+    set_benchmark_name("osu_startup");
+    po_ret = process_options(argc, argv);
+
+    t_init_start = startup_wtime_us();
+    if (PO_OKAY == po_ret && 1 == options.omb_enable_session) {
+#ifdef _ENABLE_MPI4_
+        omb_init_h.omb_shandle = MPI_SESSION_NULL;
+        t_phase = startup_wtime_us();
+        MPI_CHECK(MPI_Session_init(MPI_INFO_NULL, MPI_ERRORS_RETURN,
+                                   &omb_init_h.omb_shandle));
+        t_session = startup_wtime_us() - t_phase;
+        t_phase = startup_wtime_us();
+        MPI_CHECK(MPI_Group_from_session_pset(
+            omb_init_h.omb_shandle, OMB_MPI_SESSION_PSET_NAME, &wgroup));
+        t_group = startup_wtime_us() - t_phase;
+        t_phase = startup_wtime_us();
+        MPI_CHECK(MPI_Comm_create_from_group(wgroup, OMB_MPI_SESSION_GROUP_NAME,
+                                             MPI_INFO_NULL, MPI_ERRORS_RETURN,
+                                             &omb_init_h.omb_comm));
+        t_comm = startup_wtime_us() - t_phase;
+        MPI_CHECK(MPI_Group_free(&wgroup));
+#else
+        omb_init_h = omb_mpi_init(&argc, &argv);
+#endif
+    } else {
+        omb_init_h = omb_mpi_init(&argc, &argv);
+    }
+    t_init = startup_wtime_us() - t_init_start;
+    omb_comm = omb_init_h.omb_comm;
+    if (MPI_COMM_NULL == omb_comm) {
+        OMB_ERROR_EXIT("Cant create communicator");
+    }
+
+    /* Nothing may communicate before the first collective is timed */
+    first_barrier = time_collective(omb_comm, 1, 1);
+    t_first_coll = startup_wtime_us() - t_init_start;
+
+    MPI_CHECK(MPI_Comm_rank(omb_comm, &rank));
+    MPI_CHECK(MPI_Comm_size(omb_comm, &numprocs));
+    switch (po_ret) {
+        case PO_BAD_USAGE:
+            print_bad_usage_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_FAILURE);
+        case PO_HELP_MESSAGE:
+            print_help_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_VERSION_MESSAGE:
+            print_version_message(rank);
+            omb_mpi_finalize(omb_init_h);
+            exit(EXIT_SUCCESS);
+        case PO_OKAY:
+            break;
+    }
+    if (numprocs < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "This test requires at least two processes\n");
+        }
+        omb_mpi_finalize(omb_init_h);
+        exit(EXIT_FAILURE);
+    }
+    first_allreduce = time_collective(omb_comm, 0, 1);
+
+    print_preamble(rank);
+    if (0 == rank) {
+        fprintf(stdout, "# Initialization: %s\n",
+                options.omb_enable_session ?
+                    "MPI_Session_init + MPI_Comm_create_from_group" :
+                    "MPI_Init");
+        fprintf(stdout, "%-*s%*s%*s%*s\n", 28, "# Phase", FIELD_WIDTH,
+                "Avg(us)", FIELD_WIDTH, "Min(us)", FIELD_WIDTH, "Max(us)");
+        fflush(stdout);
+    }
+    print_phase(omb_comm, rank, numprocs, "Initialization", t_init);
+#ifdef _ENABLE_MPI4_
+    if (1 == options.omb_enable_session) {
+        print_phase(omb_comm, rank, numprocs, "  MPI_Session_init", t_session);
+        print_phase(omb_comm, rank, numprocs, "  MPI_Group_from_session_pset",
+                    t_group);
+        print_phase(omb_comm, rank, numprocs, "  MPI_Comm_create_from_group",
+                    t_comm);
+    }
+#endif
+    print_phase(omb_comm, rank, numprocs, "Time to first collective",
+                t_first_coll);
+    print_phase(omb_comm, rank, numprocs, "First MPI_Barrier", first_barrier);
+    print_phase(omb_comm, rank, numprocs, "Warm MPI_Barrier",
+                time_collective(omb_comm, 1, options.iterations));
+    print_phase(omb_comm, rank, numprocs, "First MPI_Allreduce",
+                first_allreduce);
+    print_phase(omb_comm, rank, numprocs, "Warm MPI_Allreduce",
+                time_collective(omb_comm, 0, options.iterations));
+    run_first_message(omb_comm, rank, numprocs);
+    run_comm_sweep(omb_comm, rank, numprocs);
+
+    MPI_CHECK(MPI_Barrier(omb_comm));
+    t_finalize = startup_wtime_us();
+    omb_mpi_finalize(omb_init_h);
+    t_finalize = startup_wtime_us() - t_finalize;
+    if (0 == rank) {
+        fprintf(stdout, "\n# MPI finalization (rank 0): %.*f us\n",
+                FLOAT_PRECISION, t_finalize);
+        fflush(stdout);
+    }
+    return EXIT_SUCCESS;
+}
+/* vi: set sw=4 sts=4 tw=80: */
@@ -9,6 +9,9 @@
  */
 
 #include "osu_util.h"
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #ifdef _ENABLE_OPENACC_
 #include <openacc.h>
 #endif
@@ -159,6 +162,27 @@ void print_data(int rank, int full, int size, double avg_time, double min_time,
     }
 }
 
+/* Parses a byte count with an optional K, M or G (powers of 1024) suffix. */
+static long long omb_atosize(const char *str)
+{
+    char *end = NULL;
+    long long value = strtoll(str, &end, 10);
+
+    switch (*end) {
+        case 'k':
+        case 'K':
+            return value << 10;
+        case 'm':
+        case 'M':
+            return value << 20;
+        case 'g':
+        case 'G':
+            return value << 30;
+        default:
+            return value;
+    }
+}
+
 static int set_min_message_size(long long value)
 {
     if (0 >= value) {
@@ -193,19 +217,19 @@ static int set_message_size(char *val_str)
     }
 
     if (!count) {
-        retval = set_max_message_size(atoll(val_str));
+        retval = set_max_message_size(omb_atosize(val_str));
     } else if (count == 1) {
         val1 = strtok(val_str, ":");
         val2 = strtok(NULL, ":");
 
         if (val1 && val2) {
-            retval = set_min_message_size(atoll(val1));
-            retval = set_max_message_size(atoll(val2));
+            retval = set_min_message_size(omb_atosize(val1));
+            retval = set_max_message_size(omb_atosize(val2));
         } else if (val1) {
             if (val_str[0] == ':') {
-                retval = set_max_message_size(atoll(val1));
+                retval = set_max_message_size(omb_atosize(val1));
             } else {
-                retval = set_min_message_size(atoll(val1));
+                retval = set_min_message_size(omb_atosize(val1));
             }
         }
     }
@@ -402,6 +426,56 @@ static int set_num_probes(int value)
     return 0;
 }
 
+static int is_reduction_subtype(void)
+{
+    switch (options.subtype) {
+        case REDUCE:
+        case ALL_REDUCE:
+        case REDUCE_SCATTER:
+        case NBC_REDUCE:
+        case NBC_ALL_REDUCE:
+        case NBC_REDUCE_SCATTER:
+        case REDUCE_P:
+        case ALL_REDUCE_P:
+        case REDUCE_SCATTER_P:
+        case REDUCE_LOCAL:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Checks a datatype against the benchmark and the reduction operator. Returns
+ * the reason for rejecting it, or NULL if it is supported.
+ */
+static char const *omb_dtype_supported(enum omb_dtypes_t dtype)
+{
+    if (!is_reduction_subtype()) {
+        if (OMB_BFLOAT16 == dtype || OMB_2INT == dtype) {
+            return "bf16 and mpi_2int are only supported by the reduction"
+                   " benchmarks";
+        }
+        return NULL;
+    }
+    if ((OMB_OP_MINLOC == options.reduce_op) != (OMB_2INT == dtype)) {
+        return "minloc is only supported with mpi_2int and vice versa";
+    }
+    if ((OMB_OP_MAX == options.reduce_op || OMB_OP_MIN == options.reduce_op) &&
+        OMB_DOUBLE_COMPLEX == dtype) {
+        return "max and min are not defined for complex numbers";
+    }
+    if (OMB_OP_BAND == options.reduce_op && OMB_CHAR != dtype &&
+        OMB_INT != dtype && OMB_INT64 != dtype) {
+        return "band requires an integer datatype";
+    }
+    if ((OMB_OP_USER == options.reduce_op || OMB_BFLOAT16 == dtype) &&
+        NONE != options.accel) {
+        return "User-defined operators require host buffers";
+    }
+    return NULL;
+}
+
 void set_header(const char *header) { benchmark_header = header; }
 
 void set_benchmark_name(const char *name) { benchmark_name = name; }
@@ -444,6 +518,16 @@ int process_options(int argc, char *argv[])
     char *graph_term_type = NULL;
     char *validation_log_option = NULL;
     char *root_rank_type = NULL;
+    char *skew_type = NULL, *skew_value = NULL;
+    char *carve_type = NULL, *comm_size = NULL;
+    char *traffic_type = NULL, *traffic_arg = NULL;
+    char *victim_type = NULL, *congestor_type = NULL, *interference_arg = NULL;
+    char *split_type = NULL, *split_arg = NULL;
+    char *group_type = NULL, *group_arg = NULL;
+    char *affinity_type = NULL, *affinity_arg = NULL;
+    char *contention_threads = NULL, *contention_mb = NULL;
+    char *buffer_type = NULL, *buffer_arg = NULL;
+    int dtype_all = 0;
     char *strtok_parsed = NULL;
     static struct option long_options[OMB_LONG_OPTIONS_ARRAY_SIZE];
 
@@ -468,6 +552,33 @@ int process_options(int argc, char *argv[])
             case CONG_BW:
                 OMBOP_OPTSTR_BLK(PT2PT, CONG_BW);
                 break;
+            case CONG_PATTERN:
+                OMBOP_OPTSTR_BLK(PT2PT, CONG_PATTERN);
+                break;
+            case CONG_IMPACT:
+                OMBOP_OPTSTR_BLK(PT2PT, CONG_IMPACT);
+                break;
+            case CONG_BISECTION:
+                OMBOP_OPTSTR_BLK(PT2PT, CONG_BISECTION);
+                break;
+            case MT_MBW_MR:
+                OMBOP_OPTSTR_BLK(PT2PT, MT_MBW_MR);
+                break;
+            case SHM_BASELINE_LAT:
+                OMBOP_OPTSTR_BLK(PT2PT, SHM_BASELINE_LAT);
+                break;
+            case SHM_BASELINE_BW:
+                OMBOP_OPTSTR_BLK(PT2PT, SHM_BASELINE_BW);
+                break;
+            case PT2PT_OVERLAP:
+                OMBOP_OPTSTR_BLK(PT2PT, PT2PT_OVERLAP);
+                break;
+            case LOGGP:
+                OMBOP_OPTSTR_BLK(PT2PT, LOGGP);
+                break;
+            case MATCHING:
+                OMBOP_OPTSTR_BLK(PT2PT, MATCHING);
+                break;
             default:
                 OMB_ERROR_EXIT("Unknown subtype");
                 break;
@@ -570,6 +681,21 @@ int process_options(int argc, char *argv[])
             case NBC_NHBR_GATHER:
                 OMBOP_OPTSTR_CUDA_BLK(COLLECTIVE, NBC_NHBR_GATHER);
                 break;
+            case COLL_AUTOTUNE:
+                OMBOP_OPTSTR_CUDA_BLK(COLLECTIVE, COLL_AUTOTUNE);
+                break;
+            case COLL_SCALING:
+                OMBOP_OPTSTR_CUDA_BLK(COLLECTIVE, COLL_SCALING);
+                break;
+            case COLL_CONCURRENT:
+                OMBOP_OPTSTR_CUDA_BLK(COLLECTIVE, COLL_CONCURRENT);
+                break;
+            case COLL_MT:
+                OMBOP_OPTSTR_CUDA_BLK(COLLECTIVE, COLL_MT);
+                break;
+            case REDUCE_LOCAL:
+                OMBOP_OPTSTR_CUDA_BLK(COLLECTIVE, REDUCE_LOCAL);
+                break;
             default:
                 OMB_ERROR_EXIT("Unknown subtype");
                 break;
@@ -585,10 +711,18 @@ int process_options(int argc, char *argv[])
         options.optstring = OMBOP__UPCXX;
     } else if (STARTUP == options.bench && INIT == options.subtype) {
         options.optstring = OMBOP__STARTUP__INIT;
+    } else if (STARTUP == options.bench && LAT == options.subtype) {
+        options.optstring = OMBOP__STARTUP__LAT;
+    } else if (STARTUP == options.bench && OBJ_CREATE == options.subtype) {
+        options.optstring = OMBOP__STARTUP__OBJ_CREATE;
+    } else if (ONE_SIDED == options.bench && SHM_WIN_LAT == options.subtype) {
+        options.optstring = OMBOP__ONE_SIDED__SHM_LAT;
+    } else if (ONE_SIDED == options.bench && SHM_WIN_BW == options.subtype) {
+        options.optstring = OMBOP__ONE_SIDED__SHM_BW;
     } else if (options.bench == ONE_SIDED) {
         int jchar = 0;
 
-        jchar = sprintf(&optstring_buf[jchar], "%s", "+:w:s:hvm:x:i:G:Iz::");
+        jchar = sprintf(&optstring_buf[jchar], "%s", "+:w:s:hvm:x:i:G:eM::Iz::H:");
         if (options.subtype == BW) {
             jchar += sprintf(&optstring_buf[jchar], "%s", "W:");
         }
@@ -628,6 +762,8 @@ int process_options(int argc, char *argv[])
     options.validate = 0;
     options.log_validation = 0;
     options.papi_enabled = 0;
+    options.perf_enabled = 0;
+    options.mpit_pvars_enabled = 0;
     options.buf_num = SINGLE;
     options.omb_enable_ddt = 0;
     options.ddt_type_parameters.block_length = OMB_DDT_BLOCK_LENGTH_DEFAULT;
@@ -649,6 +785,37 @@ int process_options(int argc, char *argv[])
     options.omb_enable_mpi_in_place = 0;
     options.omb_root_rank = 0;
     options.omb_tail_lat = 0;
+    strcpy(options.omb_tune_coll, "allreduce");
+    options.omb_tune_file[0] = '\0';
+    options.omb_mpit_pvar_filter[0] = '\0';
+    options.match_pattern = OMB_MATCH_EXACT;
+    options.match_position = OMB_MATCH_LAST;
+    options.skew_type = OMB_SKEW_NONE;
+    options.skew_delay = 0;
+    options.skew_arg = 0;
+    options.carve_type = OMB_CARVE_DENSE;
+    options.reduce_op = OMB_OP_SUM;
+    options.traffic_pattern = OMB_TRAFFIC_RANDOM;
+    options.traffic_seed = 1;
+    options.victim_kernel = OMB_VICTIM_ALLREDUCE;
+    options.congestor = OMB_CONGESTOR_ALLTOALL;
+    options.victim_pct = OMB_VICTIM_PCT_DEFAULT;
+    options.congestor_size = OMB_CONGESTOR_SIZE_DEFAULT;
+    options.bisection_split = OMB_BISECTION_RANDOM;
+    options.num_splits = OMB_BISECTION_SPLITS_DEFAULT;
+    options.bisection_seed = 1;
+    options.bisection_file[0] = '\0';
+    options.group_pattern = OMB_GROUP_NODE;
+    options.group_arg = 0;
+    options.affinity_policy = OMB_AFFINITY_UNSET;
+    options.affinity_socket = 0;
+    options.affinity_cpus[0] = '\0';
+    options.contention_threads = 0;
+    options.contention_mb = OMB_CONTENTION_MB_DEFAULT;
+    options.max_mem_limit = 0;
+    options.buffer_policy = OMB_BUFFER_REUSE;
+    options.buffer_cache_mb = OMB_BUFFER_CACHE_MB_DEFAULT;
+    options.num_comm_sizes = 0;
     options.num_partitions = DEFAULT_NUM_PARTITIONS;
     for (itr = 0; itr < OMB_STAT_MAX_NUM; itr++) {
         options.omb_stat_percentiles[itr] = -1;
@@ -657,12 +824,56 @@ int process_options(int argc, char *argv[])
     switch (options.subtype) {
         case BW:
         case CONG_BW:
+        case CONG_PATTERN:
+        case CONG_BISECTION:
+        case SHM_WIN_BW:
+        case SHM_BASELINE_BW:
+        case LOGGP:
             options.iterations = BW_LOOP_SMALL;
             options.skip = BW_SKIP_SMALL;
             options.iterations_large = BW_LOOP_LARGE;
             options.skip_large = BW_SKIP_LARGE;
             options.warmup_validation = VALIDATION_SKIP_DEFAULT;
             break;
+        case MATCHING:
+            options.iterations = LAT_LOOP_SMALL;
+            options.skip = LAT_SKIP_SMALL;
+            options.iterations_large = LAT_LOOP_LARGE;
+            options.skip_large = LAT_SKIP_LARGE;
+            options.min_message_size = 1;
+            options.max_message_size = MAX_MATCH_QUEUE_DEPTH;
+            break;
+        case MT_MBW_MR:
+            options.iterations = BW_LOOP_SMALL;
+            options.skip = BW_SKIP_SMALL;
+            options.iterations_large = BW_LOOP_LARGE;
+            options.skip_large = BW_SKIP_LARGE;
+            options.num_threads = DEF_NUM_THREADS_MR;
+            options.max_message_size = MAX_MSG_SIZE_MT_MBW_MR;
+            break;
+        case CONG_IMPACT:
+            options.iterations = COLL_LOOP_SMALL;
+            options.skip = COLL_SKIP_SMALL;
+            options.iterations_large = COLL_LOOP_LARGE;
+            options.skip_large = COLL_SKIP_LARGE;
+            options.min_message_size = 8;
+            options.max_message_size = MAX_MSG_SIZE_CONG_IMPACT;
+            break;
+        case REDUCE_LOCAL:
+            options.iterations = COLL_LOOP_SMALL;
+            options.skip = COLL_SKIP_SMALL;
+            options.iterations_large = COLL_LOOP_LARGE;
+            options.skip_large = COLL_SKIP_LARGE;
+            options.max_message_size = MAX_MSG_SIZE_REDUCE_LOCAL;
+            break;
+        case PT2PT_OVERLAP:
+            options.iterations = COLL_LOOP_SMALL;
+            options.skip = COLL_SKIP_SMALL;
+            options.iterations_large = COLL_LOOP_LARGE;
+            options.skip_large = COLL_SKIP_LARGE;
+            options.num_probes = DEF_NUM_PROBES;
+            options.min_message_size = 0;
+            break;
         case LAT_MT:
             options.num_threads = DEF_NUM_THREADS;
             options.min_message_size = 0;
@@ -673,6 +884,8 @@ int process_options(int argc, char *argv[])
             options.sender_processes = DEF_NUM_PROCESSES;
         case PART_LAT:
         case LAT:
+        case SHM_WIN_LAT:
+        case SHM_BASELINE_LAT:
         case BARRIER:
         case GATHER:
         case ALL_GATHER:
@@ -704,6 +917,10 @@ int process_options(int argc, char *argv[])
         case SCATTER_P:
         case BCAST_P:
         case REDUCE_SCATTER_P:
+        case COLL_AUTOTUNE:
+        case COLL_SCALING:
+        case COLL_CONCURRENT:
+        case COLL_MT:
             if (options.bench == COLLECTIVE) {
                 options.iterations = COLL_LOOP_SMALL;
                 options.skip = COLL_SKIP_SMALL;
@@ -718,6 +935,9 @@ int process_options(int argc, char *argv[])
             if (options.bench == PT2PT) {
                 options.min_message_size = 0;
             }
+            if (options.subtype == COLL_MT) {
+                options.num_threads = DEF_NUM_THREADS_COLL;
+            }
             options.warmup_validation = VALIDATION_SKIP_DEFAULT;
             break;
         default:
@@ -735,6 +955,11 @@ int process_options(int argc, char *argv[])
             options.skip_large = OSHM_SKIP_LARGE;
             options.max_message_size = 1 << 20;
             break;
+        case STARTUP:
+            options.iterations = STARTUP_LOOP;
+            options.skip = STARTUP_SKIP;
+            options.max_message_size = 1 << 20;
+            break;
         default:
             break;
     }
@@ -757,9 +982,24 @@ int process_options(int argc, char *argv[])
 
                     return PO_BAD_USAGE;
                 }
+                if (INT_MAX < options.max_message_size &&
+                    !options.large_count) {
+                    bad_usage.message = "Messages above 2GB need an MPI-4"
+                                        " library with large-count support"
+                                        " and a benchmark that uses it\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
                 break;
             case 't':
-                if (options.bench == COLLECTIVE) {
+                if (options.subtype == COLL_MT) {
+                    if (set_receiver_threads(atoi(optarg))) {
+                        bad_usage.message = "Invalid Number of Threads";
+                        bad_usage.optarg = optarg;
+
+                        return PO_BAD_USAGE;
+                    }
+                } else if (options.bench == COLLECTIVE) {
                     if (set_num_probes(atoi(optarg))) {
                         bad_usage.message = "Invalid Number of Probes";
                         bad_usage.optarg = optarg;
@@ -767,11 +1007,25 @@ int process_options(int argc, char *argv[])
                         return PO_BAD_USAGE;
                     }
                 } else if (options.bench == PT2PT) {
-                    if (options.subtype == LAT_MT) {
+                    if (options.subtype == PT2PT_OVERLAP) {
+                        if (set_num_probes(atoi(optarg))) {
+                            bad_usage.message = "Invalid Number of Probes";
+                            bad_usage.optarg = optarg;
+
+                            return PO_BAD_USAGE;
+                        }
+                    } else if (options.subtype == LAT_MT) {
                         if (set_threads(optarg)) {
                             bad_usage.message = "Invalid Number of Threads";
                             bad_usage.optarg = optarg;
 
+                            return PO_BAD_USAGE;
+                        }
+                    } else if (options.subtype == MT_MBW_MR) {
+                        if (set_receiver_threads(atoi(optarg))) {
+                            bad_usage.message = "Invalid Number of Threads";
+                            bad_usage.optarg = optarg;
+
                             return PO_BAD_USAGE;
                         }
                     } else if (options.subtype == LAT_MP) {
@@ -1019,6 +1273,47 @@ int process_options(int argc, char *argv[])
                 return PO_BAD_USAGE;
 #endif
                 break;
+            case 'e':
+#ifdef _ENABLE_PERF_EVENT_
+                options.perf_enabled = 1;
+#else
+                bad_usage.message = "Invalid option. perf_event counters are"
+                                    " only supported on Linux.";
+                bad_usage.opt = optopt;
+                return PO_BAD_USAGE;
+#endif
+                break;
+            case 'M':
+                options.mpit_pvars_enabled = 1;
+                if (NULL == optarg) {
+                    break;
+                }
+                if (strlen(optarg) >= OMB_MPIT_FILTER_MAX_LENGTH) {
+                    bad_usage.message = "MPI_T variable filter too long";
+                    bad_usage.optarg = optarg;
+
+                    return PO_BAD_USAGE;
+                }
+                strcpy(options.omb_mpit_pvar_filter, optarg);
+                break;
+            case 'C':
+                if (strlen(optarg) >= OMB_TUNE_COLL_NAME_LENGTH) {
+                    bad_usage.message = "Invalid Collective";
+                    bad_usage.optarg = optarg;
+
+                    return PO_BAD_USAGE;
+                }
+                strcpy(options.omb_tune_coll, optarg);
+                break;
+            case 'o':
+                if (strlen(optarg) >= OMB_FILE_PATH_MAX_LENGTH) {
+                    bad_usage.message = "Tuning file path too long";
+                    bad_usage.optarg = optarg;
+
+                    return PO_BAD_USAGE;
+                }
+                strcpy(options.omb_tune_file, optarg);
+                break;
             case 'u':
                 if (set_num_warmup_validation(atoi(optarg))) {
                     bad_usage.message = "Invalid Number of Validation Warmup "
@@ -1035,6 +1330,398 @@ int process_options(int argc, char *argv[])
                     return PO_BAD_USAGE;
                 }
                 break;
+            case 'A':
+                if (0 == strcasecmp(optarg, "exact")) {
+                    options.match_pattern = OMB_MATCH_EXACT;
+                } else if (0 == strcasecmp(optarg, "any_tag")) {
+                    options.match_pattern = OMB_MATCH_ANY_TAG;
+                } else if (0 == strcasecmp(optarg, "any_source")) {
+                    options.match_pattern = OMB_MATCH_ANY_SOURCE;
+                } else if (0 == strcasecmp(optarg, "random")) {
+                    options.match_pattern = OMB_MATCH_RANDOM_TAG;
+                } else {
+                    bad_usage.message = "Please use 'exact', 'any_tag',"
+                                        " 'any_source' or 'random' for the"
+                                        " match pattern";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'L':
+                if (0 == strcasecmp(optarg, "last")) {
+                    options.match_position = OMB_MATCH_LAST;
+                } else if (0 == strcasecmp(optarg, "random")) {
+                    options.match_position = OMB_MATCH_RANDOM;
+                } else {
+                    bad_usage.message =
+                        "Please use 'last' or 'random' for the match position";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'S':
+                skew_type = strtok(optarg, ":");
+                skew_value = strtok(NULL, ":");
+                if (NULL == skew_type || NULL == skew_value ||
+                    0 > atof(skew_value)) {
+                    bad_usage.message = "Please pass the skew type and"
+                                        " delay. E.g: -S late:100\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                options.skew_delay = atof(skew_value);
+                skew_value = strtok(NULL, ":");
+                if (0 == strncasecmp(skew_type, "late", 4)) {
+                    options.skew_type = OMB_SKEW_LATE;
+                    options.skew_arg = skew_value ? atoi(skew_value) : -1;
+                } else if (0 == strncasecmp(skew_type, "random", 6)) {
+                    options.skew_type = OMB_SKEW_RANDOM;
+                    options.skew_arg =
+                        skew_value ? atof(skew_value) : OMB_SKEW_RANDOM_PERCENT;
+                } else if (0 == strncasecmp(skew_type, "gauss", 5)) {
+                    options.skew_type = OMB_SKEW_GAUSS;
+                    options.skew_arg =
+                        skew_value ? atof(skew_value) : options.skew_delay / 2;
+                } else if (0 == strncasecmp(skew_type, "exp", 3)) {
+                    options.skew_type = OMB_SKEW_EXP;
+                } else {
+                    bad_usage.message = "Invalid skew type. Valid"
+                                        " types[late, random, gauss, exp]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'g':
+                carve_type = strtok(optarg, ":");
+                if (NULL == carve_type) {
+                    bad_usage.message = "Please pass the carve-up type."
+                                        " E.g: -g spread:2,8,32\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(carve_type, "dense", 5)) {
+                    options.carve_type = OMB_CARVE_DENSE;
+                } else if (0 == strncasecmp(carve_type, "spread", 6)) {
+                    options.carve_type = OMB_CARVE_SPREAD;
+                } else {
+                    bad_usage.message = "Invalid carve-up type. Valid"
+                                        " types[dense, spread]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                options.num_comm_sizes = 0;
+                comm_size = strtok(NULL, ",");
+                while (NULL != comm_size) {
+                    if (OMB_MAX_COMM_SIZES == options.num_comm_sizes ||
+                        2 > atoi(comm_size)) {
+                        bad_usage.message = "Invalid communicator size list."
+                                            " Sizes must be at least 2\n";
+                        bad_usage.optarg = comm_size;
+                        return PO_BAD_USAGE;
+                    }
+                    options.comm_sizes[options.num_comm_sizes++] =
+                        atoi(comm_size);
+                    comm_size = strtok(NULL, ",");
+                }
+                break;
+            case 'F':
+                traffic_type = strtok(optarg, ":");
+                traffic_arg = strtok(NULL, "");
+                if (NULL == traffic_type) {
+                    bad_usage.message = "Please pass the traffic pattern."
+                                        " E.g: -F random:7\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(traffic_type, "random", 7)) {
+                    options.traffic_pattern = OMB_TRAFFIC_RANDOM;
+                } else if (0 == strncasecmp(traffic_type, "bitrev", 7)) {
+                    options.traffic_pattern = OMB_TRAFFIC_BITREV;
+                } else if (0 == strncasecmp(traffic_type, "transpose", 10)) {
+                    options.traffic_pattern = OMB_TRAFFIC_TRANSPOSE;
+                } else if (0 == strncasecmp(traffic_type, "ring", 5)) {
+                    options.traffic_pattern = OMB_TRAFFIC_RING;
+                } else if (0 == strncasecmp(traffic_type, "tornado", 8)) {
+                    options.traffic_pattern = OMB_TRAFFIC_TORNADO;
+                } else if (0 == strncasecmp(traffic_type, "shuffle", 8)) {
+                    options.traffic_pattern = OMB_TRAFFIC_SHUFFLE;
+                } else if (0 == strncasecmp(traffic_type, "file", 5)) {
+                    options.traffic_pattern = OMB_TRAFFIC_FILE;
+                    if (NULL == traffic_arg ||
+                        OMB_FILE_PATH_MAX_LENGTH <= strlen(traffic_arg)) {
+                        bad_usage.message = "Please pass the path of the"
+                                            " pattern matrix. E.g: -F"
+                                            " file:/path/to/matrix\n";
+                        bad_usage.optarg = optarg;
+                        return PO_BAD_USAGE;
+                    }
+                    strcpy(options.traffic_file, traffic_arg);
+                } else {
+                    bad_usage.message = "Invalid traffic pattern. Valid"
+                                        " patterns[random, bitrev, transpose,"
+                                        " ring, tornado, shuffle, file]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (NULL != traffic_arg &&
+                    (OMB_TRAFFIC_RANDOM == options.traffic_pattern ||
+                     OMB_TRAFFIC_SHUFFLE == options.traffic_pattern)) {
+                    options.traffic_seed = atoi(traffic_arg);
+                }
+                break;
+            case 'Y':
+                victim_type = strtok(optarg, ":");
+                congestor_type = strtok(NULL, ":");
+                if (NULL == victim_type || NULL == congestor_type) {
+                    bad_usage.message = "Please pass the victim and the"
+                                        " congestor. E.g: -Y allreduce:incast\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(victim_type, "allreduce", 10)) {
+                    options.victim_kernel = OMB_VICTIM_ALLREDUCE;
+                } else if (0 == strncasecmp(victim_type, "pingpong", 9)) {
+                    options.victim_kernel = OMB_VICTIM_PINGPONG;
+                } else {
+                    bad_usage.message = "Invalid victim. Valid"
+                                        " victims[allreduce, pingpong]\n";
+                    bad_usage.optarg = victim_type;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(congestor_type, "incast", 7)) {
+                    options.congestor = OMB_CONGESTOR_INCAST;
+                } else if (0 == strncasecmp(congestor_type, "alltoall", 9)) {
+                    options.congestor = OMB_CONGESTOR_ALLTOALL;
+                } else if (0 == strncasecmp(congestor_type, "put", 4)) {
+                    options.congestor = OMB_CONGESTOR_PUT;
+                } else {
+                    bad_usage.message = "Invalid congestor. Valid"
+                                        " congestors[incast, alltoall, put]\n";
+                    bad_usage.optarg = congestor_type;
+                    return PO_BAD_USAGE;
+                }
+                interference_arg = strtok(NULL, ":");
+                if (NULL != interference_arg) {
+                    options.victim_pct = atoi(interference_arg);
+                    if (1 > options.victim_pct || 99 < options.victim_pct) {
+                        bad_usage.message = "The victim percentage must be"
+                                            " between 1 and 99\n";
+                        bad_usage.optarg = interference_arg;
+                        return PO_BAD_USAGE;
+                    }
+                    interference_arg = strtok(NULL, ":");
+                }
+                if (NULL != interference_arg) {
+                    if (1 > atol(interference_arg)) {
+                        bad_usage.message = "Invalid congestor message size\n";
+                        bad_usage.optarg = interference_arg;
+                        return PO_BAD_USAGE;
+                    }
+                    options.congestor_size = atol(interference_arg);
+                }
+                break;
+            case 'B':
+                split_type = strtok(optarg, ":");
+                split_arg = strtok(NULL, "");
+                if (NULL == split_type) {
+                    bad_usage.message = "Please pass the node split."
+                                        " E.g: -B random:20\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(split_type, "random", 7)) {
+                    options.bisection_split = OMB_BISECTION_RANDOM;
+                    split_arg = strtok(split_arg, ":");
+                    if (NULL != split_arg) {
+                        options.num_splits = atoi(split_arg);
+                        if (1 > options.num_splits) {
+                            bad_usage.message = "The number of splits must be"
+                                                " at least 1\n";
+                            bad_usage.optarg = split_arg;
+                            return PO_BAD_USAGE;
+                        }
+                        split_arg = strtok(NULL, ":");
+                    }
+                    if (NULL != split_arg) {
+                        options.bisection_seed = atoi(split_arg);
+                    }
+                } else if (0 == strncasecmp(split_type, "name", 5)) {
+                    options.bisection_split = OMB_BISECTION_NAME;
+                    options.num_splits = 1;
+                } else if (0 == strncasecmp(split_type, "file", 5)) {
+                    options.bisection_split = OMB_BISECTION_FILE;
+                    options.num_splits = 1;
+                    if (NULL == split_arg ||
+                        OMB_FILE_PATH_MAX_LENGTH <= strlen(split_arg)) {
+                        bad_usage.message = "Please pass the path of the"
+                                            " host list. E.g: -B"
+                                            " file:/path/to/hosts\n";
+                        bad_usage.optarg = optarg;
+                        return PO_BAD_USAGE;
+                    }
+                    strcpy(options.bisection_file, split_arg);
+                } else {
+                    bad_usage.message = "Invalid node split. Valid"
+                                        " splits[random, name, file]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'j':
+                group_type = strtok(optarg, ":");
+                group_arg = strtok(NULL, ":");
+                if (NULL == group_type) {
+                    bad_usage.message = "Please pass the group pattern."
+                                        " E.g: -j row:4\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(group_type, "node", 5)) {
+                    options.group_pattern = OMB_GROUP_NODE;
+                } else if (0 == strncasecmp(group_type, "stride", 7)) {
+                    options.group_pattern = OMB_GROUP_STRIDE;
+                } else if (0 == strncasecmp(group_type, "row", 4)) {
+                    options.group_pattern = OMB_GROUP_ROW;
+                } else if (0 == strncasecmp(group_type, "col", 4)) {
+                    options.group_pattern = OMB_GROUP_COL;
+                } else {
+                    bad_usage.message = "Invalid group pattern. Valid"
+                                        " patterns[node, stride, row, col]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (NULL != group_arg) {
+                    options.group_arg = atoi(group_arg);
+                    if (1 > options.group_arg) {
+                        bad_usage.message = "The number of groups or grid"
+                                            " columns must be at least 1\n";
+                        bad_usage.optarg = group_arg;
+                        return PO_BAD_USAGE;
+                    }
+                }
+                break;
+            case 'H':
+                affinity_type = strtok(optarg, ":");
+                affinity_arg = strtok(NULL, "");
+                if (NULL == affinity_type) {
+                    bad_usage.message = "Please pass the binding policy."
+                                        " E.g: -H compact\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(affinity_type, "none", 5)) {
+                    options.affinity_policy = OMB_AFFINITY_NONE;
+                } else if (0 == strncasecmp(affinity_type, "compact", 8)) {
+                    options.affinity_policy = OMB_AFFINITY_COMPACT;
+                } else if (0 == strncasecmp(affinity_type, "scatter", 8)) {
+                    options.affinity_policy = OMB_AFFINITY_SCATTER;
+                } else if (0 == strncasecmp(affinity_type, "socket", 7)) {
+                    if (NULL == affinity_arg || 0 > atoi(affinity_arg)) {
+                        bad_usage.message = "Please pass the socket."
+                                            " E.g: -H socket:1\n";
+                        bad_usage.optarg = optarg;
+                        return PO_BAD_USAGE;
+                    }
+                    options.affinity_socket = atoi(affinity_arg);
+                    options.affinity_policy = OMB_AFFINITY_SOCKET;
+                } else if (0 == strncasecmp(affinity_type, "cores", 6)) {
+                    if (NULL == affinity_arg ||
+                        OMB_AFFINITY_CPUS_MAX_LENGTH <= strlen(affinity_arg) ||
+                        strspn(affinity_arg, "0123456789,-") !=
+                            strlen(affinity_arg)) {
+                        bad_usage.message = "Please pass the CPU list."
+                                            " E.g: -H cores:0-3,8\n";
+                        bad_usage.optarg = optarg;
+                        return PO_BAD_USAGE;
+                    }
+                    strcpy(options.affinity_cpus, affinity_arg);
+                    options.affinity_policy = OMB_AFFINITY_CORES;
+                } else {
+                    bad_usage.message = "Invalid binding policy. Valid"
+                                        " policies[none, compact, scatter,"
+                                        " socket, cores]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'E':
+                buffer_type = strtok(optarg, ":");
+                buffer_arg = strtok(NULL, "");
+                if (NULL == buffer_type) {
+                    bad_usage.message = "Please pass the buffer policy."
+                                        " E.g: -E rotate:256\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (0 == strncasecmp(buffer_type, "reuse", 6)) {
+                    options.buffer_policy = OMB_BUFFER_REUSE;
+                } else if (0 == strncasecmp(buffer_type, "rotate", 7)) {
+                    if (NULL != buffer_arg && 1 > atoi(buffer_arg)) {
+                        bad_usage.message = "The registration cache size in"
+                                            " MB must be at least 1\n";
+                        bad_usage.optarg = optarg;
+                        return PO_BAD_USAGE;
+                    }
+                    if (NULL != buffer_arg) {
+                        options.buffer_cache_mb = atoi(buffer_arg);
+                    }
+                    options.buffer_policy = OMB_BUFFER_ROTATE;
+                } else if (0 == strncasecmp(buffer_type, "malloc", 7)) {
+                    options.buffer_policy = OMB_BUFFER_MALLOC;
+                } else if (0 == strncasecmp(buffer_type, "mmap", 5)) {
+                    options.buffer_policy = OMB_BUFFER_MMAP;
+                } else {
+                    bad_usage.message = "Invalid buffer policy. Valid"
+                                        " policies[reuse, rotate, malloc,"
+                                        " mmap]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (OMB_BUFFER_REUSE != options.buffer_policy &&
+                    !options.buffer_policies) {
+                    bad_usage.message = "This benchmark only supports the"
+                                        " reuse buffer policy\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'U':
+                if (0 >= omb_atosize(optarg)) {
+                    bad_usage.message = "Please pass the memory limit in"
+                                        " bytes. E.g: -U 64G\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                options.max_mem_limit = omb_atosize(optarg);
+                break;
+            case 'X':
+                contention_threads = strtok(optarg, ":");
+                contention_mb = strtok(NULL, "");
+                if (NULL == contention_threads ||
+                    1 > atoi(contention_threads) ||
+                    MAX_NUM_THREADS <= atoi(contention_threads)) {
+                    bad_usage.message = "Please pass the number of streaming"
+                                        " threads(1-127). E.g: -X 2:64\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (NULL != contention_mb && 1 > atoi(contention_mb)) {
+                    bad_usage.message = "The array size in MB must be at"
+                                        " least 1\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                if (!options.contention) {
+                    bad_usage.message = "This benchmark does not support"
+                                        " memory contention\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                options.contention_threads = atoi(contention_threads);
+                if (NULL != contention_mb) {
+                    options.contention_mb = atoi(contention_mb);
+                }
+                break;
             case 'b':
                 if (0 == strncasecmp(optarg, "single", 10)) {
                     options.buf_num = SINGLE;
@@ -1094,16 +1781,62 @@ int process_options(int argc, char *argv[])
                 }
                 break;
             case 'T':
+                if (0 == strncasecmp(optarg, "ALL", 3)) {
+                    dtype_all = 1;
+                    break;
+                }
+                if (OMB_NUM_DATATYPES == options.omb_dtype_itr) {
+                    bad_usage.message = "Too many datatypes";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
                 if (0 == strncasecmp(optarg, "MPI_CHAR", 8)) {
                     options.omb_dtype_list[options.omb_dtype_itr++] = OMB_CHAR;
+                } else if (0 == strncasecmp(optarg, "MPI_INT64_T", 11)) {
+                    options.omb_dtype_list[options.omb_dtype_itr++] = OMB_INT64;
                 } else if (0 == strncasecmp(optarg, "MPI_INT", 7)) {
                     options.omb_dtype_list[options.omb_dtype_itr++] = OMB_INT;
                 } else if (0 == strncasecmp(optarg, "MPI_FLOAT", 9)) {
                     options.omb_dtype_list[options.omb_dtype_itr++] = OMB_FLOAT;
-                } else if (0 == strncasecmp(optarg, "ALL", 3)) {
-                    options.omb_dtype_list[options.omb_dtype_itr++] = OMB_CHAR;
-                    options.omb_dtype_list[options.omb_dtype_itr++] = OMB_INT;
-                    options.omb_dtype_list[options.omb_dtype_itr++] = OMB_FLOAT;
+                } else if (0 == strncasecmp(optarg, "MPI_DOUBLE", 10)) {
+                    options.omb_dtype_list[options.omb_dtype_itr++] =
+                        OMB_DOUBLE;
+                } else if (0 == strncasecmp(optarg, "MPI_C_DOUBLE_COMPLEX",
+                                            20)) {
+                    options.omb_dtype_list[options.omb_dtype_itr++] =
+                        OMB_DOUBLE_COMPLEX;
+                } else if (0 == strncasecmp(optarg, "BF16", 4)) {
+                    options.omb_dtype_list[options.omb_dtype_itr++] =
+                        OMB_BFLOAT16;
+                } else if (0 == strncasecmp(optarg, "MPI_2INT", 8)) {
+                    options.omb_dtype_list[options.omb_dtype_itr++] = OMB_2INT;
+                } else {
+                    bad_usage.message = "Invalid datatype";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
+                }
+                break;
+            case 'O':
+                if (0 == strncasecmp(optarg, "sum", 4)) {
+                    options.reduce_op = OMB_OP_SUM;
+                } else if (0 == strncasecmp(optarg, "max", 4)) {
+                    options.reduce_op = OMB_OP_MAX;
+                } else if (0 == strncasecmp(optarg, "minloc", 7)) {
+                    options.reduce_op = OMB_OP_MINLOC;
+                } else if (0 == strncasecmp(optarg, "min", 4)) {
+                    options.reduce_op = OMB_OP_MIN;
+                } else if (0 == strncasecmp(optarg, "prod", 5)) {
+                    options.reduce_op = OMB_OP_PROD;
+                } else if (0 == strncasecmp(optarg, "band", 5)) {
+                    options.reduce_op = OMB_OP_BAND;
+                } else if (0 == strncasecmp(optarg, "user", 5)) {
+                    options.reduce_op = OMB_OP_USER;
+                } else {
+                    bad_usage.message = "Invalid reduction operator. Valid"
+                                        " operators[sum, max, min, prod, band,"
+                                        " minloc, user]\n";
+                    bad_usage.optarg = optarg;
+                    return PO_BAD_USAGE;
                 }
                 break;
             case 'I':
@@ -1173,20 +1906,32 @@ int process_options(int argc, char *argv[])
         options.warmup_validation = 0;
     }
 
+    if (dtype_all) {
+        options.omb_dtype_itr = 0;
+        for (itr = OMB_CHAR; itr <= OMB_2INT; itr++) {
+            if (!omb_dtype_supported(itr)) {
+                options.omb_dtype_list[options.omb_dtype_itr++] = itr;
+            }
+        }
+    }
     if (0 == options.omb_dtype_itr) {
-        if (REDUCE == options.subtype || REDUCE_SCATTER == options.subtype ||
-            ALL_REDUCE == options.subtype ||
-            NBC_ALL_REDUCE == options.subtype ||
-            NBC_REDUCE == options.subtype ||
-            NBC_REDUCE_SCATTER == options.subtype ||
-            ALL_REDUCE_P == options.subtype || REDUCE_P == options.subtype ||
-            REDUCE_SCATTER_P == options.subtype) {
+        if (OMB_OP_MINLOC == options.reduce_op) {
+            options.omb_dtype_list[options.omb_dtype_itr] = OMB_2INT;
+        } else if (is_reduction_subtype()) {
             options.omb_dtype_list[options.omb_dtype_itr] = OMB_INT;
         } else {
             options.omb_dtype_list[options.omb_dtype_itr] = OMB_CHAR;
         }
         options.omb_dtype_itr++;
     }
+    for (itr = 0; itr < options.omb_dtype_itr; itr++) {
+        bad_usage.message = omb_dtype_supported(options.omb_dtype_list[itr]);
+        if (NULL != bad_usage.message) {
+            bad_usage.opt = 'T';
+            bad_usage.optarg = NULL;
+            return PO_BAD_USAGE;
+        }
+    }
 
     if (accel_enabled) {
         if ((optind + 2) == argc) {
@@ -1251,6 +1996,26 @@ int process_options(int argc, char *argv[])
             return PO_BAD_USAGE;
         }
     }
+    if (OMB_BUFFER_REUSE != options.buffer_policy) {
+        bad_usage.opt = 'E';
+        bad_usage.optarg = NULL;
+        if (NONE != options.accel) {
+            bad_usage.message = "Buffer policies other than reuse support"
+                                " host buffers only";
+            return PO_BAD_USAGE;
+        }
+        if (MULTIPLE == options.buf_num) {
+            bad_usage.message = "Buffer policies other than reuse cannot be"
+                                " combined with -b multiple";
+            return PO_BAD_USAGE;
+        }
+    }
+    if (options.contention_threads && options.window_varied) {
+        bad_usage.message = "Memory contention cannot be combined with -V";
+        bad_usage.opt = 'X';
+        bad_usage.optarg = NULL;
+        return PO_BAD_USAGE;
+    }
 
     return PO_OKAY;
 }
@@ -1416,4 +2181,73 @@ void wtime(double *t)
     *t = (tv.tv_sec - sec) * 1.0e+6 + tv.tv_usec;
 }
 
+/*
+ * Returns the resident set size of the calling process in bytes, or 0 when it
+ * cannot be determined on this platform.
+ */
+size_t omb_get_resident_memory(void)
+{
+    size_t resident = 0;
+#ifdef __linux__
+    unsigned long vm_pages = 0, rss_pages = 0;
+    FILE *fp = NULL;
+
+    fp = fopen("/proc/self/statm", "r");
+    if (NULL == fp) {
+        return 0;
+    }
+    if (2 == fscanf(fp, "%lu %lu", &vm_pages, &rss_pages)) {
+        resident = (size_t)rss_pages * sysconf(_SC_PAGESIZE);
+    }
+    fclose(fp);
+#endif
+    return resident;
+}
+
+/*
+ * Reports the cpu the calling thread currently runs on, together with the
+ * socket and NUMA node of that cpu. Values that cannot be determined on this
+ * platform are set to -1.
+ */
+void omb_get_cpu_location(int *cpu, int *socket, int *numa_node)
+{
+    *cpu = *socket = *numa_node = -1;
+#ifdef __linux__
+    unsigned int c = 0, node = 0;
+    char path[OMB_FILE_PATH_MAX_LENGTH];
+    FILE *fp = NULL;
+
+    if (0 != syscall(SYS_getcpu, &c, &node, NULL)) {
+        return;
+    }
+    *cpu = c;
+    *numa_node = node;
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", c);
+    fp = fopen(path, "r");
+    if (NULL != fp) {
+        if (1 != fscanf(fp, "%d", socket)) {
+            *socket = -1;
+        }
+        fclose(fp);
+    }
+#endif
+}
+
+/*
+ * Returns the NUMA node holding the page that contains addr, or -1 when it
+ * cannot be determined. The page must have been touched already.
+ */
+int omb_get_mem_numa_node(void *addr)
+{
+    int node = -1;
+#ifdef __linux__
+    /* MPOL_F_NODE | MPOL_F_ADDR from <numaif.h> */
+    if (0 != syscall(SYS_get_mempolicy, &node, NULL, 0, addr, 3)) {
+        node = -1;
+    }
+#endif
+    return node;
+}
+
 /* vi:set sw=4 sts=4 tw=80: */
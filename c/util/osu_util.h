@@ -39,6 +39,10 @@
 #include <papi.h>
 #endif
 
+#ifdef __linux__
+#define _ENABLE_PERF_EVENT_ 1
+#endif
+
 #ifdef _ENABLE_CUDA_
 #include "cuda.h"
 #include "cuda_runtime.h"
@@ -172,7 +176,7 @@ void allocate_host_arrays();
 
 enum mpi_req { MAX_REQ_NUM = 1000 };
 
-#define OMB_LONG_OPTIONS_ARRAY_SIZE     30
+#define OMB_LONG_OPTIONS_ARRAY_SIZE     46
 #define BW_LOOP_SMALL                   100
 #define BW_SKIP_SMALL                   10
 #define BW_LOOP_LARGE                   20
@@ -192,6 +196,8 @@ enum mpi_req { MAX_REQ_NUM = 1000 };
 #define OSHM_LOOP_SMALL_MR              500
 #define OSHM_LOOP_LARGE_MR              50
 #define OSHM_LOOP_ATOMIC                500
+#define STARTUP_LOOP                    100
+#define STARTUP_SKIP                    10
 #define VALIDATION_SKIP_DEFAULT         5
 #define VALIDATION_SKIP_MAX             10
 #define OMB_DDT_STRIDE_DEFAULT          8
@@ -199,10 +205,22 @@ enum mpi_req { MAX_REQ_NUM = 1000 };
 #define OMB_FILE_PATH_MAX_LENGTH        1024
 #define OMB_NHBRHD_FILE_PATH_MAX_LENGTH OMB_FILE_PATH_MAX_LENGTH
 #define OMB_DDT_FILE_PATH_MAX_LENGTH    OMB_FILE_PATH_MAX_LENGTH
+#define OMB_TUNE_COLL_NAME_LENGTH       32
+#define OMB_MPIT_FILTER_MAX_LENGTH      256
+#define OMB_AFFINITY_CPUS_MAX_LENGTH    256
+#define OMB_CONTENTION_MB_DEFAULT       32
+#define OMB_BUFFER_CACHE_MB_DEFAULT     256
 #define OMB_VALIDATION_LOG_DIR_PATH     "validation_output"
 #define MAX_MESSAGE_SIZE                (1 << 22)
 #define MAX_MSG_SIZE_PT2PT              (1 << 20)
 #define MAX_MSG_SIZE_COLL               (1 << 20)
+#define MAX_MATCH_QUEUE_DEPTH           (1 << 17)
+#define MAX_MSG_SIZE_REDUCE_LOCAL       (1 << 26)
+#define MAX_MSG_SIZE_CONG_IMPACT        (1 << 12)
+#define MAX_MSG_SIZE_MT_MBW_MR          (1 << 6)
+#define OMB_CONGESTOR_SIZE_DEFAULT      (1 << 17)
+#define OMB_VICTIM_PCT_DEFAULT          20
+#define OMB_BISECTION_SPLITS_DEFAULT    10
 #define MIN_MESSAGE_SIZE                1
 #define LARGE_MESSAGE_SIZE              8192
 #define MAX_ALIGNMENT                   65536
@@ -212,10 +230,14 @@ enum mpi_req { MAX_REQ_NUM = 1000 };
 #define ONESBUFSIZE                     ((MAX_MESSAGE_SIZE * WINDOW_SIZE_LARGE) + MAX_ALIGNMENT)
 #define MESSAGE_ALIGNMENT               64
 #define MESSAGE_ALIGNMENT_MR            (1 << 12)
-#define OMB_NUM_DATATYPES               3
+#define OMB_NUM_DATATYPES               8
 #define OMB_DATATYPE_STR_MAX_LEN        128
 #define OMB_ROOT_ROTATE_VAL             -1
 #define OMB_STAT_MAX_NUM                5
+#define OMB_SKEW_SEED                   1234
+#define OMB_SKEW_RANDOM_PERCENT         10
+#define OMB_PI                          3.14159265358979323846
+#define OMB_MAX_COMM_SIZES              32
 #define DEFAULT_NUM_PARTITIONS          8
 enum po_ret_type {
     PO_CUDA_NOT_AVAIL,
@@ -279,7 +301,24 @@ enum test_subtype {
     REDUCE_P,
     ALL_REDUCE_P,
     BCAST_P,
-    CONG_BW
+    CONG_BW,
+    OBJ_CREATE,
+    SHM_WIN_LAT,
+    SHM_WIN_BW,
+    SHM_BASELINE_LAT,
+    SHM_BASELINE_BW,
+    PT2PT_OVERLAP,
+    LOGGP,
+    COLL_AUTOTUNE,
+    MATCHING,
+    COLL_SCALING,
+    REDUCE_LOCAL,
+    CONG_PATTERN,
+    CONG_IMPACT,
+    CONG_BISECTION,
+    COLL_CONCURRENT,
+    MT_MBW_MR,
+    COLL_MT
 };
 
 enum test_synctype { ALL_SYNC, ACTIVE_SYNC };
@@ -288,7 +327,8 @@ enum WINDOW {
     WIN_CREATE = 0,
 #if MPI_VERSION >= 3
     WIN_ALLOCATE,
-    WIN_DYNAMIC
+    WIN_DYNAMIC,
+    WIN_ALLOCATE_SHARED
 #endif
 };
 
@@ -326,11 +366,121 @@ typedef struct omb_nhbrhd_type_parameters {
     char filepath[OMB_NHBRHD_FILE_PATH_MAX_LENGTH];
 } omb_nhbrhd_type_parameters_t;
 
+/*Message matching patterns*/
+enum omb_match_patterns_t {
+    OMB_MATCH_EXACT,
+    OMB_MATCH_ANY_TAG,
+    OMB_MATCH_ANY_SOURCE,
+    OMB_MATCH_RANDOM_TAG
+};
+
+/*Matched queue entry*/
+enum omb_match_positions_t { OMB_MATCH_LAST, OMB_MATCH_RANDOM };
+
+/*Arrival skew distributions*/
+enum omb_skew_types_t {
+    OMB_SKEW_NONE,
+    OMB_SKEW_LATE,
+    OMB_SKEW_RANDOM,
+    OMB_SKEW_GAUSS,
+    OMB_SKEW_EXP
+};
+
+/*Order in which sub-communicators take ranks from the nodes*/
+enum omb_carve_types_t { OMB_CARVE_DENSE, OMB_CARVE_SPREAD };
+
+/*Traffic patterns of osu_bw_pattern*/
+enum omb_traffic_patterns_t {
+    OMB_TRAFFIC_RANDOM,
+    OMB_TRAFFIC_BITREV,
+    OMB_TRAFFIC_TRANSPOSE,
+    OMB_TRAFFIC_RING,
+    OMB_TRAFFIC_TORNADO,
+    OMB_TRAFFIC_SHUFFLE,
+    OMB_TRAFFIC_FILE
+};
+
+/*Latency-sensitive kernels and congestors of osu_cong_impact*/
+enum omb_victim_kernels_t { OMB_VICTIM_ALLREDUCE, OMB_VICTIM_PINGPONG };
+enum omb_congestors_t {
+    OMB_CONGESTOR_INCAST,
+    OMB_CONGESTOR_ALLTOALL,
+    OMB_CONGESTOR_PUT
+};
+
+/*How osu_bisection splits the nodes into two halves*/
+enum omb_bisection_splits_t {
+    OMB_BISECTION_RANDOM,
+    OMB_BISECTION_NAME,
+    OMB_BISECTION_FILE
+};
+
+/*Collectives selected by name with -C*/
+enum omb_colls_t {
+    OMB_COLL_ALLGATHER,
+    OMB_COLL_ALLREDUCE,
+    OMB_COLL_ALLTOALL,
+    OMB_COLL_BARRIER,
+    OMB_COLL_BCAST,
+    OMB_COLL_GATHER,
+    OMB_COLL_REDUCE,
+    OMB_COLL_REDUCE_SCATTER,
+    OMB_COLL_SCATTER,
+    OMB_COLL_NUM
+};
+
+/*Disjoint groups of osu_coll_concurrent*/
+enum omb_group_patterns_t {
+    OMB_GROUP_NODE,
+    OMB_GROUP_STRIDE,
+    OMB_GROUP_ROW,
+    OMB_GROUP_COL
+};
+
+/*Where -H binds the processes and their threads*/
+enum omb_affinity_policies_t {
+    OMB_AFFINITY_UNSET,
+    OMB_AFFINITY_NONE,
+    OMB_AFFINITY_COMPACT,
+    OMB_AFFINITY_SCATTER,
+    OMB_AFFINITY_SOCKET,
+    OMB_AFFINITY_CORES
+};
+
+/*Buffers each iteration uses under -E*/
+enum omb_buffer_policies_t {
+    OMB_BUFFER_REUSE,
+    OMB_BUFFER_ROTATE,
+    OMB_BUFFER_MALLOC,
+    OMB_BUFFER_MMAP
+};
+
 /*variables*/
 extern char const *win_info[20];
 extern char const *sync_info[20];
 
-enum omb_dtypes_t { OMB_DTYPE_NULL, OMB_CHAR, OMB_INT, OMB_FLOAT };
+enum omb_dtypes_t {
+    OMB_DTYPE_NULL,
+    OMB_CHAR,
+    OMB_INT,
+    OMB_FLOAT,
+    OMB_DOUBLE,
+    OMB_INT64,
+    OMB_DOUBLE_COMPLEX,
+    OMB_BFLOAT16,
+    OMB_2INT
+};
+
+/*Reduction operators*/
+enum omb_reduce_ops_t {
+    OMB_OP_SUM,
+    OMB_OP_MAX,
+    OMB_OP_MIN,
+    OMB_OP_PROD,
+    OMB_OP_BAND,
+    OMB_OP_MINLOC,
+    OMB_OP_USER
+};
 
 struct options_t {
     enum accel_type accel;
@@ -385,11 +535,49 @@ struct options_t {
     omb_nhbrhd_type_parameters_t nhbrhd_type_parameters;
     int omb_dtype_itr;
     enum omb_dtypes_t omb_dtype_list[OMB_NUM_DATATYPES];
+    enum omb_reduce_ops_t reduce_op;
     int papi_enabled;
+    int perf_enabled;
+    int mpit_pvars_enabled;
     int omb_enable_session;
     int omb_enable_mpi_in_place;
     int omb_root_rank;
     int omb_tail_lat;
+    char omb_tune_coll[OMB_TUNE_COLL_NAME_LENGTH];
+    char omb_tune_file[OMB_FILE_PATH_MAX_LENGTH];
+    char omb_mpit_pvar_filter[OMB_MPIT_FILTER_MAX_LENGTH];
+    enum omb_match_patterns_t match_pattern;
+    enum omb_match_positions_t match_position;
+    enum omb_skew_types_t skew_type;
+    double skew_delay;
+    double skew_arg;
+    enum omb_carve_types_t carve_type;
+    int num_comm_sizes;
+    int comm_sizes[OMB_MAX_COMM_SIZES];
+    enum omb_traffic_patterns_t traffic_pattern;
+    unsigned int traffic_seed;
+    char traffic_file[OMB_FILE_PATH_MAX_LENGTH];
+    enum omb_victim_kernels_t victim_kernel;
+    enum omb_congestors_t congestor;
+    int victim_pct;
+    size_t congestor_size;
+    enum omb_bisection_splits_t bisection_split;
+    int num_splits;
+    unsigned int bisection_seed;
+    char bisection_file[OMB_FILE_PATH_MAX_LENGTH];
+    enum omb_group_patterns_t group_pattern;
+    int group_arg;
+    enum omb_affinity_policies_t affinity_policy;
+    int affinity_socket;
+    char affinity_cpus[OMB_AFFINITY_CPUS_MAX_LENGTH];
+    int contention_threads;
+    size_t contention_mb;
+    int contention;
+    size_t max_mem_limit;
+    int large_count;
+    enum omb_buffer_policies_t buffer_policy;
+    size_t buffer_cache_mb;
+    int buffer_policies;
     int log_validation;
     char log_validation_dir_path[OMB_FILE_PATH_MAX_LENGTH];
     int omb_stat_percentiles[OMB_STAT_MAX_NUM];
@@ -432,6 +620,9 @@ void set_benchmark_name(const char *name);
 void enable_accel_support(void);
 
 #define DEF_NUM_THREADS 2
+#define DEF_NUM_THREADS_MR 8
+#define DEF_NUM_THREADS_COLL 4
+#define DEF_NUM_PROBES  8
 #define MIN_NUM_THREADS 1
 #define MAX_NUM_THREADS 128
 
@@ -447,5 +638,8 @@ void enable_accel_support(void);
 #define WINDOW_SIZES_COUNT (8)
 
 void wtime(double *t);
+size_t omb_get_resident_memory(void);
+void omb_get_cpu_location(int *cpu, int *socket, int *numa_node);
+int omb_get_mem_numa_node(void *addr);
 
 #endif
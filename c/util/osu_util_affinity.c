@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "osu_util_mpi.h"
+#ifdef __linux__
+#include <dirent.h>
+#include <errno.h>
+#include <sched.h>
+#endif
+
+static const char *omb_affinity_names[] = {"", "none", "compact", "scatter",
+                                           "socket", "cores"};
+
+/* One row of the map printed in the preamble. */
+typedef struct omb_affinity_record {
+    char host[MPI_MAX_PROCESSOR_NAME];
+    char cpus[OMB_AFFINITY_STR_LEN];
+    char numa[OMB_AFFINITY_STR_LEN];
+} omb_affinity_record_t;
+
+static omb_affinity_record_t *omb_affinity_map = NULL;
+static int omb_affinity_map_size = 0;
+
+#ifdef __linux__
+/* CPUs this process binds to, slot i for the i-th thread of the benchmark. */
+static int omb_affinity_slot_cpus[CPU_SETSIZE];
+static int omb_affinity_num_slots = 0;
+
+/*
+ * Number of CPUs a process needs: one per thread or forked process the
+ * benchmark starts, -X streaming threads included, plus the main process
+ * where it keeps communicating.
+ */
+static int omb_affinity_slots(void)
+{
+    switch (options.subtype) {
+        case LAT_MT:
+            return MAX(options.num_threads, options.sender_thread);
+        case LAT_MP:
+            return 1 + MAX(options.num_processes, options.sender_processes);
+        case MT_MBW_MR:
+        case COLL_MT:
+            return options.num_threads;
+        case PT2PT_OVERLAP:
+            return 2;
+        default:
+            return 1 + options.contention_threads;
+    }
+}
+
+/* Parses a Linux CPU list such as "0-3,8,10-11" into set. */
+static int omb_affinity_parse_list(const char *list, cpu_set_t *set,
+                                   int *order, int *count)
+{
+    const char *p = list;
+    char *end = NULL;
+    long first = 0, last = 0, i = 0;
+
+    CPU_ZERO(set);
+    *count = 0;
+    while (*p && '\n' != *p) {
+        first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= CPU_SETSIZE) {
+            return -1;
+        }
+        last = first;
+        p = end;
+        if ('-' == *p) {
+            last = strtol(++p, &end, 10);
+            if (end == p || last < first || last >= CPU_SETSIZE) {
+                return -1;
+            }
+            p = end;
+        }
+        for (i = first; i <= last; i++) {
+            if (order && !CPU_ISSET(i, set)) {
+                order[(*count)++] = i;
+            }
+            CPU_SET(i, set);
+        }
+        if (',' == *p) {
+            p++;
+        }
+    }
+    return 0;
+}
+
+/* Formats set back into the shortest CPU list. */
+static void omb_affinity_format_list(cpu_set_t *set, char *str, size_t len)
+{
+    int i = 0, last = 0;
+    size_t used = 0;
+
+    str[0] = '\0';
+    for (i = 0; i < CPU_SETSIZE && used < len; i++) {
+        if (!CPU_ISSET(i, set)) {
+            continue;
+        }
+        for (last = i; last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set);
+             last++)
+            ;
+        if (last > i) {
+            used += snprintf(str + used, len - used, "%s%d-%d",
+                             used ? "," : "", i, last);
+        } else {
+            used += snprintf(str + used, len - used, "%s%d", used ? "," : "",
+                             i);
+        }
+        i = last;
+    }
+}
+
+/* Reads one line of a sysfs file, 0 on success. */
+static int omb_affinity_read_sysfs(const char *path, char *buf, int len)
+{
+    FILE *fp = fopen(path, "r");
+    int ret = -1;
+
+    if (NULL == fp) {
+        return -1;
+    }
+    if (fgets(buf, len, fp)) {
+        ret = 0;
+    }
+    fclose(fp);
+    return ret;
+}
+
+static int omb_affinity_package(int cpu)
+{
+    char path[OMB_FILE_PATH_MAX_LENGTH], buf[OMB_AFFINITY_STR_LEN];
+
+    snprintf(path, sizeof(path),
+             "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+    return omb_affinity_read_sysfs(path, buf, sizeof(buf)) ? 0 : atoi(buf);
+}
+
+/* Sets the NUMA nodes of the CPUs in cpus as bits of nodes. */
+static void omb_affinity_numa(cpu_set_t *cpus, cpu_set_t *nodes)
+{
+    char path[OMB_FILE_PATH_MAX_LENGTH];
+    char buf[OMB_AFFINITY_CPUS_MAX_LENGTH];
+    struct dirent *entry = NULL;
+    cpu_set_t node_cpus, common;
+    int node = 0, count = 0;
+    DIR *dir = opendir("/sys/devices/system/node");
+
+    CPU_ZERO(nodes);
+    if (NULL == dir) {
+        return;
+    }
+    while (NULL != (entry = readdir(dir))) {
+        if (1 != sscanf(entry->d_name, "node%d", &node) || node < 0 ||
+            node >= CPU_SETSIZE) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+                 node);
+        if (omb_affinity_read_sysfs(path, buf, sizeof(buf)) ||
+            omb_affinity_parse_list(buf, &node_cpus, NULL, &count)) {
+            continue;
+        }
+        CPU_AND(&common, &node_cpus, cpus);
+        if (CPU_COUNT(&common)) {
+            CPU_SET(node, nodes);
+        }
+    }
+    closedir(dir);
+}
+
+/*
+ * Fills the candidate CPUs of the policy in the order slots are taken from
+ * them and returns the first slot of the process.
+ */
+static int omb_affinity_pool(int local_rank, int slots, int *pool, int *count)
+{
+    char buf[OMB_AFFINITY_CPUS_MAX_LENGTH];
+    int online[CPU_SETSIZE], packages[CPU_SETSIZE];
+    int num_online = 0, num_packages = 0, package = 0, i = 0, j = 0;
+    cpu_set_t set;
+
+    if (OMB_AFFINITY_CORES == options.affinity_policy) {
+        if (omb_affinity_parse_list(options.affinity_cpus, &set, pool,
+                                    count) ||
+            0 == *count) {
+            OMB_ERROR_EXIT("Invalid CPU list");
+        }
+        return local_rank * slots;
+    }
+    if (omb_affinity_read_sysfs("/sys/devices/system/cpu/online", buf,
+                                sizeof(buf)) ||
+        omb_affinity_parse_list(buf, &set, online, &num_online)) {
+        num_online = 0;
+        sched_getaffinity(0, sizeof(set), &set);
+        for (i = 0; i < CPU_SETSIZE; i++) {
+            if (CPU_ISSET(i, &set)) {
+                online[num_online++] = i;
+            }
+        }
+    }
+    if (0 == num_online) {
+        OMB_ERROR_EXIT("No online CPUs");
+    }
+    for (i = 0; i < num_online; i++) {
+        packages[i] = omb_affinity_package(online[i]);
+        num_packages = MAX(num_packages, packages[i] + 1);
+    }
+
+    switch (options.affinity_policy) {
+        case OMB_AFFINITY_SCATTER:
+            package = local_rank % num_packages;
+            break;
+        case OMB_AFFINITY_SOCKET:
+            package = options.affinity_socket;
+            break;
+        default:
+            package = -1;
+            break;
+    }
+    /* compact takes the packages one after the other */
+    *count = 0;
+    for (j = 0; j < num_packages; j++) {
+        for (i = 0; i < num_online; i++) {
+            if (packages[i] == j && (package < 0 || package == j)) {
+                pool[(*count)++] = online[i];
+            }
+        }
+    }
+    if (0 == *count) {
+        OMB_ERROR_EXIT("No CPUs on the requested socket");
+    }
+    if (OMB_AFFINITY_SCATTER == options.affinity_policy) {
+        return (local_rank / num_packages) * slots;
+    }
+    return local_rank * slots;
+}
+
+/* Binds the calling thread to set and warns if the kernel disagrees. */
+static void omb_affinity_apply(cpu_set_t *set, const char *who, int id)
+{
+    char want[OMB_AFFINITY_STR_LEN], got[OMB_AFFINITY_STR_LEN];
+    cpu_set_t actual;
+
+    omb_affinity_format_list(set, want, sizeof(want));
+    if (sched_setaffinity(0, sizeof(cpu_set_t), set)) {
+        fprintf(stderr, "Warning: could not bind %s %d to CPUs %s: %s\n", who,
+                id, want, strerror(errno));
+        return;
+    }
+    CPU_ZERO(&actual);
+    sched_getaffinity(0, sizeof(actual), &actual);
+    if (!CPU_EQUAL(&actual, set)) {
+        omb_affinity_format_list(&actual, got, sizeof(got));
+        fprintf(stderr, "Warning: %s %d runs on CPUs %s instead of %s\n", who,
+                id, got, want);
+    }
+}
+#endif /* #ifdef __linux__ */
+
+/*
+ * Binds the calling process to the CPUs of its threads following -H and
+ * gathers the resulting placement of all processes of comm for the preamble.
+ * Collective over comm; does nothing without -H.
+ */
+void omb_affinity_init(MPI_Comm comm)
+{
+    int rank = 0, size = 0, local_rank = 0, first = 0, num_pool = 0, i = 0;
+    int name_len = 0, wrapped = 0, any_wrapped = 0;
+    char name[MPI_MAX_PROCESSOR_NAME];
+    omb_affinity_record_t record;
+#ifdef __linux__
+    int pool[CPU_SETSIZE];
+    cpu_set_t set, nodes;
+    MPI_Comm node_comm = MPI_COMM_NULL;
+#endif
+
+    if (OMB_AFFINITY_UNSET == options.affinity_policy) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Comm_size(comm, &size));
+    MPI_CHECK(MPI_Get_processor_name(name, &name_len));
+    memset(&record, 0, sizeof(record));
+    snprintf(record.host, sizeof(record.host), "%s", name);
+    snprintf(record.cpus, sizeof(record.cpus), "-");
+    snprintf(record.numa, sizeof(record.numa), "-");
+
+#ifdef __linux__
+#if MPI_VERSION >= 3
+    MPI_CHECK(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                                  &node_comm));
+    MPI_CHECK(MPI_Comm_rank(node_comm, &local_rank));
+    MPI_CHECK(MPI_Comm_free(&node_comm));
+#endif
+    if (OMB_AFFINITY_NONE != options.affinity_policy) {
+        omb_affinity_num_slots = omb_affinity_slots();
+        first = omb_affinity_pool(local_rank, omb_affinity_num_slots, pool,
+                                  &num_pool);
+        CPU_ZERO(&set);
+        for (i = 0; i < omb_affinity_num_slots; i++) {
+            omb_affinity_slot_cpus[i] = pool[(first + i) % num_pool];
+            CPU_SET(omb_affinity_slot_cpus[i], &set);
+        }
+        omb_affinity_apply(&set, "rank", rank);
+        /* slots past the end of the pool wrap around onto CPUs in use */
+        wrapped = first + omb_affinity_num_slots > num_pool;
+        MPI_CHECK(MPI_Allreduce(&wrapped, &any_wrapped, 1, MPI_INT, MPI_MAX,
+                                comm));
+        if (0 == rank && any_wrapped) {
+            fprintf(stderr,
+                    "Warning: -H %s needs more CPUs than are available,"
+                    " some processes or threads share a CPU\n",
+                    omb_affinity_names[options.affinity_policy]);
+        }
+    }
+    CPU_ZERO(&set);
+    if (0 == sched_getaffinity(0, sizeof(set), &set)) {
+        omb_affinity_format_list(&set, record.cpus, sizeof(record.cpus));
+        omb_affinity_numa(&set, &nodes);
+        if (CPU_COUNT(&nodes)) {
+            omb_affinity_format_list(&nodes, record.numa, sizeof(record.numa));
+        }
+    }
+#endif
+
+    if (0 == rank) {
+        omb_affinity_map = malloc(size * sizeof(omb_affinity_record_t));
+        OMB_CHECK_NULL_AND_EXIT(omb_affinity_map, "Unable to allocate memory");
+        omb_affinity_map_size = size;
+    }
+    MPI_CHECK(MPI_Gather(&record, sizeof(record), MPI_CHAR, omb_affinity_map,
+                         sizeof(record), MPI_CHAR, 0, comm));
+}
+
+/*
+ * Binds the calling thread, or forked process, to slot id of its process so
+ * that the threads of a benchmark do not share a CPU.
+ */
+void omb_affinity_bind_thread(int id)
+{
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (0 == omb_affinity_num_slots) {
+        return;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(omb_affinity_slot_cpus[id % omb_affinity_num_slots], &set);
+    omb_affinity_apply(&set, "thread", id);
+#endif
+}
+
+/* Prints and releases the map gathered by omb_affinity_init at rank 0. */
+void omb_affinity_print_map(void)
+{
+    int i = 0;
+
+    if (NULL == omb_affinity_map) {
+        return;
+    }
+    if (OMB_AFFINITY_NONE == options.affinity_policy) {
+        fprintf(stdout, "# Affinity: as placed by the launcher\n");
+    } else if (OMB_AFFINITY_SOCKET == options.affinity_policy) {
+        fprintf(stdout, "# Affinity: socket %d\n", options.affinity_socket);
+    } else {
+        fprintf(stdout, "# Affinity: %s\n",
+                omb_affinity_names[options.affinity_policy]);
+    }
+    fprintf(stdout, "# %6s  %-24s %-16s %s\n", "Rank", "Host", "CPUs",
+            "NUMA");
+    for (i = 0; i < omb_affinity_map_size; i++) {
+        fprintf(stdout, "# %6d  %-24s %-16s %s\n", i,
+                omb_affinity_map[i].host, omb_affinity_map[i].cpus,
+                omb_affinity_map[i].numa);
+    }
+    free(omb_affinity_map);
+    omb_affinity_map = NULL;
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+
+#define OMB_AFFINITY_STR_LEN 64
+
+void omb_affinity_init(MPI_Comm comm);
+void omb_affinity_bind_thread(int id);
+void omb_affinity_print_map(void);
@@ -9,6 +9,7 @@
  */
 
 #include "osu_util_mpi.h"
+#include <sys/mman.h>
 
 MPI_Request request[MAX_REQ_NUM];
 MPI_Status reqstat[MAX_REQ_NUM];
@@ -34,6 +35,36 @@ static float a[DIM][DIM], x[DIM], y[DIM];
 #define CHAR_VALIDATION_MULTIPLIER  (char)7
 #define CHAR_RANGE                  (int)pow(2, __CHAR_BIT__)
 
+/* Created on first use by the reduction benchmarks */
+static MPI_Datatype omb_bf16_type = MPI_DATATYPE_NULL;
+static MPI_Op omb_user_op = MPI_OP_NULL;
+static char const *omb_reduce_op_names[] = {"sum",  "max",    "min", "prod",
+                                            "band", "minloc", "user"};
+
+/* Streaming threads of -X, created on the first contended measurement */
+enum omb_contention_states_t {
+    OMB_CONTENTION_PARKED,
+    OMB_CONTENTION_RUN,
+    OMB_CONTENTION_QUIT
+};
+static pthread_t omb_contention_threads[MAX_NUM_THREADS];
+static int omb_contention_ids[MAX_NUM_THREADS];
+static int omb_contention_created = 0;
+static int omb_contention_streaming = 0;
+static int omb_contention_state = OMB_CONTENTION_PARKED;
+static pthread_mutex_t omb_contention_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t omb_contention_cond = PTHREAD_COND_INITIALIZER;
+static volatile double omb_contention_sink = 0.0;
+
+/* Buffers handed out by omb_buffer_policy_next under -E */
+static void *omb_buffer_saved[2] = {NULL, NULL};
+static void *omb_buffer_fresh[2] = {NULL, NULL};
+static size_t omb_buffer_fresh_size = 0;
+static char *omb_buffer_pool[2] = {NULL, NULL};
+static size_t omb_buffer_pool_size = 0;
+static size_t omb_buffer_pool_next = 0;
+static int omb_buffer_swapped = 0;
+
 #ifdef _ENABLE_CUDA_
 CUcontext cuContext;
 #endif
@@ -43,6 +74,7 @@ char const *win_info[20] = {
 #if MPI_VERSION >= 3
     "MPI_Win_allocate",
     "MPI_Win_create_dynamic",
+    "MPI_Win_allocate_shared",
 #endif
 };
 
@@ -179,6 +211,8 @@ int process_one_sided_options(int opt, char *arg)
                 options.win = WIN_ALLOCATE;
             } else if (0 == strcasecmp(arg, "dynamic")) {
                 options.win = WIN_DYNAMIC;
+            } else if (0 == strcasecmp(arg, "allocate_shared")) {
+                options.win = WIN_ALLOCATE_SHARED;
             } else
 #endif
             {
@@ -370,6 +404,7 @@ void print_header_one_sided(int rank, enum WINDOW win, enum SYNC sync,
                 printf(benchmark_header, "");
                 break;
         }
+        omb_affinity_print_map();
         fprintf(stdout, "# Window creation: %s\n", win_info[win]);
         fprintf(stdout, "# Synchronization: %s\n", sync_info[sync]);
         MPI_CHECK(MPI_Type_get_name(dtype, dtype_name_str, &dtype_name_size));
@@ -482,6 +517,7 @@ void print_preamble_nbc(int rank)
             break;
     }
 
+    omb_affinity_print_map();
     fprintf(stdout,
             "# Overall = Coll. Init + Compute + MPI_Test + MPI_Wait\n\n");
 
@@ -583,6 +619,62 @@ void print_preamble(int rank)
             printf(benchmark_header, "");
             break;
     }
+    omb_affinity_print_map();
+    switch (options.skew_type) {
+        case OMB_SKEW_LATE:
+            if (0 > options.skew_arg) {
+                fprintf(stdout, "# Arrival skew: last rank %.2f us late\n",
+                        options.skew_delay);
+            } else {
+                fprintf(stdout, "# Arrival skew: rank %d %.2f us late\n",
+                        (int)options.skew_arg, options.skew_delay);
+            }
+            break;
+        case OMB_SKEW_RANDOM:
+            fprintf(stdout,
+                    "# Arrival skew: %.2f%% of the ranks %.2f us late\n",
+                    options.skew_arg, options.skew_delay);
+            break;
+        case OMB_SKEW_GAUSS:
+            fprintf(stdout, "# Arrival skew: normal, mean %.2f us, stddev"
+                            " %.2f us\n",
+                    options.skew_delay, options.skew_arg);
+            break;
+        case OMB_SKEW_EXP:
+            fprintf(stdout, "# Arrival skew: exponential, mean %.2f us\n",
+                    options.skew_delay);
+            break;
+        default:
+            break;
+    }
+    if (OMB_SKEW_NONE != options.skew_type) {
+        fprintf(stdout, "# Latency excludes the largest delay of every"
+                        " iteration\n");
+    }
+    if (OMB_OP_SUM != options.reduce_op) {
+        fprintf(stdout, "# Reduction operator: %s\n",
+                omb_reduce_op_names[options.reduce_op]);
+    }
+    if (options.contention_threads) {
+        fprintf(stdout, "# Memory contention: %d streaming threads per"
+                        " process, %zu MB per array\n",
+                options.contention_threads, options.contention_mb);
+    }
+    switch (options.buffer_policy) {
+        case OMB_BUFFER_ROTATE:
+            fprintf(stdout, "# Buffer policy: rotate through %zu MB per"
+                            " buffer\n",
+                    options.buffer_cache_mb);
+            break;
+        case OMB_BUFFER_MALLOC:
+            fprintf(stdout, "# Buffer policy: malloc/free every iteration\n");
+            break;
+        case OMB_BUFFER_MMAP:
+            fprintf(stdout, "# Buffer policy: mmap/munmap every iteration\n");
+            break;
+        default:
+            break;
+    }
     fflush(stdout);
 }
 
@@ -651,6 +743,9 @@ void print_only_header(int rank)
     if (options.omb_enable_ddt) {
         fprintf(stdout, "%*s", FIELD_WIDTH, "Transmit Size");
     }
+    if (options.contention_threads) {
+        fprintf(stdout, "%*s", FIELD_WIDTH, "Contended (MB/s)");
+    }
     fprintf(stdout, "\n");
     fflush(stdout);
 }
@@ -675,12 +770,14 @@ omb_mpi_init_data omb_mpi_init(int *argc, char ***argv)
                 wgroup, OMB_MPI_SESSION_GROUP_NAME, MPI_INFO_NULL,
                 MPI_ERRORS_RETURN, &init_struct.omb_comm));
             MPI_CHECK(MPI_Group_free(&wgroup));
+            omb_affinity_init(init_struct.omb_comm);
             return init_struct;
         }
 #endif
     } else {
         MPI_CHECK(MPI_Init(argc, argv));
         init_struct.omb_comm = MPI_COMM_WORLD;
+        omb_affinity_init(init_struct.omb_comm);
         return init_struct;
     }
     return init_struct;
@@ -688,6 +785,29 @@ omb_mpi_init_data omb_mpi_init(int *argc, char ***argv)
 
 void omb_mpi_finalize(omb_mpi_init_data mpi_init)
 {
+    int i = 0;
+
+    if (omb_contention_created) {
+        pthread_mutex_lock(&omb_contention_mutex);
+        __atomic_store_n(&omb_contention_state, OMB_CONTENTION_QUIT,
+                         __ATOMIC_RELEASE);
+        pthread_cond_broadcast(&omb_contention_cond);
+        pthread_mutex_unlock(&omb_contention_mutex);
+        for (i = 0; i < omb_contention_created; i++) {
+            pthread_join(omb_contention_threads[i], NULL);
+        }
+        omb_contention_created = 0;
+    }
+    for (i = 0; i < 2; i++) {
+        free(omb_buffer_pool[i]);
+        omb_buffer_pool[i] = NULL;
+    }
+    if (MPI_OP_NULL != omb_user_op) {
+        MPI_CHECK(MPI_Op_free(&omb_user_op));
+    }
+    if (MPI_DATATYPE_NULL != omb_bf16_type) {
+        MPI_CHECK(MPI_Type_free(&omb_bf16_type));
+    }
     if (1 == options.omb_enable_session) {
 #ifdef _ENABLE_MPI4_
         MPI_CHECK(MPI_Comm_free(&mpi_init.omb_comm));
@@ -698,6 +818,316 @@ void omb_mpi_finalize(omb_mpi_init_data mpi_init)
     }
 }
 
+/*
+ * Body of a streaming thread. It runs a STREAM triad over three private
+ * arrays while the state is OMB_CONTENTION_RUN and sleeps on the condition
+ * variable otherwise, so it costs nothing outside the contended loops.
+ */
+static void *omb_contention_stream(void *arg)
+{
+    int id = *(int *)arg;
+    size_t n = options.contention_mb * 1024 * 1024 / sizeof(double);
+    size_t i = 0, end = 0;
+    double *a = NULL, *b = NULL, *c = NULL;
+
+    omb_affinity_bind_thread(1 + id);
+    a = malloc(n * sizeof(double));
+    b = malloc(n * sizeof(double));
+    c = malloc(n * sizeof(double));
+    OMB_CHECK_NULL_AND_EXIT(a, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(b, "Unable to allocate memory");
+    OMB_CHECK_NULL_AND_EXIT(c, "Unable to allocate memory");
+    for (i = 0; i < n; i++) {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+
+    pthread_mutex_lock(&omb_contention_mutex);
+    while (1) {
+        while (OMB_CONTENTION_PARKED == omb_contention_state) {
+            pthread_cond_wait(&omb_contention_cond, &omb_contention_mutex);
+        }
+        if (OMB_CONTENTION_QUIT == omb_contention_state) {
+            break;
+        }
+        omb_contention_streaming++;
+        pthread_cond_broadcast(&omb_contention_cond);
+        pthread_mutex_unlock(&omb_contention_mutex);
+        i = 0;
+        while (OMB_CONTENTION_RUN ==
+               __atomic_load_n(&omb_contention_state, __ATOMIC_ACQUIRE)) {
+            end = MIN(i + OMB_CONTENTION_CHUNK, n);
+            for (; i < end; i++) {
+                a[i] = b[i] + 3.0 * c[i];
+            }
+            if (n == i) {
+                i = 0;
+            }
+        }
+        omb_contention_sink += a[n / 2];
+        pthread_mutex_lock(&omb_contention_mutex);
+        omb_contention_streaming--;
+        pthread_cond_broadcast(&omb_contention_cond);
+    }
+    pthread_mutex_unlock(&omb_contention_mutex);
+    free(a);
+    free(b);
+    free(c);
+    return NULL;
+}
+
+/*
+ * Wakes the -X streaming threads and returns once all of them stream. The
+ * threads are created on the first call and the calling thread is bound to
+ * the first slot of the process so that it never shares a CPU with them.
+ */
+void omb_mem_contention_start(void)
+{
+    int i = 0;
+
+    if (0 == options.contention_threads) {
+        return;
+    }
+    pthread_mutex_lock(&omb_contention_mutex);
+    if (0 == omb_contention_created) {
+        omb_affinity_bind_thread(0);
+        for (i = 0; i < options.contention_threads; i++) {
+            omb_contention_ids[i] = i;
+            if (pthread_create(&omb_contention_threads[i], NULL,
+                               omb_contention_stream,
+                               &omb_contention_ids[i])) {
+                OMB_ERROR_EXIT("Unable to create streaming thread");
+            }
+        }
+        omb_contention_created = options.contention_threads;
+    }
+    __atomic_store_n(&omb_contention_state, OMB_CONTENTION_RUN,
+                     __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&omb_contention_cond);
+    while (omb_contention_streaming < omb_contention_created) {
+        pthread_cond_wait(&omb_contention_cond, &omb_contention_mutex);
+    }
+    pthread_mutex_unlock(&omb_contention_mutex);
+}
+
+/* Parks the streaming threads again. */
+void omb_mem_contention_stop(void)
+{
+    if (0 == omb_contention_created) {
+        return;
+    }
+    pthread_mutex_lock(&omb_contention_mutex);
+    __atomic_store_n(&omb_contention_state, OMB_CONTENTION_PARKED,
+                     __ATOMIC_RELEASE);
+    while (0 < omb_contention_streaming) {
+        pthread_cond_wait(&omb_contention_cond, &omb_contention_mutex);
+    }
+    pthread_mutex_unlock(&omb_contention_mutex);
+}
+
+/* Allocates and touches a buffer for the malloc and mmap policies of -E. */
+static void *omb_buffer_fresh_alloc(size_t size, char data)
+{
+    void *buffer = NULL;
+
+    if (OMB_BUFFER_MMAP == options.buffer_policy) {
+        buffer = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == buffer) {
+            buffer = NULL;
+        }
+    } else {
+        buffer = malloc(size);
+    }
+    OMB_CHECK_NULL_AND_EXIT(buffer, "Unable to allocate memory");
+    memset(buffer, data, size);
+    return buffer;
+}
+
+static void omb_buffer_fresh_free(void **buffers, size_t size)
+{
+    int i = 0;
+
+    for (i = 0; i < 2; i++) {
+        if (NULL == buffers[i]) {
+            continue;
+        }
+        if (OMB_BUFFER_MMAP == options.buffer_policy) {
+            munmap(buffers[i], size);
+        } else {
+            free(buffers[i]);
+        }
+        buffers[i] = NULL;
+    }
+}
+
+/*
+ * Points *s_buf and *r_buf at the buffers of the next iteration under -E.
+ * Either may be NULL to leave that side alone, e.g. the send buffer of an
+ * in-place collective. Call it at the start of every iteration, outside the
+ * timed region. rotate walks page aligned slots of two regions larger than
+ * the registration cache so that no slot is reused before the cache had to
+ * evict it; malloc and mmap hand out new buffers and only then release the
+ * previous ones, so consecutive iterations never share an address. The
+ * allocator may still return the buffers released one iteration earlier.
+ */
+void omb_buffer_policy_next(void **s_buf, void **r_buf, size_t size)
+{
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t stride = 0, slots = 0;
+    void *previous[2] = {NULL, NULL};
+    size_t previous_size = 0;
+    int i = 0;
+
+    if (OMB_BUFFER_REUSE == options.buffer_policy) {
+        return;
+    }
+    /* Validation fills the whole buffer the benchmark allocated */
+    if (options.validate) {
+        size = MAX(size, options.max_message_size);
+    }
+    if (0 == size) {
+        size = 1;
+    }
+    if (!omb_buffer_swapped) {
+        omb_buffer_saved[0] = s_buf ? *s_buf : NULL;
+        omb_buffer_saved[1] = r_buf ? *r_buf : NULL;
+        omb_buffer_swapped = 1;
+    }
+    if (OMB_BUFFER_ROTATE == options.buffer_policy) {
+        stride = (size + page - 1) / page * page;
+        slots = options.buffer_cache_mb * 1024 * 1024 / stride + 1;
+        if (NULL == omb_buffer_pool[0]) {
+            omb_buffer_pool_size = options.buffer_cache_mb * 1024 * 1024 +
+                                   (options.max_message_size + page - 1) /
+                                       page * page;
+            for (i = 0; i < 2; i++) {
+                if (posix_memalign((void **)&omb_buffer_pool[i], page,
+                                   omb_buffer_pool_size)) {
+                    OMB_ERROR_EXIT("Unable to allocate memory");
+                }
+                memset(omb_buffer_pool[i], i ? 'b' : 'a',
+                       omb_buffer_pool_size);
+            }
+        }
+        omb_buffer_pool_next = (omb_buffer_pool_next + 1) % slots;
+        if (s_buf) {
+            *s_buf = omb_buffer_pool[0] + omb_buffer_pool_next * stride;
+        }
+        if (r_buf) {
+            *r_buf = omb_buffer_pool[1] + omb_buffer_pool_next * stride;
+        }
+        return;
+    }
+    for (i = 0; i < 2; i++) {
+        previous[i] = omb_buffer_fresh[i];
+        omb_buffer_fresh[i] = NULL;
+    }
+    previous_size = omb_buffer_fresh_size;
+    omb_buffer_fresh_size = size;
+    if (s_buf) {
+        omb_buffer_fresh[0] = omb_buffer_fresh_alloc(size, 'a');
+        *s_buf = omb_buffer_fresh[0];
+    }
+    if (r_buf) {
+        omb_buffer_fresh[1] = omb_buffer_fresh_alloc(size, 'b');
+        *r_buf = omb_buffer_fresh[1];
+    }
+    omb_buffer_fresh_free(previous, previous_size);
+}
+
+/*
+ * Releases the buffers of omb_buffer_policy_next and restores the buffers of
+ * the benchmark. Call it at the end of every message size.
+ */
+void omb_buffer_policy_reset(void **s_buf, void **r_buf)
+{
+    if (!omb_buffer_swapped) {
+        return;
+    }
+    omb_buffer_fresh_free(omb_buffer_fresh, omb_buffer_fresh_size);
+    if (s_buf) {
+        *s_buf = omb_buffer_saved[0];
+    }
+    if (r_buf) {
+        *r_buf = omb_buffer_saved[1];
+    }
+    omb_buffer_swapped = 0;
+}
+
+/*
+ * Window bandwidth of num_pairs pairs, rank i sending to rank i + num_pairs
+ * (in both directions if bidir), while the streaming threads of every
+ * process run. It is a plain Isend/Irecv window without validation, graphs
+ * or tail statistics. Returns the aggregate MB/s at rank 0.
+ */
+double omb_contended_bw(MPI_Comm comm, int num_pairs, int bidir, char *s_buf,
+                        char *r_buf, size_t count, MPI_Datatype dtype,
+                        size_t bytes)
+{
+    int rank = 0, peer = 0, sender = 0;
+    int i = 0, j = 0, window_size = options.window_size;
+    double t_start = 0.0, t_elapsed = 0.0, t_max = 0.0;
+    MPI_Request *reqs = NULL;
+
+    reqs = malloc(sizeof(MPI_Request) * 2 * window_size);
+    OMB_CHECK_NULL_AND_EXIT(reqs, "Unable to allocate memory");
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    sender = rank < num_pairs;
+    peer = sender ? rank + num_pairs : rank - num_pairs;
+    omb_mem_contention_start();
+    MPI_CHECK(MPI_Barrier(comm));
+    if (rank < 2 * num_pairs) {
+        for (i = 0; i < options.iterations + options.skip; i++) {
+            if (i == options.skip) {
+                t_start = MPI_Wtime();
+            }
+            if (bidir) {
+                for (j = 0; j < window_size; j++) {
+                    MPI_CHECK(OMB_MPI_LARGE(
+                        MPI_Irecv, count,
+                        (r_buf, count, dtype, peer, 10, comm, reqs + j)));
+                }
+                for (j = 0; j < window_size; j++) {
+                    MPI_CHECK(OMB_MPI_LARGE(MPI_Isend, count,
+                                            (s_buf, count, dtype, peer, 10,
+                                             comm, reqs + window_size + j)));
+                }
+                MPI_CHECK(MPI_Waitall(2 * window_size, reqs,
+                                      MPI_STATUSES_IGNORE));
+            } else if (sender) {
+                for (j = 0; j < window_size; j++) {
+                    MPI_CHECK(OMB_MPI_LARGE(
+                        MPI_Isend, count,
+                        (s_buf, count, dtype, peer, 100, comm, reqs + j)));
+                }
+                MPI_CHECK(MPI_Waitall(window_size, reqs, MPI_STATUSES_IGNORE));
+                MPI_CHECK(MPI_Recv(r_buf, 1, MPI_CHAR, peer, 101, comm,
+                                   MPI_STATUS_IGNORE));
+            } else {
+                for (j = 0; j < window_size; j++) {
+                    MPI_CHECK(OMB_MPI_LARGE(
+                        MPI_Irecv, count,
+                        (r_buf, count, dtype, peer, 100, comm, reqs + j)));
+                }
+                MPI_CHECK(MPI_Waitall(window_size, reqs, MPI_STATUSES_IGNORE));
+                MPI_CHECK(MPI_Send(s_buf, 1, MPI_CHAR, peer, 101, comm));
+            }
+        }
+        t_elapsed = MPI_Wtime() - t_start;
+    }
+    omb_mem_contention_stop();
+    free(reqs);
+    MPI_CHECK(
+        MPI_Reduce(&t_elapsed, &t_max, 1, MPI_DOUBLE, MPI_MAX, 0, comm));
+    if (0 != rank || 0.0 == t_max) {
+        return 0.0;
+    }
+    return bytes / 1e6 * window_size * options.iterations * num_pairs *
+           (bidir ? 2 : 1) / t_max;
+}
+
 int omb_ascending_cmp_double(const void *a, const void *b)
 {
     double v1 = *(const double *)a;
@@ -887,7 +1317,7 @@ void print_stats_nbc(int rank, int size, double overall_time, double cpu_time,
     fflush(stdout);
 }
 
-void print_stats(int rank, int size, double avg_time, double min_time,
+void print_stats(int rank, size_t size, double avg_time, double min_time,
                  double max_time, struct omb_stat_t omb_stats)
 {
     int itr = 0;
@@ -897,7 +1327,7 @@ void print_stats(int rank, int size, double avg_time, double min_time,
     }
 
     if (options.show_size) {
-        fprintf(stdout, "%-*d", 10, size);
+        fprintf(stdout, "%-*zu", 10, size);
         fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION, avg_time);
     } else {
         fprintf(stdout, "%*.*f", 17, FLOAT_PRECISION, avg_time);
@@ -923,8 +1353,8 @@ void print_stats(int rank, int size, double avg_time, double min_time,
     fflush(stdout);
 }
 
-void print_stats_validate(int rank, int size, double avg_time, double min_time,
-                          double max_time, int errors,
+void print_stats_validate(int rank, size_t size, double avg_time,
+                          double min_time, double max_time, int errors,
                           struct omb_stat_t omb_stats)
 {
     int itr = 0;
@@ -934,7 +1364,7 @@ void print_stats_validate(int rank, int size, double avg_time, double min_time,
     }
 
     if (options.show_size) {
-        fprintf(stdout, "%-*d", 10, size);
+        fprintf(stdout, "%-*zu", 10, size);
         fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION, avg_time);
     } else {
         fprintf(stdout, "%*.*f", 17, FLOAT_PRECISION, avg_time);
@@ -973,9 +1403,82 @@ int omb_get_root_rank(int itr, size_t comm_size)
     return itr % comm_size;
 }
 
+/* Uniform random number in (0, 1) from a sequence shared by all ranks. */
+static double omb_skew_uniform(void)
+{
+    static unsigned int seed = OMB_SKEW_SEED;
+
+    return (rand_r(&seed) + 1.0) / ((double)RAND_MAX + 2.0);
+}
+
+/* Draws the arrival delay of one rank in us. */
+static double omb_skew_draw(void)
+{
+    double delay = 0.0, u1 = 0.0, u2 = 0.0;
+
+    switch (options.skew_type) {
+        case OMB_SKEW_RANDOM:
+            if (100 * omb_skew_uniform() < options.skew_arg) {
+                delay = options.skew_delay;
+            }
+            break;
+        case OMB_SKEW_GAUSS:
+            u1 = omb_skew_uniform();
+            u2 = omb_skew_uniform();
+            delay = options.skew_delay + options.skew_arg *
+                                             sqrt(-2.0 * log(u1)) *
+                                             cos(2.0 * OMB_PI * u2);
+            delay = MAX(delay, 0.0);
+            break;
+        case OMB_SKEW_EXP:
+            delay = -options.skew_delay * log(omb_skew_uniform());
+            break;
+        default:
+            break;
+    }
+    return delay;
+}
+
+/*
+ * Busy-waits for the arrival delay of this rank in the current iteration and
+ * returns the largest delay of all ranks in seconds, which the caller
+ * subtracts from the collective time. All ranks draw the delays of all ranks
+ * from the same sequence, so no communication is needed.
+ */
+double omb_skew_inject(int rank, int numprocs)
+{
+    int i = 0, late_rank = 0;
+    double t_start = 0.0, delay = 0.0, own = 0.0, largest = 0.0;
+
+    if (OMB_SKEW_NONE == options.skew_type) {
+        return 0.0;
+    }
+    t_start = MPI_Wtime();
+    if (OMB_SKEW_LATE == options.skew_type) {
+        late_rank = (0 > options.skew_arg) ? numprocs - 1 : options.skew_arg;
+        if (late_rank >= numprocs) {
+            OMB_ERROR_EXIT(
+                "Late rank(\'-S\') cannot be more than number of processes");
+        }
+        own = (rank == late_rank) ? options.skew_delay : 0.0;
+        largest = options.skew_delay;
+    } else {
+        for (i = 0; i < numprocs; i++) {
+            delay = omb_skew_draw();
+            if (i == rank) {
+                own = delay;
+            }
+            largest = MAX(largest, delay);
+        }
+    }
+    while ((MPI_Wtime() - t_start) * 1e6 < own) {
+    }
+    return largest * 1e-6;
+}
+
 void omb_populate_mpi_type_list(MPI_Datatype *mpi_type_list)
 {
-    int i = 0;
+    int i = 0, mpi_initialized = 0;
     for (i = 0; i < OMB_NUM_DATATYPES; i++) {
         switch (options.omb_dtype_list[i]) {
             case OMB_DTYPE_NULL:
@@ -990,6 +1493,31 @@ void omb_populate_mpi_type_list(MPI_Datatype *mpi_type_list)
             case OMB_FLOAT:
                 mpi_type_list[i] = MPI_FLOAT;
                 break;
+            case OMB_DOUBLE:
+                mpi_type_list[i] = MPI_DOUBLE;
+                break;
+            case OMB_INT64:
+                mpi_type_list[i] = MPI_INT64_T;
+                break;
+            case OMB_DOUBLE_COMPLEX:
+                mpi_type_list[i] = MPI_C_DOUBLE_COMPLEX;
+                break;
+            case OMB_BFLOAT16:
+                /*
+                 * A derived type, so it needs MPI to be initialized. The
+                 * benchmarks that populate before MPI_Init reject it anyway.
+                 */
+                MPI_CHECK(MPI_Initialized(&mpi_initialized));
+                if (MPI_DATATYPE_NULL == omb_bf16_type && mpi_initialized) {
+                    MPI_CHECK(MPI_Type_contiguous(2, MPI_BYTE, &omb_bf16_type));
+                    MPI_CHECK(MPI_Type_set_name(omb_bf16_type, "OMB_BFLOAT16"));
+                    MPI_CHECK(MPI_Type_commit(&omb_bf16_type));
+                }
+                mpi_type_list[i] = omb_bf16_type;
+                break;
+            case OMB_2INT:
+                mpi_type_list[i] = MPI_2INT;
+                break;
             default:
                 OMB_ERROR_EXIT("Unknown data type");
                 break;
@@ -997,6 +1525,278 @@ void omb_populate_mpi_type_list(MPI_Datatype *mpi_type_list)
     }
 }
 
+static inline float omb_bf16_to_float(uint16_t val)
+{
+    uint32_t bits = (uint32_t)val << 16;
+    float f = 0;
+
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/* Rounds to the nearest bfloat16, ties to even. */
+static inline uint16_t omb_float_to_bf16(float f)
+{
+    uint32_t bits = 0;
+
+    memcpy(&bits, &f, sizeof(bits));
+    bits += 0x7fff + ((bits >> 16) & 1);
+    return (uint16_t)(bits >> 16);
+}
+
+/*
+ * Element-wise reduction loops. The restrict qualified pointers let the
+ * compiler vectorize them.
+ */
+#define OMB_REDUCE_LOOP(ctype, expr)                                           \
+    do {                                                                       \
+        const ctype *restrict a = (const ctype *)in;                           \
+        ctype *restrict b = (ctype *)inout;                                    \
+        for (i = 0; i < count; i++) {                                          \
+            b[i] = (expr);                                                     \
+        }                                                                      \
+    } while (0)
+
+#define OMB_REDUCE_ARITH(ctype)                                                \
+    switch (op) {                                                              \
+        case OMB_OP_PROD:                                                      \
+            OMB_REDUCE_LOOP(ctype, b[i] * a[i]);                               \
+            break;                                                             \
+        case OMB_OP_MAX:                                                       \
+            OMB_REDUCE_LOOP(ctype, MAX(b[i], a[i]));                           \
+            break;                                                             \
+        case OMB_OP_MIN:                                                       \
+            OMB_REDUCE_LOOP(ctype, MIN(b[i], a[i]));                           \
+            break;                                                             \
+        default:                                                               \
+            OMB_REDUCE_LOOP(ctype, b[i] + a[i]);                               \
+            break;                                                             \
+    }
+
+/* Integer products wrap around like the ones of the MPI library. */
+#define OMB_REDUCE_INTEGER(ctype, utype)                                       \
+    switch (op) {                                                              \
+        case OMB_OP_PROD:                                                      \
+            OMB_REDUCE_LOOP(ctype, (ctype)((utype)b[i] * (utype)a[i]));        \
+            break;                                                             \
+        case OMB_OP_BAND:                                                      \
+            OMB_REDUCE_LOOP(ctype, b[i] & a[i]);                               \
+            break;                                                             \
+        default:                                                               \
+            OMB_REDUCE_ARITH(ctype);                                           \
+            break;                                                             \
+    }
+
+void omb_reduce_local(const void *in, void *inout, int count,
+                      MPI_Datatype dtype, enum omb_reduce_ops_t op)
+{
+    int i = 0;
+    float x = 0, y = 0;
+
+    if (MPI_SIGNED_CHAR == dtype || MPI_CHAR == dtype) {
+        OMB_REDUCE_INTEGER(signed char, unsigned char);
+    } else if (MPI_INT == dtype) {
+        OMB_REDUCE_INTEGER(int, unsigned int);
+    } else if (MPI_INT64_T == dtype) {
+        OMB_REDUCE_INTEGER(int64_t, uint64_t);
+    } else if (MPI_FLOAT == dtype) {
+        OMB_REDUCE_ARITH(float);
+    } else if (MPI_DOUBLE == dtype) {
+        OMB_REDUCE_ARITH(double);
+    } else if (MPI_C_DOUBLE_COMPLEX == dtype) {
+        if (OMB_OP_PROD == op) {
+            OMB_REDUCE_LOOP(double _Complex, b[i] * a[i]);
+        } else {
+            OMB_REDUCE_LOOP(double _Complex, b[i] + a[i]);
+        }
+    } else if (MPI_2INT == dtype) {
+        const int *restrict a = (const int *)in;
+        int *restrict b = (int *)inout;
+        for (i = 0; i < count; i++) {
+            if (a[2 * i] < b[2 * i] ||
+                (a[2 * i] == b[2 * i] && a[2 * i + 1] < b[2 * i + 1])) {
+                b[2 * i] = a[2 * i];
+                b[2 * i + 1] = a[2 * i + 1];
+            }
+        }
+    } else if (omb_bf16_type == dtype) {
+        const uint16_t *restrict a = (const uint16_t *)in;
+        uint16_t *restrict b = (uint16_t *)inout;
+        for (i = 0; i < count; i++) {
+            x = omb_bf16_to_float(a[i]);
+            y = omb_bf16_to_float(b[i]);
+            switch (op) {
+                case OMB_OP_PROD:
+                    y *= x;
+                    break;
+                case OMB_OP_MAX:
+                    y = MAX(x, y);
+                    break;
+                case OMB_OP_MIN:
+                    y = MIN(x, y);
+                    break;
+                default:
+                    y += x;
+                    break;
+            }
+            b[i] = omb_float_to_bf16(y);
+        }
+    } else {
+        OMB_ERROR_EXIT("Invalid datatype passed");
+    }
+}
+
+/* MPI_User_function of the user-defined operator, a sum for -O user. */
+static void omb_user_reduce(void *in, void *inout, int *len,
+                            MPI_Datatype *dtype)
+{
+    omb_reduce_local(in, inout, *len, *dtype,
+                     OMB_OP_USER == options.reduce_op ? OMB_OP_SUM :
+                                                        options.reduce_op);
+}
+
+MPI_Op omb_get_reduce_op(MPI_Datatype dtype)
+{
+    if (OMB_OP_USER == options.reduce_op || omb_bf16_type == dtype) {
+        if (MPI_OP_NULL == omb_user_op) {
+            MPI_CHECK(MPI_Op_create(omb_user_reduce, 1, &omb_user_op));
+        }
+        return omb_user_op;
+    }
+    switch (options.reduce_op) {
+        case OMB_OP_MAX:
+            return MPI_MAX;
+        case OMB_OP_MIN:
+            return MPI_MIN;
+        case OMB_OP_PROD:
+            return MPI_PROD;
+        case OMB_OP_BAND:
+            return MPI_BAND;
+        case OMB_OP_MINLOC:
+            return MPI_MINLOC;
+        default:
+            return MPI_SUM;
+    }
+}
+
+/*
+ * Value of element elem of the send buffer of rank in iteration iter of the
+ * reduction benchmarks. Sums use the same value on every rank. For the other
+ * operators it varies with the rank, so that the result depends on all of
+ * them, and products stay small.
+ */
+static int omb_reduce_value(int elem, int iter, int rank)
+{
+    switch (options.reduce_op) {
+        case OMB_OP_SUM:
+        case OMB_OP_USER:
+            return (elem % 100 + 1) * (iter + 1);
+        case OMB_OP_PROD:
+            return 1 + (elem + rank + iter) % 2;
+        default:
+            return (elem % 100 + 1) * (iter + 1) + (elem + rank) % 7;
+    }
+}
+
+/* Send buffer of rank for elements first to first + count - 1. */
+static void omb_reduce_fill(void *buf, int first, int count, int iter,
+                            int rank, MPI_Datatype dtype)
+{
+    int i = 0;
+
+    for (i = 0; i < count; i++) {
+        omb_assign_to_type(buf, i, omb_reduce_value(first + i, iter, rank),
+                           dtype);
+        /*
+         * Keep signed char sums and products in range: some libraries
+         * saturate 8-bit arithmetic on overflow instead of wrapping.
+         */
+        if (MPI_SIGNED_CHAR == dtype) {
+            if (OMB_OP_PROD == options.reduce_op) {
+                ((signed char *)buf)[i] =
+                    0 == rank ? omb_reduce_value(first + i, iter, rank) : 1;
+            } else if (OMB_OP_SUM == options.reduce_op ||
+                       OMB_OP_USER == options.reduce_op) {
+                ((signed char *)buf)[i] = (first + i + iter + rank) % 2;
+            }
+        }
+        if (MPI_2INT == dtype) {
+            ((int *)buf)[2 * i + 1] = rank;
+        }
+    }
+}
+
+/*
+ * Expected result for elements first to first + count - 1, combining the
+ * send buffers of all ranks with the kernel of the user-defined operator.
+ */
+static void omb_reduce_expected(void *expected, int first, int count, int iter,
+                                int num_procs, MPI_Datatype dtype)
+{
+    int rank = 0, type_size = 0;
+    void *contrib = NULL;
+
+    MPI_CHECK(MPI_Type_size(dtype, &type_size));
+    contrib = malloc(MAX(count, 1) * type_size);
+    OMB_CHECK_NULL_AND_EXIT(contrib, "Unable to allocate memory");
+    omb_reduce_fill(expected, first, count, iter, 0, dtype);
+    for (rank = 1; rank < num_procs; rank++) {
+        omb_reduce_fill(contrib, first, count, iter, rank, dtype);
+        omb_reduce_local(contrib, expected, count, dtype,
+                         OMB_OP_USER == options.reduce_op ? OMB_OP_SUM :
+                                                            options.reduce_op);
+    }
+    free(contrib);
+}
+
+/* Element i as a double, the real and imaginary parts count separately. */
+static double omb_element_value(void *buf, int i, MPI_Datatype dtype)
+{
+    if (MPI_FLOAT == dtype) {
+        return ((float *)buf)[i];
+    } else if (MPI_DOUBLE == dtype || MPI_C_DOUBLE_COMPLEX == dtype) {
+        return ((double *)buf)[i];
+    } else if (MPI_INT64_T == dtype) {
+        return (double)((int64_t *)buf)[i];
+    } else if (MPI_INT == dtype || MPI_2INT == dtype) {
+        return ((int *)buf)[i];
+    } else if (omb_bf16_type == dtype) {
+        return omb_bf16_to_float(((uint16_t *)buf)[i]);
+    }
+    return ((signed char *)buf)[i];
+}
+
+/*
+ * Floating point results may differ from the expected ones in the rounding of
+ * a different reduction order. bfloat16 rounds after every step, so its
+ * tolerance grows with the number of processes.
+ */
+static int omb_reduce_compare(void *actual, void *expected, int count,
+                              int num_procs, MPI_Datatype dtype)
+{
+    int i = 0, type_size = 0;
+    double tolerance = ERROR_DELTA, e = 0, a = 0;
+
+    if (MPI_FLOAT != dtype && MPI_DOUBLE != dtype &&
+        MPI_C_DOUBLE_COMPLEX != dtype && omb_bf16_type != dtype) {
+        MPI_CHECK(MPI_Type_size(dtype, &type_size));
+        return 0 != memcmp(actual, expected, count * type_size);
+    }
+    if (omb_bf16_type == dtype) {
+        tolerance = num_procs / 128.0;
+    } else if (MPI_C_DOUBLE_COMPLEX == dtype) {
+        count *= 2;
+    }
+    for (i = 0; i < count; i++) {
+        e = omb_element_value(expected, i, dtype);
+        a = omb_element_value(actual, i, dtype);
+        if (e != a && fabs(e - a) > tolerance * MAX(1.0, fabs(e))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 void omb_ddt_append_stats(size_t omb_ddt_transmit_size)
 {
     int rank;
@@ -1255,12 +2055,12 @@ void set_buffer_validation(void *s_buf, void *r_buf, size_t size,
                     MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
                     MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
                     if (0 == options.omb_enable_mpi_in_place) {
-                        set_buffer_dtype_reduce(s_buf, 1, size, iter,
+                        set_buffer_dtype_reduce(s_buf, 1, size, iter, rank,
                                                 options.accel, dtype);
-                        set_buffer_dtype_reduce(r_buf, 0, size, iter,
+                        set_buffer_dtype_reduce(r_buf, 0, size, iter, rank,
                                                 options.accel, dtype);
                     } else {
-                        set_buffer_dtype_reduce(r_buf, 1, size, iter,
+                        set_buffer_dtype_reduce(r_buf, 1, size, iter, rank,
                                                 options.accel, dtype);
                     }
                     break;
@@ -1291,12 +2091,13 @@ void set_buffer_validation(void *s_buf, void *r_buf, size_t size,
                     MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
                     MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
                     if (0 == options.omb_enable_mpi_in_place) {
-                        set_buffer_dtype_reduce(s_buf, 1, size, iter,
+                        set_buffer_dtype_reduce(s_buf, 1, size, iter, rank,
                                                 options.accel, dtype);
                         set_buffer_dtype_reduce(r_buf, 0, size / numprocs + 1,
-                                                iter, options.accel, dtype);
+                                                iter, rank, options.accel,
+                                                dtype);
                     } else {
-                        set_buffer_dtype_reduce(r_buf, 1, size, iter,
+                        set_buffer_dtype_reduce(r_buf, 1, size, iter, rank,
                                                 options.accel, dtype);
                     }
                 } break;
@@ -1324,22 +2125,18 @@ void set_buffer_validation(void *s_buf, void *r_buf, size_t size,
 }
 
 void set_buffer_dtype_reduce(void *buffer, int is_send_buf, size_t size,
-                             int iter, enum accel_type type, MPI_Datatype dtype)
+                             int iter, int rank, enum accel_type type,
+                             MPI_Datatype dtype)
 {
     if (NULL == buffer) {
         return;
     }
 
-    int i = 0, j = 0;
-    int val = 0;
+    int i = 0;
     int num_elements = omb_get_num_elements(size, dtype);
     float *temp_buffer = malloc(size);
     if (is_send_buf) {
-        for (i = 0; i < num_elements; i++) {
-            j = (i % 100);
-            val = (j + 1) * (iter + 1);
-            omb_assign_to_type(temp_buffer, i, val, dtype);
-        }
+        omb_reduce_fill(temp_buffer, 0, num_elements, iter, rank, dtype);
     } else {
         for (i = 0; i < num_elements; i++) {
             omb_assign_to_type(temp_buffer, i, 0, dtype);
@@ -1377,13 +2174,26 @@ void set_buffer_dtype_reduce(void *buffer, int is_send_buf, size_t size,
 
 void omb_assign_to_type(void *buf, int pos, int val, MPI_Datatype dtype)
 {
-    if (MPI_CHAR == dtype) {
+    if (MPI_CHAR == dtype || MPI_SIGNED_CHAR == dtype) {
         ((char *)buf)[pos] =
             (CHAR_VALIDATION_MULTIPLIER * (char)(val)) % CHAR_RANGE;
     } else if (MPI_INT == dtype) {
         ((int *)buf)[pos] = (int)val * INT_VALIDATION_MULTIPLIER;
     } else if (MPI_FLOAT == dtype) {
         ((float *)buf)[pos] = (float)val * FLOAT_VALIDATION_MULTIPLIER;
+    } else if (MPI_DOUBLE == dtype) {
+        ((double *)buf)[pos] = (double)val * FLOAT_VALIDATION_MULTIPLIER;
+    } else if (MPI_INT64_T == dtype) {
+        ((int64_t *)buf)[pos] = (int64_t)val * INT_VALIDATION_MULTIPLIER;
+    } else if (MPI_C_DOUBLE_COMPLEX == dtype) {
+        ((double *)buf)[2 * pos] = (double)val * FLOAT_VALIDATION_MULTIPLIER;
+        ((double *)buf)[2 * pos + 1] = (double)val;
+    } else if (MPI_2INT == dtype) {
+        ((int *)buf)[2 * pos] = (int)val * INT_VALIDATION_MULTIPLIER;
+        ((int *)buf)[2 * pos + 1] = (int)val;
+    } else if (omb_bf16_type == dtype) {
+        ((uint16_t *)buf)[pos] =
+            omb_float_to_bf16((float)val * FLOAT_VALIDATION_MULTIPLIER);
     } else {
         OMB_ERROR_EXIT("Invalid data type passed");
     }
@@ -1391,12 +2201,19 @@ void omb_assign_to_type(void *buf, int pos, int val, MPI_Datatype dtype)
 
 int omb_get_num_elements(size_t size, MPI_Datatype dtype)
 {
+    int type_size = 0;
+
     if (MPI_CHAR == dtype) {
         return size / sizeof(ATOM_CTYPE_FOR_DMPI_CHAR);
     } else if (MPI_FLOAT == dtype) {
         return size / sizeof(ATOM_CTYPE_FOR_DMPI_FLOAT);
     } else if (MPI_INT == dtype) {
         return size / sizeof(ATOM_CTYPE_FOR_DMPI_INT);
+    } else if (MPI_SIGNED_CHAR == dtype || MPI_DOUBLE == dtype ||
+               MPI_INT64_T == dtype || MPI_C_DOUBLE_COMPLEX == dtype ||
+               MPI_2INT == dtype || omb_bf16_type == dtype) {
+        MPI_CHECK(MPI_Type_size(dtype, &type_size));
+        return size / type_size;
     } else {
         OMB_ERROR_EXIT("Invalid datatype passed");
     }
@@ -2085,11 +2902,9 @@ int validate_reduce_scatter(void *buffer, size_t size, int *recvcounts,
                             int rank, int num_procs, enum accel_type type,
                             int iter, MPI_Datatype dtype)
 {
-    int i = 0, j = 0, k = 0, l = 0, m = 0, errors = 0;
+    int k = 0, m = 0, errors = 0;
     void *expected_buffer = malloc(size);
     void *temp_buffer = malloc(size);
-    int val = 0;
-    void *log_buffer = NULL;
 
     switch (type) {
         case NONE:
@@ -2122,41 +2937,15 @@ int validate_reduce_scatter(void *buffer, size_t size, int *recvcounts,
     for (k = 0; k < rank; k++) {
         m += recvcounts[k];
     }
-    log_buffer = malloc(size);
-    OMB_CHECK_NULL_AND_EXIT(log_buffer, "Unable to allocate buffer");
-    for (i = m, l = 0; i < recvcounts[rank]; i++, l++) {
-        j = (i % 100);
-        val = (j + 1) * (iter + 1) * num_procs;
-        if (MPI_CHAR == dtype) {
-            ((char *)expected_buffer)[l] =
-                (char)(CHAR_VALIDATION_MULTIPLIER * val) % CHAR_RANGE;
-            ((char *)log_buffer)[l] = ((char *)temp_buffer)[i];
-            if (((char *)temp_buffer)[i] !=
-                (char)(CHAR_VALIDATION_MULTIPLIER * val) % CHAR_RANGE) {
-                errors = 1;
-            }
-        } else if (MPI_INT == dtype) {
-            ((int *)expected_buffer)[l] = (int)val * INT_VALIDATION_MULTIPLIER;
-            ((int *)log_buffer)[l] = ((int *)temp_buffer)[i];
-            if (((int *)temp_buffer)[i] !=
-                (int)val * INT_VALIDATION_MULTIPLIER) {
-                errors = 1;
-            }
-        } else if (MPI_FLOAT == dtype) {
-            ((float *)expected_buffer)[l] =
-                (float)val * FLOAT_VALIDATION_MULTIPLIER;
-            ((float *)log_buffer)[l] = ((float *)temp_buffer)[i];
-            if (((float *)temp_buffer)[i] !=
-                (float)val * FLOAT_VALIDATION_MULTIPLIER) {
-                errors = 1;
-            }
-        }
-    }
+    /* this rank holds the result of elements m to m + recvcounts[rank] - 1 */
+    omb_reduce_expected(expected_buffer, m, recvcounts[rank], iter, num_procs,
+                        dtype);
+    errors = omb_reduce_compare(temp_buffer, expected_buffer, recvcounts[rank],
+                                num_procs, dtype);
     if (1 == errors && options.log_validation) {
-        validation_log(log_buffer, expected_buffer, size, recvcounts[k], dtype,
-                       iter);
+        validation_log(temp_buffer, expected_buffer, size, recvcounts[rank],
+                       dtype, iter);
     }
-    free(log_buffer);
     free(expected_buffer);
     free(temp_buffer);
     return errors;
@@ -2165,7 +2954,7 @@ int validate_reduce_scatter(void *buffer, size_t size, int *recvcounts,
 int validate_reduction(void *buffer, size_t size, int iter, int num_procs,
                        enum accel_type type, MPI_Datatype dtype)
 {
-    int i = 0, j = 0, errors = 0, val = 0;
+    int errors = 0;
     void *expected_buffer = malloc(size);
     void *temp_buffer = malloc(size);
     int num_elements = omb_get_num_elements(size, dtype);
@@ -2198,25 +2987,10 @@ int validate_reduction(void *buffer, size_t size, int iter, int num_procs,
         default:
             break;
     }
-    for (i = 0; i < num_elements; i++) {
-        j = (i % 100);
-        val = (j + 1) * (iter + 1) * num_procs;
-        omb_assign_to_type(expected_buffer, i, val, dtype);
-    }
-    if (dtype == MPI_FLOAT) {
-        for (i = 0; i < num_elements; i++) {
-            j = (i % 100);
-            if (abs(((float *)temp_buffer)[i] - ((float *)expected_buffer)[i]) >
-                ERROR_DELTA) {
-                errors = 1;
-                break;
-            }
-        }
-    } else {
-        if (memcmp(temp_buffer, expected_buffer, size) != 0) {
-            errors = 1;
-        }
-    }
+    omb_reduce_expected(expected_buffer, 0, num_elements, iter, num_procs,
+                        dtype);
+    errors = omb_reduce_compare(temp_buffer, expected_buffer, num_elements,
+                                num_procs, dtype);
     if (1 == errors && options.log_validation) {
         validation_log(temp_buffer, expected_buffer, size, num_elements, dtype,
                        iter);
@@ -2297,7 +3071,8 @@ int validate_collective(void *buffer, size_t size, int value1, int value2,
 void validation_log(void *buffer, void *expected_buffer, size_t size,
                     size_t num_elements, MPI_Datatype dtype, int itr)
 {
-    int rank = 0, i = 0;
+    int rank = 0, i = 0, j = 0, dtype_name_length = 0;
+    char dtype_name[MPI_MAX_OBJECT_NAME];
     char *log_file_loc = NULL;
     FILE *log_file_fp = NULL;
 
@@ -2313,16 +3088,9 @@ void validation_log(void *buffer, void *expected_buffer, size_t size,
             rank);
     log_file_fp = fopen(log_file_loc, "a");
     OMB_CHECK_NULL_AND_EXIT(log_file_loc, "Unable to open file.");
-    fprintf(log_file_fp, "Size: %d, Iteration:%d, ", size, itr);
-    if (MPI_FLOAT == dtype) {
-        fprintf(log_file_fp, "Datatype: MPI_FLOAT\n");
-    } else if (MPI_INT == dtype) {
-        fprintf(log_file_fp, "Datatype: MPI_INT\n");
-    } else if (MPI_CHAR == dtype) {
-        fprintf(log_file_fp, "Datatype: MPI_CHAR\n");
-    } else {
-        OMB_ERROR_EXIT("Invalid MPI Datatype.");
-    }
+    fprintf(log_file_fp, "Size: %zu, Iteration:%d, ", size, itr);
+    MPI_CHECK(MPI_Type_get_name(dtype, dtype_name, &dtype_name_length));
+    fprintf(log_file_fp, "Datatype: %s\n", dtype_name);
     fprintf(log_file_fp, "%-*s%*s%*s\n", 10, "Position", FIELD_WIDTH,
             "Expected", FIELD_WIDTH, "Actual");
 
@@ -2352,12 +3120,39 @@ void validation_log(void *buffer, void *expected_buffer, size_t size,
                         ((char *)buffer)[i]);
             }
         }
+    } else {
+        /* complex numbers and pairs log their first component */
+        for (i = 0; i < num_elements; i++) {
+            j = (MPI_C_DOUBLE_COMPLEX == dtype || MPI_2INT == dtype) ? 2 * i :
+                                                                       i;
+            if (omb_element_value(buffer, j, dtype) !=
+                omb_element_value(expected_buffer, j, dtype)) {
+                fprintf(log_file_fp, "%-*d%*f%*f\n", 10, i, FIELD_WIDTH,
+                        omb_element_value(expected_buffer, j, dtype),
+                        FIELD_WIDTH, omb_element_value(buffer, j, dtype));
+            }
+        }
     }
     fclose(log_file_fp);
 }
 
+/* Refuses message buffers larger than the limit of -U, if any. */
+static int omb_mem_limit_exceeded(size_t size)
+{
+    if (0 == options.max_mem_limit || size <= options.max_mem_limit) {
+        return 0;
+    }
+    fprintf(stderr,
+            "Buffer of %zu bytes exceeds the memory limit of %zu bytes\n",
+            size, options.max_mem_limit);
+    return 1;
+}
+
 int allocate_memory_coll(void **buffer, size_t size, enum accel_type type)
 {
+    if (omb_mem_limit_exceeded(size)) {
+        return 1;
+    }
     if (options.target == CPU || options.target == BOTH) {
         allocate_host_arrays();
     }
@@ -2612,6 +3407,9 @@ int allocate_memory_pt2pt_mul_size(char **sbuf, char **rbuf, int rank,
     } else {
         size = allocate_size;
     }
+    if (omb_mem_limit_exceeded(size)) {
+        return 1;
+    }
 
     if (rank < pairs) {
         if ('D' == options.src) {
@@ -2691,6 +3489,10 @@ int allocate_memory_pt2pt(char **sbuf, char **rbuf, int rank)
 {
     unsigned long align_size = sysconf(_SC_PAGESIZE);
 
+    if (omb_mem_limit_exceeded(options.max_message_size)) {
+        return 1;
+    }
+
     switch (rank) {
         case 0:
             if ('D' == options.src) {
@@ -2778,6 +3580,9 @@ int allocate_memory_pt2pt_size(char **sbuf, char **rbuf, int rank,
     } else {
         size = allocate_size;
     }
+    if (omb_mem_limit_exceeded(size)) {
+        return 1;
+    }
 
     switch (rank) {
         case 0:
@@ -2851,6 +3656,286 @@ int allocate_memory_pt2pt_size(char **sbuf, char **rbuf, int rank,
     return 0;
 }
 
+/*
+ * Returns 1 if the MPI library allocates the window memory for the given
+ * window type when host buffers are used.
+ */
+int omb_win_is_allocated(enum WINDOW type)
+{
+#if MPI_VERSION >= 3
+    return WIN_ALLOCATE == type || WIN_ALLOCATE_SHARED == type;
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Prints, on rank 0 of comm, the cpu, socket and NUMA node of every process
+ * and the NUMA node backing its segment, followed by the placement of ranks 0
+ * and 1 relative to each other. Unknown values are printed as -1.
+ */
+void omb_print_placement(MPI_Comm comm, void *segment)
+{
+    int rank = 0, size = 0, i = 0;
+    int local[4], *all = NULL;
+    const char *placement = "unknown";
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    MPI_CHECK(MPI_Comm_size(comm, &size));
+    omb_get_cpu_location(&local[0], &local[1], &local[2]);
+    local[3] = omb_get_mem_numa_node(segment);
+    if (0 == rank) {
+        all = malloc(4 * size * sizeof(int));
+        OMB_CHECK_NULL_AND_EXIT(all, "Unable to allocate memory");
+    }
+    MPI_CHECK(MPI_Gather(local, 4, MPI_INT, all, 4, MPI_INT, 0, comm));
+    if (0 != rank) {
+        return;
+    }
+    for (i = 0; i < size; i++) {
+        fprintf(stdout,
+                "# Rank %d: cpu %d, socket %d, NUMA node %d, segment on NUMA"
+                " node %d\n",
+                i, all[4 * i], all[4 * i + 1], all[4 * i + 2], all[4 * i + 3]);
+    }
+    if (size > 1 && all[2] >= 0 && all[6] >= 0) {
+        if (all[2] == all[6]) {
+            placement = "same NUMA node";
+        } else if (all[1] >= 0 && all[1] == all[5]) {
+            placement = "same socket, different NUMA node";
+        } else if (all[1] >= 0 && all[5] >= 0) {
+            placement = "cross-socket";
+        } else {
+            placement = "different NUMA node";
+        }
+    }
+    fprintf(stdout, "# Placement of ranks 0 and 1: %s\n", placement);
+    fflush(stdout);
+    free(all);
+}
+
+/*
+ * Returns 1 when all processes of comm share a node, i.e. when they can use
+ * MPI_Win_allocate_shared over comm.
+ */
+int omb_comm_is_node_local(MPI_Comm comm)
+{
+    int size = 0, node_size = 0;
+    MPI_Comm node_comm = MPI_COMM_NULL;
+
+#if MPI_VERSION >= 3
+    MPI_CHECK(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                                  &node_comm));
+    MPI_CHECK(MPI_Comm_size(node_comm, &node_size));
+    MPI_CHECK(MPI_Comm_free(&node_comm));
+#endif
+    MPI_CHECK(MPI_Comm_size(comm, &size));
+    return size == node_size;
+}
+
+static const char *omb_coll_names[OMB_COLL_NUM] = {
+    "allgather", "allreduce", "alltoall",       "barrier", "bcast",
+    "gather",    "reduce",    "reduce_scatter", "scatter"};
+
+const char *omb_coll_name(int coll) { return omb_coll_names[coll]; }
+
+/* Returns the omb_colls_t of a collective name, -1 if it is unknown. */
+int omb_coll_by_name(const char *name)
+{
+    int coll = 0;
+
+    for (coll = 0; coll < OMB_COLL_NUM; coll++) {
+        if (!strcmp(name, omb_coll_names[coll])) {
+            return coll;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Element count of a message of size bytes, 0 if the collective skips this
+ * size. Reductions count floats, the other collectives bytes.
+ */
+int omb_coll_count(int coll, size_t size)
+{
+    switch (coll) {
+        case OMB_COLL_ALLREDUCE:
+        case OMB_COLL_REDUCE:
+        case OMB_COLL_REDUCE_SCATTER:
+            return size / sizeof(float);
+        case OMB_COLL_BARRIER:
+            return 1;
+        default:
+            return size;
+    }
+}
+
+#if MPI_VERSION >= 3
+/*
+ * Runs one collective over comm with root 0, or with nonblocking set the
+ * non-blocking variant and its wait. Rooted and all-to-all data movement
+ * collectives need count * nprocs bytes in their buffers and reduce_scatter
+ * needs recvcounts to hold nprocs entries.
+ */
+void omb_coll_run(int coll, MPI_Comm comm, int nprocs, char *sendbuf,
+                  char *recvbuf, int *recvcounts, int count, int nonblocking)
+{
+    int i = 0;
+    MPI_Request req = MPI_REQUEST_NULL;
+
+    switch (coll) {
+        case OMB_COLL_ALLGATHER:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Iallgather(sendbuf, count, MPI_CHAR, recvbuf,
+                                         count, MPI_CHAR, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Allgather(sendbuf, count, MPI_CHAR, recvbuf,
+                                        count, MPI_CHAR, comm));
+            }
+            break;
+        case OMB_COLL_ALLREDUCE:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Iallreduce(sendbuf, recvbuf, count, MPI_FLOAT,
+                                         MPI_SUM, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Allreduce(sendbuf, recvbuf, count, MPI_FLOAT,
+                                        MPI_SUM, comm));
+            }
+            break;
+        case OMB_COLL_ALLTOALL:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Ialltoall(sendbuf, count, MPI_CHAR, recvbuf,
+                                        count, MPI_CHAR, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Alltoall(sendbuf, count, MPI_CHAR, recvbuf,
+                                       count, MPI_CHAR, comm));
+            }
+            break;
+        case OMB_COLL_BARRIER:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Ibarrier(comm, &req));
+            } else {
+                MPI_CHECK(MPI_Barrier(comm));
+            }
+            break;
+        case OMB_COLL_BCAST:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Ibcast(sendbuf, count, MPI_CHAR, 0, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Bcast(sendbuf, count, MPI_CHAR, 0, comm));
+            }
+            break;
+        case OMB_COLL_GATHER:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Igather(sendbuf, count, MPI_CHAR, recvbuf, count,
+                                      MPI_CHAR, 0, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Gather(sendbuf, count, MPI_CHAR, recvbuf, count,
+                                     MPI_CHAR, 0, comm));
+            }
+            break;
+        case OMB_COLL_REDUCE:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Ireduce(sendbuf, recvbuf, count, MPI_FLOAT,
+                                      MPI_SUM, 0, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Reduce(sendbuf, recvbuf, count, MPI_FLOAT,
+                                     MPI_SUM, 0, comm));
+            }
+            break;
+        case OMB_COLL_REDUCE_SCATTER:
+            for (i = 0; i < nprocs; i++) {
+                recvcounts[i] = MAX(count / nprocs, 1);
+            }
+            if (nonblocking) {
+                MPI_CHECK(MPI_Ireduce_scatter(sendbuf, recvbuf, recvcounts,
+                                              MPI_FLOAT, MPI_SUM, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Reduce_scatter(sendbuf, recvbuf, recvcounts,
+                                             MPI_FLOAT, MPI_SUM, comm));
+            }
+            break;
+        case OMB_COLL_SCATTER:
+            if (nonblocking) {
+                MPI_CHECK(MPI_Iscatter(sendbuf, count, MPI_CHAR, recvbuf,
+                                       count, MPI_CHAR, 0, comm, &req));
+            } else {
+                MPI_CHECK(MPI_Scatter(sendbuf, count, MPI_CHAR, recvbuf, count,
+                                      MPI_CHAR, 0, comm));
+            }
+            break;
+    }
+    if (nonblocking) {
+        MPI_CHECK(MPI_Wait(&req, MPI_STATUS_IGNORE));
+    }
+}
+#endif
+
+/*
+ * Creates a window of the given type over comm. For WIN_CREATE and
+ * WIN_DYNAMIC, *win_base must already point to size bytes; for WIN_ALLOCATE
+ * and WIN_ALLOCATE_SHARED with host buffers it is set to the memory allocated
+ * by the MPI library. For WIN_DYNAMIC ranks 0 and 1 exchange the address of
+ * their attached region in disp_remote.
+ */
+void omb_win_create_one_sided(int rank, char **win_base, size_t size,
+                              enum WINDOW type, MPI_Comm comm, MPI_Win *win)
+{
+    int purehost = 0;
+
+    if ('H' == options.src && 'H' == options.dst) {
+        purehost = 1;
+    }
+#if MPI_VERSION >= 3
+    MPI_Status reqstat;
+
+    switch (type) {
+        case WIN_CREATE:
+            MPI_CHECK(MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL, comm,
+                                     win));
+            break;
+        case WIN_DYNAMIC:
+            MPI_CHECK(MPI_Win_create_dynamic(MPI_INFO_NULL, comm, win));
+            MPI_CHECK(MPI_Win_attach(*win, (void *)*win_base, size));
+            MPI_CHECK(MPI_Get_address(*win_base, &disp_local));
+            if (rank == 0) {
+                MPI_CHECK(MPI_Send(&disp_local, 1, MPI_AINT, 1, 1, comm));
+                MPI_CHECK(
+                    MPI_Recv(&disp_remote, 1, MPI_AINT, 1, 1, comm, &reqstat));
+            } else if (rank == 1) {
+                MPI_CHECK(
+                    MPI_Recv(&disp_remote, 1, MPI_AINT, 0, 1, comm, &reqstat));
+                MPI_CHECK(MPI_Send(&disp_local, 1, MPI_AINT, 0, 1, comm));
+            }
+            break;
+        case WIN_ALLOCATE_SHARED:
+            if (!omb_comm_is_node_local(comm)) {
+                OMB_ERROR_EXIT("MPI_Win_allocate_shared requires all"
+                               " processes to share a node");
+            }
+            if (purehost) {
+                MPI_CHECK(MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, comm,
+                                                  (void *)win_base, win));
+            } else {
+                MPI_CHECK(MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL,
+                                         comm, win));
+            }
+            break;
+        default:
+            if (purehost) {
+                MPI_CHECK(MPI_Win_allocate(size, 1, MPI_INFO_NULL, comm,
+                                           (void *)win_base, win));
+            } else {
+                MPI_CHECK(MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL,
+                                         comm, win));
+            }
+            break;
+    }
+#else
+    MPI_CHECK(MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL, comm, win));
+#endif
+}
+
 void allocate_memory_one_sided(int rank, char **user_buf, char **win_base,
                                size_t size, enum WINDOW type, MPI_Win *win)
 {
@@ -2878,7 +3963,7 @@ void allocate_memory_one_sided(int rank, char **user_buf, char **win_base,
         } else {
             CHECK(posix_memalign((void **)user_buf, page_size, size));
             memset(*user_buf, 'a', size);
-            if (type != WIN_ALLOCATE || !purehost) {
+            if (!omb_win_is_allocated(type) || !purehost) {
                 CHECK(posix_memalign((void **)win_base, page_size, size));
                 memset(*win_base, 'a', size);
             }
@@ -2896,53 +3981,14 @@ void allocate_memory_one_sided(int rank, char **user_buf, char **win_base,
         } else {
             CHECK(posix_memalign((void **)user_buf, page_size, size));
             memset(*user_buf, 'a', size);
-            if (type != WIN_ALLOCATE || !purehost) {
+            if (!omb_win_is_allocated(type) || !purehost) {
                 CHECK(posix_memalign((void **)win_base, page_size, size));
                 memset(*win_base, 'a', size);
             }
         }
     }
 
-#if MPI_VERSION >= 3
-    MPI_Status reqstat;
-
-    switch (type) {
-        case WIN_CREATE:
-            MPI_CHECK(MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL,
-                                     MPI_COMM_WORLD, win));
-            break;
-        case WIN_DYNAMIC:
-            MPI_CHECK(
-                MPI_Win_create_dynamic(MPI_INFO_NULL, MPI_COMM_WORLD, win));
-            MPI_CHECK(MPI_Win_attach(*win, (void *)*win_base, size));
-            MPI_CHECK(MPI_Get_address(*win_base, &disp_local));
-            if (rank == 0) {
-                MPI_CHECK(
-                    MPI_Send(&disp_local, 1, MPI_AINT, 1, 1, MPI_COMM_WORLD));
-                MPI_CHECK(MPI_Recv(&disp_remote, 1, MPI_AINT, 1, 1,
-                                   MPI_COMM_WORLD, &reqstat));
-            } else {
-                MPI_CHECK(MPI_Recv(&disp_remote, 1, MPI_AINT, 0, 1,
-                                   MPI_COMM_WORLD, &reqstat));
-                MPI_CHECK(
-                    MPI_Send(&disp_local, 1, MPI_AINT, 0, 1, MPI_COMM_WORLD));
-            }
-            break;
-        default:
-            if (purehost) {
-                MPI_CHECK(MPI_Win_allocate(size, 1, MPI_INFO_NULL,
-                                           MPI_COMM_WORLD, (void *)win_base,
-                                           win));
-            } else {
-                MPI_CHECK(MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL,
-                                         MPI_COMM_WORLD, win));
-            }
-            break;
-    }
-#else
-    MPI_CHECK(
-        MPI_Win_create(*win_base, size, 1, MPI_INFO_NULL, MPI_COMM_WORLD, win));
-#endif
+    omb_win_create_one_sided(rank, win_base, size, type, MPI_COMM_WORLD, win);
 }
 
 size_t omb_ddt_assign(MPI_Datatype *datatype, MPI_Datatype base_datatype,
@@ -3297,7 +4343,7 @@ void free_memory_one_sided(void *user_buf, void *win_baseptr,
     MPI_CHECK(MPI_Win_free(&win));
     /* if MPI_Win_allocate is specified, win_baseptr would be freed by
      * MPI_Win_free, so only need to free the user_buf */
-    if (win_type != WIN_ALLOCATE || !purehost) {
+    if (!omb_win_is_allocated(win_type) || !purehost) {
         free_memory(user_buf, win_baseptr, rank);
     } else {
         free_memory(user_buf, NULL, rank);
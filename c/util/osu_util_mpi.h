@@ -12,6 +12,7 @@
 #include "osu_util.h"
 #include "osu_util_graph.h"
 #include "osu_util_papi.h"
+#include "osu_util_affinity.h"
 
 #define MPI_CHECK(stmt)                                                        \
     do {                                                                       \
@@ -103,9 +104,9 @@ void print_preamble(int rank);
 void print_only_header(int rank);
 void print_preamble_nbc(int rank);
 void print_only_header_nbc(int rank);
-void print_stats(int rank, int size, double avg, double min, double max,
+void print_stats(int rank, size_t size, double avg, double min, double max,
                  struct omb_stat_t omb_stats);
-void print_stats_validate(int rank, int size, double avg, double min,
+void print_stats_validate(int rank, size_t size, double avg, double min,
                           double max, int errors, struct omb_stat_t omb_stats);
 void print_stats_nbc(int rank, int size, double ovrl, double cpu,
                      double avg_comm, double min_comm, double max_comm,
@@ -142,7 +143,7 @@ void set_buffer_dtype(void *buffer, int is_send_buf, size_t size, int rank,
                       int num_procs, enum accel_type type, int iter,
                       MPI_Datatype dtype, size_t bufsize);
 void set_buffer_dtype_reduce(void *buffer, int is_send_buf, size_t size,
-                             int iter, enum accel_type type,
+                             int iter, int rank, enum accel_type type,
                              MPI_Datatype dtype);
 
 /*
@@ -178,6 +179,11 @@ extern int accel_enabled;
 extern struct options_t options;
 extern struct bad_usage_t bad_usage;
 
+int omb_comm_is_node_local(MPI_Comm comm);
+void omb_print_placement(MPI_Comm comm, void *segment);
+int omb_win_is_allocated(enum WINDOW type);
+void omb_win_create_one_sided(int rank, char **win_base, size_t size,
+                              enum WINDOW type, MPI_Comm comm, MPI_Win *win);
 void allocate_memory_one_sided(int rank, char **sbuf, char **win_base,
                                size_t size, enum WINDOW type, MPI_Win *win);
 void free_memory_one_sided(void *user_buf, void *win_baseptr,
@@ -256,6 +262,13 @@ int atomic_data_validation_print_summary();
  */
 void omb_populate_mpi_type_list(MPI_Datatype *mpi_type_list);
 
+/*
+ * Reduction Operators
+ */
+void omb_reduce_local(const void *in, void *inout, int count,
+                      MPI_Datatype dtype, enum omb_reduce_ops_t op);
+MPI_Op omb_get_reduce_op(MPI_Datatype dtype);
+
 /*
  * Per MPI forum documentation "Signed Characters and Reductions":
  *  The types MPI_SIGNED_CHAR and MPI_UNSIGNED_CHAR can be
@@ -287,4 +300,47 @@ void omb_mpi_finalize(omb_mpi_init_data omb_init_h);
 omb_mpi_init_data omb_mpi_init(int *argc, char ***argv);
 
 int omb_get_root_rank(int itr, size_t comm_size);
+double omb_skew_inject(int rank, int numprocs);
 void omb_scatter_offset_copy(void *buf, int root_rank, size_t size);
+
+/*
+ * Large counts. Counts above INT_MAX go through the MPI-4 "_c" bindings;
+ * benchmarks that wrap their data movement calls in OMB_MPI_LARGE set
+ * options.large_count to OMB_LARGE_COUNT before process_options, which
+ * refuses messages above 2GB everywhere else.
+ */
+#if MPI_VERSION >= 4
+#define OMB_LARGE_COUNT 1
+#define OMB_MPI_LARGE(fn, count, args)                                         \
+    ((size_t)INT_MAX < (size_t)(count) ? fn##_c args : fn args)
+#else
+#define OMB_LARGE_COUNT                0
+#define OMB_MPI_LARGE(fn, count, args) fn args
+#endif
+
+/*
+ * Collectives selected by name
+ */
+const char *omb_coll_name(int coll);
+int omb_coll_by_name(const char *name);
+int omb_coll_count(int coll, size_t size);
+#if MPI_VERSION >= 3
+void omb_coll_run(int coll, MPI_Comm comm, int nprocs, char *sendbuf,
+                  char *recvbuf, int *recvcounts, int count, int nonblocking);
+#endif
+
+/*
+ * Buffer policies of -E
+ */
+void omb_buffer_policy_next(void **s_buf, void **r_buf, size_t size);
+void omb_buffer_policy_reset(void **s_buf, void **r_buf);
+
+/*
+ * Memory bandwidth contention
+ */
+#define OMB_CONTENTION_CHUNK 4096
+void omb_mem_contention_start(void);
+void omb_mem_contention_stop(void);
+double omb_contended_bw(MPI_Comm comm, int num_pairs, int bidir, char *s_buf,
+                        char *r_buf, size_t count, MPI_Datatype dtype,
+                        size_t bytes);
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include "osu_util_mpit.h"
+
+#ifdef _ENABLE_MPIT_
+static MPI_T_pvar_session omb_mpit_session = MPI_T_PVAR_SESSION_NULL;
+static omb_mpit_pvar_t *omb_mpit_pvars = NULL;
+static int omb_mpit_num_pvars = 0;
+static int omb_mpit_num_records = 0;
+static size_t omb_mpit_record_sizes[OMB_MPIT_MAX_RECORDS];
+static double *omb_mpit_record_values = NULL;
+
+void omb_mpit_init(void)
+{
+    int provided = 0;
+
+    MPI_CHECK(MPI_T_init_thread(MPI_THREAD_SINGLE, &provided));
+}
+
+void omb_mpit_finalize(void) { MPI_CHECK(MPI_T_finalize()); }
+
+static void omb_mpit_lowercase(char *str)
+{
+    for (; *str; str++) {
+        *str = tolower(*str);
+    }
+}
+
+static int omb_mpit_cvar_writable(int scope)
+{
+    return MPI_T_SCOPE_CONSTANT != scope && MPI_T_SCOPE_READONLY != scope;
+}
+
+/*
+ * Looks for a writable, enumerated integer cvar named
+ * <prefix>_<coll>_algorithm or <prefix>_<coll>_intra_algorithm, which covers
+ * coll_tuned_allreduce_algorithm of Open MPI as well as
+ * MPIR_CVAR_ALLREDUCE_INTRA_ALGORITHM of MPICH derived libraries. Returns 0
+ * and fills cvar on success.
+ */
+int omb_mpit_find_algorithm_cvar(const char *coll, omb_mpit_cvar_t *cvar)
+{
+    int num_cvars = 0, i = 0, j = 0, name_len = 0, desc_len = 0;
+    int verbosity = 0, bind = 0, scope = 0, count = 0, num_items = 0;
+    char name[OMB_MPIT_NAME_MAX_LENGTH], lower[OMB_MPIT_NAME_MAX_LENGTH];
+    char pattern[OMB_MPIT_NAME_MAX_LENGTH];
+    char *match = NULL;
+    MPI_Datatype datatype;
+    MPI_T_enum enumtype;
+
+    snprintf(pattern, sizeof(pattern), "_%s_", coll);
+    omb_mpit_lowercase(pattern);
+    MPI_CHECK(MPI_T_cvar_get_num(&num_cvars));
+    for (i = 0; i < num_cvars; i++) {
+        name_len = sizeof(name);
+        desc_len = 0;
+        if (MPI_SUCCESS != MPI_T_cvar_get_info(i, name, &name_len, &verbosity,
+                                               &datatype, &enumtype, NULL,
+                                               &desc_len, &bind, &scope)) {
+            continue;
+        }
+        if (MPI_INT != datatype || MPI_T_ENUM_NULL == enumtype ||
+            MPI_T_BIND_NO_OBJECT != bind || !omb_mpit_cvar_writable(scope)) {
+            continue;
+        }
+        strcpy(lower, name);
+        omb_mpit_lowercase(lower);
+        match = strstr(lower, pattern);
+        if (NULL == match) {
+            continue;
+        }
+        match += strlen(pattern);
+        if (strcmp(match, "algorithm") && strcmp(match, "intra_algorithm")) {
+            continue;
+        }
+
+        cvar->index = i;
+        strcpy(cvar->name, name);
+        MPI_CHECK(MPI_T_cvar_handle_alloc(i, NULL, &cvar->handle, &count));
+        MPI_CHECK(MPI_T_cvar_read(cvar->handle, &cvar->default_value));
+        name_len = sizeof(name);
+        MPI_CHECK(MPI_T_enum_get_info(enumtype, &num_items, name, &name_len));
+        cvar->num_candidates = MIN(num_items, OMB_MPIT_MAX_CANDIDATES);
+        for (j = 0; j < cvar->num_candidates; j++) {
+            name_len = OMB_MPIT_NAME_MAX_LENGTH;
+            MPI_CHECK(MPI_T_enum_get_item(enumtype, j, &cvar->values[j],
+                                          cvar->value_names[j], &name_len));
+        }
+        return 0;
+    }
+    return -1;
+}
+
+/*
+ * Open MPI only reliably honours forced algorithms when
+ * coll_tuned_use_dynamic_rules is set. Only the switch of the component that
+ * owns the tuned cvar is considered, named <prefix>use_dynamic_rules or
+ * <prefix><coll>_use_dynamic_rules, so that the algorithm selection of other
+ * components and collectives is left alone. The variable is switched on when
+ * it is writable; otherwise a warning is printed and -1 returned. Libraries
+ * without such a switch need nothing.
+ */
+int omb_mpit_enable_dynamic_rules(const omb_mpit_cvar_t *cvar,
+                                  const char *coll, int rank)
+{
+    int num_cvars = 0, i = 0, name_len = 0, desc_len = 0, verbosity = 0;
+    int bind = 0, scope = 0, count = 0, type_size = 0, value = 0;
+    char name[OMB_MPIT_NAME_MAX_LENGTH], buf[64];
+    char prefix[OMB_MPIT_NAME_MAX_LENGTH], pattern[OMB_MPIT_NAME_MAX_LENGTH];
+    char component_rules[2 * OMB_MPIT_NAME_MAX_LENGTH];
+    char coll_rules[3 * OMB_MPIT_NAME_MAX_LENGTH];
+    char *match = NULL;
+    MPI_Datatype datatype;
+    MPI_T_enum enumtype;
+    MPI_T_cvar_handle handle;
+
+    strcpy(prefix, cvar->name);
+    omb_mpit_lowercase(prefix);
+    snprintf(pattern, sizeof(pattern), "_%s_", coll);
+    omb_mpit_lowercase(pattern);
+    match = strstr(prefix, pattern);
+    if (NULL == match) {
+        return 0;
+    }
+    match[1] = '\0';
+    snprintf(component_rules, sizeof(component_rules), "%suse_dynamic_rules",
+             prefix);
+    snprintf(coll_rules, sizeof(coll_rules), "%s%suse_dynamic_rules", prefix,
+             pattern + 1);
+    MPI_CHECK(MPI_T_cvar_get_num(&num_cvars));
+    for (i = 0; i < num_cvars; i++) {
+        name_len = sizeof(name);
+        desc_len = 0;
+        if (MPI_SUCCESS != MPI_T_cvar_get_info(i, name, &name_len, &verbosity,
+                                               &datatype, &enumtype, NULL,
+                                               &desc_len, &bind, &scope)) {
+            continue;
+        }
+        omb_mpit_lowercase(name);
+        if ((strcmp(name, component_rules) && strcmp(name, coll_rules)) ||
+            MPI_T_BIND_NO_OBJECT != bind) {
+            continue;
+        }
+        MPI_CHECK(MPI_Type_size(datatype, &type_size));
+        if (type_size <= 0 || (size_t)type_size > sizeof(buf)) {
+            continue;
+        }
+        MPI_CHECK(MPI_T_cvar_handle_alloc(i, NULL, &handle, &count));
+        memset(buf, 0, sizeof(buf));
+        MPI_CHECK(MPI_T_cvar_read(handle, buf));
+        for (value = 0; value < type_size && !buf[value]; value++) {
+        }
+        if (value == type_size) {
+            if (omb_mpit_cvar_writable(scope)) {
+                memset(buf, 0, sizeof(buf));
+                if (1 == type_size) {
+                    buf[0] = 1;
+                } else {
+                    value = 1;
+                    memcpy(buf, &value, sizeof(int));
+                }
+                MPI_CHECK(MPI_T_cvar_write(handle, buf));
+            } else {
+                if (0 == rank) {
+                    fprintf(stderr,
+                            "Warning: %s is disabled and read-only, forced"
+                            " algorithms may be ignored. Set it before"
+                            " MPI_Init, e.g. through the environment.\n",
+                            name);
+                }
+                MPI_CHECK(MPI_T_cvar_handle_free(&handle));
+                return -1;
+            }
+        }
+        MPI_CHECK(MPI_T_cvar_handle_free(&handle));
+    }
+    return 0;
+}
+
+/*
+ * Algorithms are usually fixed when a communicator is created, so callers
+ * should create a fresh communicator after writing the variable.
+ */
+void omb_mpit_cvar_write(omb_mpit_cvar_t *cvar, int value)
+{
+    MPI_CHECK(MPI_T_cvar_write(cvar->handle, &value));
+}
+
+void omb_mpit_cvar_free(omb_mpit_cvar_t *cvar)
+{
+    omb_mpit_cvar_write(cvar, cvar->default_value);
+    MPI_CHECK(MPI_T_cvar_handle_free(&cvar->handle));
+}
+
+/* Counters, aggregates and timers are reported as deltas, others as is. */
+static int omb_mpit_pvar_is_delta(omb_mpit_pvar_t *pvar)
+{
+    return MPI_T_PVAR_CLASS_COUNTER == pvar->var_class ||
+           MPI_T_PVAR_CLASS_AGGREGATE == pvar->var_class ||
+           MPI_T_PVAR_CLASS_TIMER == pvar->var_class;
+}
+
+static double omb_mpit_pvar_read(omb_mpit_pvar_t *pvar)
+{
+    union {
+        int i;
+        unsigned u;
+        unsigned long ul;
+        unsigned long long ull;
+        double d;
+    } value;
+
+    memset(&value, 0, sizeof(value));
+    if (MPI_SUCCESS !=
+        MPI_T_pvar_read(omb_mpit_session, pvar->handle, &value)) {
+        return 0;
+    }
+    if (MPI_INT == pvar->datatype) {
+        return value.i;
+    } else if (MPI_UNSIGNED == pvar->datatype) {
+        return value.u;
+    } else if (MPI_UNSIGNED_LONG == pvar->datatype) {
+        return value.ul;
+    } else if (MPI_UNSIGNED_LONG_LONG == pvar->datatype) {
+        return value.ull;
+    }
+    return value.d;
+}
+
+/*
+ * A variable is sampled if no filter was given or its name contains one of
+ * the comma separated substrings of the filter.
+ */
+static int omb_mpit_pvar_selected(const char *name)
+{
+    char filter[OMB_MPIT_FILTER_MAX_LENGTH];
+    char *token = NULL;
+
+    if ('\0' == options.omb_mpit_pvar_filter[0]) {
+        return 1;
+    }
+    strcpy(filter, options.omb_mpit_pvar_filter);
+    for (token = strtok(filter, ","); NULL != token;
+         token = strtok(NULL, ",")) {
+        if (NULL != strstr(name, token)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Opens a pvar session with a handle for every scalar performance variable
+ * that is not bound to an MPI object and starts the ones that are not
+ * continuous. Sampling is disabled when the processes expose different sets
+ * of variables, since their values are reduced element-wise.
+ */
+void omb_mpit_pvar_init(void)
+{
+    int num = 0, i = 0, name_len = 0, desc_len = 0, verbosity = 0;
+    int var_class = 0, bind = 0, readonly = 0, continuous = 0, atomic = 0;
+    int count = 0, rank = 0, min_pvars = 0, max_pvars = 0;
+    MPI_Datatype datatype;
+    MPI_T_enum enumtype;
+    omb_mpit_pvar_t *pvar = NULL;
+
+    omb_mpit_num_pvars = 0;
+    omb_mpit_num_records = 0;
+    if (!options.mpit_pvars_enabled) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    omb_mpit_init();
+    MPI_CHECK(MPI_T_pvar_session_create(&omb_mpit_session));
+    MPI_CHECK(MPI_T_pvar_get_num(&num));
+    omb_mpit_pvars = malloc(MAX(num, 1) * sizeof(omb_mpit_pvar_t));
+    OMB_CHECK_NULL_AND_EXIT(omb_mpit_pvars, "Unable to allocate memory");
+    for (i = 0; i < num; i++) {
+        pvar = &omb_mpit_pvars[omb_mpit_num_pvars];
+        name_len = OMB_MPIT_NAME_MAX_LENGTH;
+        desc_len = 0;
+        if (MPI_SUCCESS !=
+            MPI_T_pvar_get_info(i, pvar->name, &name_len, &verbosity,
+                                &var_class, &datatype, &enumtype, NULL,
+                                &desc_len, &bind, &readonly, &continuous,
+                                &atomic)) {
+            continue;
+        }
+        if (MPI_T_BIND_NO_OBJECT != bind ||
+            !omb_mpit_pvar_selected(pvar->name) ||
+            (MPI_INT != datatype && MPI_UNSIGNED != datatype &&
+             MPI_UNSIGNED_LONG != datatype &&
+             MPI_UNSIGNED_LONG_LONG != datatype && MPI_DOUBLE != datatype)) {
+            continue;
+        }
+        if (MPI_SUCCESS != MPI_T_pvar_handle_alloc(omb_mpit_session, i, NULL,
+                                                   &pvar->handle, &count)) {
+            continue;
+        }
+        if (1 != count ||
+            (!continuous && MPI_SUCCESS != MPI_T_pvar_start(omb_mpit_session,
+                                                            pvar->handle))) {
+            MPI_T_pvar_handle_free(omb_mpit_session, &pvar->handle);
+            continue;
+        }
+        pvar->var_class = var_class;
+        pvar->datatype = datatype;
+        omb_mpit_num_pvars++;
+    }
+    MPI_CHECK(MPI_Allreduce(&omb_mpit_num_pvars, &min_pvars, 1, MPI_INT,
+                            MPI_MIN, MPI_COMM_WORLD));
+    MPI_CHECK(MPI_Allreduce(&omb_mpit_num_pvars, &max_pvars, 1, MPI_INT,
+                            MPI_MAX, MPI_COMM_WORLD));
+    if (min_pvars != max_pvars || 0 == max_pvars) {
+        if (0 == rank) {
+            fprintf(stderr, "Warning! No common set of MPI_T performance"
+                            " variables, sampling disabled.\n");
+            fflush(stderr);
+        }
+        omb_mpit_pvar_print_and_free();
+        return;
+    }
+    omb_mpit_record_values =
+        malloc(OMB_MPIT_MAX_RECORDS * omb_mpit_num_pvars * sizeof(double));
+    OMB_CHECK_NULL_AND_EXIT(omb_mpit_record_values,
+                            "Unable to allocate memory");
+}
+
+void omb_mpit_pvar_start(void)
+{
+    int i = 0;
+
+    for (i = 0; i < omb_mpit_num_pvars; i++) {
+        omb_mpit_pvars[i].start = omb_mpit_pvar_read(&omb_mpit_pvars[i]);
+    }
+}
+
+/* Averages the deltas of this message size over all processes. */
+void omb_mpit_pvar_stop(size_t size)
+{
+    int i = 0, rank = 0, numprocs = 0;
+    double *values = NULL;
+
+    if (!omb_mpit_num_pvars) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+    values = malloc(omb_mpit_num_pvars * sizeof(double));
+    OMB_CHECK_NULL_AND_EXIT(values, "Unable to allocate memory");
+    for (i = 0; i < omb_mpit_num_pvars; i++) {
+        values[i] = omb_mpit_pvar_read(&omb_mpit_pvars[i]);
+        if (omb_mpit_pvar_is_delta(&omb_mpit_pvars[i])) {
+            values[i] -= omb_mpit_pvars[i].start;
+        }
+    }
+    MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, values, omb_mpit_num_pvars,
+                            MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD));
+    if (0 == rank && OMB_MPIT_MAX_RECORDS > omb_mpit_num_records) {
+        omb_mpit_record_sizes[omb_mpit_num_records] = size;
+        for (i = 0; i < omb_mpit_num_pvars; i++) {
+            omb_mpit_record_values[omb_mpit_num_records * omb_mpit_num_pvars +
+                                   i] = values[i] / numprocs;
+        }
+        omb_mpit_num_records++;
+    }
+    free(values);
+}
+
+/*
+ * Prints one column per variable that was non-zero for at least one message
+ * size, with a legend of the variable names, and closes the session.
+ */
+void omb_mpit_pvar_print_and_free(void)
+{
+    int i = 0, j = 0, rank = 0, column = 0;
+    int *active = NULL;
+
+    if (NULL == omb_mpit_pvars) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    if (0 == rank && omb_mpit_num_records) {
+        active = calloc(omb_mpit_num_pvars, sizeof(int));
+        OMB_CHECK_NULL_AND_EXIT(active, "Unable to allocate memory");
+        for (j = 0; j < omb_mpit_num_records; j++) {
+            for (i = 0; i < omb_mpit_num_pvars; i++) {
+                active[i] |= (0 != omb_mpit_record_values
+                                       [j * omb_mpit_num_pvars + i]);
+            }
+        }
+        fprintf(stdout, "\n# MPI_T performance variables (average per"
+                        " process, counters as deltas over the timed loop)\n");
+        for (i = 0; i < omb_mpit_num_pvars; i++) {
+            if (active[i]) {
+                fprintf(stdout, "# [%d] %s%s\n", ++column,
+                        omb_mpit_pvars[i].name,
+                        omb_mpit_pvar_is_delta(&omb_mpit_pvars[i]) ?
+                            "" :
+                            " (value after the timed loop)");
+            }
+        }
+        if (0 == column) {
+            fprintf(stdout, "# All variables stayed zero\n");
+        } else {
+            fprintf(stdout, "%-*s", 10, "# Size");
+            for (column = 0, i = 0; i < omb_mpit_num_pvars; i++) {
+                if (active[i]) {
+                    fprintf(stdout, "%*s[%d]", FIELD_WIDTH - 2 -
+                                                  (column + 1 > 9) -
+                                                  (column + 1 > 99),
+                            "", column + 1);
+                    column++;
+                }
+            }
+            fprintf(stdout, "\n");
+            for (j = 0; j < omb_mpit_num_records; j++) {
+                fprintf(stdout, "%-*zu", 10, omb_mpit_record_sizes[j]);
+                for (i = 0; i < omb_mpit_num_pvars; i++) {
+                    if (active[i]) {
+                        fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION,
+                                omb_mpit_record_values
+                                    [j * omb_mpit_num_pvars + i]);
+                    }
+                }
+                fprintf(stdout, "\n");
+            }
+        }
+        fflush(stdout);
+        free(active);
+    }
+    for (i = 0; i < omb_mpit_num_pvars; i++) {
+        MPI_T_pvar_handle_free(omb_mpit_session, &omb_mpit_pvars[i].handle);
+    }
+    MPI_CHECK(MPI_T_pvar_session_free(&omb_mpit_session));
+    omb_mpit_finalize();
+    free(omb_mpit_pvars);
+    free(omb_mpit_record_values);
+    omb_mpit_pvars = NULL;
+    omb_mpit_record_values = NULL;
+    omb_mpit_num_pvars = 0;
+    omb_mpit_num_records = 0;
+}
+#endif /*#ifdef _ENABLE_MPIT_*/
+
+/* vi:set sw=4 sts=4 tw=80: */
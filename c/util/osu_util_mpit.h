@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#ifndef OSU_UTIL_MPIT_H
+#define OSU_UTIL_MPIT_H
+
+#include "osu_util_mpi.h"
+
+#if MPI_VERSION >= 3
+#define _ENABLE_MPIT_ 1
+#endif
+
+#define OMB_MPIT_NAME_MAX_LENGTH 256
+#define OMB_MPIT_MAX_CANDIDATES  32
+/*
+ * Maximum number of message sizes (across all datatypes) for which pvar
+ * deltas are kept until they are printed by omb_mpit_pvar_print_and_free().
+ */
+#define OMB_MPIT_MAX_RECORDS 256
+
+#ifdef _ENABLE_MPIT_
+/*
+ * An integer control variable of the MPI library that selects the algorithm
+ * of one collective, together with the values its enumeration offers.
+ */
+typedef struct omb_mpit_cvar {
+    int index;
+    char name[OMB_MPIT_NAME_MAX_LENGTH];
+    MPI_T_cvar_handle handle;
+    int default_value;
+    int num_candidates;
+    int values[OMB_MPIT_MAX_CANDIDATES];
+    char value_names[OMB_MPIT_MAX_CANDIDATES][OMB_MPIT_NAME_MAX_LENGTH];
+} omb_mpit_cvar_t;
+
+/* A scalar performance variable that is not bound to an MPI object. */
+typedef struct omb_mpit_pvar {
+    char name[OMB_MPIT_NAME_MAX_LENGTH];
+    int var_class;
+    MPI_Datatype datatype;
+    MPI_T_pvar_handle handle;
+    double start;
+} omb_mpit_pvar_t;
+
+void omb_mpit_init(void);
+void omb_mpit_finalize(void);
+int omb_mpit_find_algorithm_cvar(const char *coll, omb_mpit_cvar_t *cvar);
+int omb_mpit_enable_dynamic_rules(const omb_mpit_cvar_t *cvar,
+                                  const char *coll, int rank);
+void omb_mpit_cvar_write(omb_mpit_cvar_t *cvar, int value);
+void omb_mpit_cvar_free(omb_mpit_cvar_t *cvar);
+void omb_mpit_pvar_init(void);
+void omb_mpit_pvar_start(void);
+void omb_mpit_pvar_stop(size_t size);
+void omb_mpit_pvar_print_and_free(void);
+#endif /*#ifdef _ENABLE_MPIT_*/
+
+#endif
@@ -54,25 +54,60 @@
             {"in-place", no_argument, 0, 'l'},                                 \
             {"tail-lat", optional_argument, 0, 'z'},                           \
             {"partitions", optional_argument, 0, 'q'},                         \
+            {"perf-events", no_argument, 0, 'e'},                              \
+            {"collective", required_argument, 0, 'C'},                         \
+            {"tuning-file", required_argument, 0, 'o'},                        \
+            {"mpit-pvars", optional_argument, 0, 'M'},                         \
+            {"match-pattern", required_argument, 0, 'A'},                      \
+            {"match-position", required_argument, 0, 'L'},                     \
+            {"skew", required_argument, 0, 'S'},                               \
+            {"comm-sizes", required_argument, 0, 'g'},                         \
+            {"op", required_argument, 0, 'O'},                                 \
+            {"traffic-pattern", required_argument, 0, 'F'},                    \
+            {"interference", required_argument, 0, 'Y'},                       \
+            {"bisection", required_argument, 0, 'B'},                          \
+            {"groups", required_argument, 0, 'j'},                             \
+            {"bind", required_argument, 0, 'H'},                               \
+            {"mem-contention", required_argument, 0, 'X'},                     \
+            {"mem-limit", required_argument, 0, 'U'},                          \
+            {"buffer-policy", required_argument, 0, 'E'},                      \
         {                                                                      \
             "root-rank", required_argument, 0, 'k'                             \
         }                                                                      \
     }
 /*OMBOP[__ACCEL]__<options.bench>__<options.subtype>*/
-#define OMBOP__PT2PT__LAT                    "+:hvm:x:i:b:c::u:G:D:P:T:Iz::"
-#define OMBOP__PT2PT__PART_LAT               "+:hvm:x:i:b:c::u:G:D:P:T:Iz::q:"
-#define OMBOP__ACCEL__PT2PT__LAT             "+:x:i:m:d:hvc::u:G:D:T:Iz::"
-#define OMBOP__ACCEL__PT2PT__PART_LAT        "+:x:i:m:d:hvc::u:G:D:T:Iz::q:"
-#define OMBOP__PT2PT__BW                     "+:hvm:x:i:t:W:b:c::u:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__PT2PT__BW              "+:x:i:t:m:d:W:hvb:c::u:G:D:T:Iz::"
-#define OMBOP__PT2PT__LAT_MT                 "+:hvm:x:i:t:c::u:G:D:T:Iz::"
+#define OMBOP__PT2PT__LAT                    "+:hvm:x:i:b:c::u:G:eM::D:P:T:Iz::H:U:E:"
+#define OMBOP__PT2PT__PART_LAT               "+:hvm:x:i:b:c::u:G:eM::D:P:T:Iz::q:H:"
+#define OMBOP__ACCEL__PT2PT__LAT             "+:x:i:m:d:hvc::u:G:eM::D:T:Iz::H:U:E:"
+#define OMBOP__ACCEL__PT2PT__PART_LAT        "+:x:i:m:d:hvc::u:G:eM::D:T:Iz::q:H:"
+#define OMBOP__PT2PT__BW                     "+:hvm:x:i:t:W:b:c::u:G:eM::D:P:T:Iz::H:X:U:E:"
+#define OMBOP__ACCEL__PT2PT__BW              "+:x:i:t:m:d:W:hvb:c::u:G:eM::D:T:Iz::H:X:U:E:"
+#define OMBOP__PT2PT__LAT_MT                 "+:hvm:x:i:t:c::u:G:D:T:Iz::H:"
 #define OMBOP__ACCEL__PT2PT__LAT_MT          OMBOP__ACCEL__PT2PT__LAT
-#define OMBOP__PT2PT__LAT_MP                 "+:hvm:x:i:t:c::u:G:D:P:T:Iz::"
+#define OMBOP__PT2PT__LAT_MP                 "+:hvm:x:i:t:c::u:G:eM::D:P:T:Iz::H:"
 #define OMBOP__ACCEL__PT2PT__LAT_MP          OMBOP__ACCEL__PT2PT__LAT
-#define OMBOP__COLLECTIVE__ALLTOALL          "+:hvfm:i:x:a:c::u:G:D:P:T:Ilz::"
-#define OMBOP__ACCEL__COLLECTIVE__ALLTOALL   "+:d:hvfm:i:x:a:c::u:G:D:T:Ilz::"
-#define OMBOP__PT2PT__CONG_BW                "+:hvm:x:i:W:b:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__PT2PT__CONG_BW         "p:W:R:x:i:m:d:Vhvb:G:D:T:Iz::"
+#define OMBOP__PT2PT__SHM_BASELINE_LAT       "+:hvm:x:i:IH:"
+#define OMBOP__ACCEL__PT2PT__SHM_BASELINE_LAT OMBOP__PT2PT__SHM_BASELINE_LAT
+#define OMBOP__PT2PT__SHM_BASELINE_BW        "+:hvm:x:i:W:IH:"
+#define OMBOP__ACCEL__PT2PT__SHM_BASELINE_BW OMBOP__PT2PT__SHM_BASELINE_BW
+#define OMBOP__PT2PT__PT2PT_OVERLAP          "+:hvm:x:i:t:H:"
+#define OMBOP__ACCEL__PT2PT__PT2PT_OVERLAP   OMBOP__PT2PT__PT2PT_OVERLAP
+#define OMBOP__PT2PT__LOGGP                  "+:hvm:x:i:W:H:"
+#define OMBOP__ACCEL__PT2PT__LOGGP           OMBOP__PT2PT__LOGGP
+#define OMBOP__PT2PT__MATCHING               "+:hvm:x:i:A:L:H:"
+#define OMBOP__ACCEL__PT2PT__MATCHING        OMBOP__PT2PT__MATCHING
+#define OMBOP__COLLECTIVE__ALLTOALL          "+:hvfm:i:x:a:c::u:G:eM::D:P:T:Ilz::S:H:U:"
+#define OMBOP__ACCEL__COLLECTIVE__ALLTOALL   "+:d:hvfm:i:x:a:c::u:G:eM::D:T:Ilz::S:H:U:"
+#define OMBOP__PT2PT__CONG_BW                "+:hvm:x:i:W:b:G:eM::D:P:T:Iz::H:"
+#define OMBOP__ACCEL__PT2PT__CONG_BW         "p:W:R:x:i:m:d:Vhvb:G:eM::D:T:Iz::H:"
+#define OMBOP__PT2PT__CONG_PATTERN           "+:hvm:x:i:W:F:H:"
+#define OMBOP__ACCEL__PT2PT__CONG_PATTERN    OMBOP__PT2PT__CONG_PATTERN
+#define OMBOP__PT2PT__CONG_IMPACT            "+:hvm:x:i:Y:H:"
+#define OMBOP__ACCEL__PT2PT__CONG_IMPACT     OMBOP__PT2PT__CONG_IMPACT
+#define OMBOP__PT2PT__CONG_BISECTION         "+:hvm:x:i:W:B:H:"
+#define OMBOP__ACCEL__PT2PT__CONG_BISECTION  OMBOP__PT2PT__CONG_BISECTION
+#define OMBOP__PT2PT__MT_MBW_MR              "+:hvm:x:i:W:t:H:"
+#define OMBOP__ACCEL__PT2PT__MT_MBW_MR       OMBOP__PT2PT__MT_MBW_MR
 #define OMBOP__COLLECTIVE__GATHER            OMBOP__COLLECTIVE__ALLTOALL "k:"
 #define OMBOP__ACCEL__COLLECTIVE__GATHER     OMBOP__ACCEL__COLLECTIVE__ALLTOALL "k:"
 #define OMBOP__COLLECTIVE__ALL_GATHER        OMBOP__COLLECTIVE__ALLTOALL
@@ -80,30 +115,30 @@
 #define OMBOP__COLLECTIVE__SCATTER           OMBOP__COLLECTIVE__ALLTOALL "k:"
 #define OMBOP__ACCEL__COLLECTIVE__SCATTER                                      \
     OMBOP__ACCEL__COLLECTIVE__ALLTOALL "k:"
-#define OMBOP__COLLECTIVE__BCAST              "+:hvfm:i:x:a:c::u:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__BCAST       "+:d:hvfm:i:x:a:c::u:G:D:T:Iz::"
-#define OMBOP__COLLECTIVE__NHBR_GATHER        "+:hvfm:i:x:a:c::u:N:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__NHBR_GATHER "+:d:hvfm:i:x:a:c::u:N:G:D:T:Iz::"
+#define OMBOP__COLLECTIVE__BCAST              "+:hvfm:i:x:a:c::u:G:eM::D:P:T:Iz::S:H:U:E:"
+#define OMBOP__ACCEL__COLLECTIVE__BCAST       "+:d:hvfm:i:x:a:c::u:G:eM::D:T:Iz::S:H:U:E:"
+#define OMBOP__COLLECTIVE__NHBR_GATHER        "+:hvfm:i:x:a:c::u:N:G:eM::D:P:T:Iz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__NHBR_GATHER "+:d:hvfm:i:x:a:c::u:N:G:eM::D:T:Iz::H:"
 #define OMBOP__COLLECTIVE__NHBR_ALLTOALL      OMBOP__COLLECTIVE__NHBR_GATHER
 #define OMBOP__ACCEL__COLLECTIVE__NHBR_ALLTOALL                                \
     OMBOP__ACCEL__COLLECTIVE__NHBR_GATHER
-#define OMBOP__COLLECTIVE__BARRIER           "+:hvfm:i:x:a:u:G:P:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__BARRIER    "+:d:hvfm:i:x:a:u:G:Iz::"
-#define OMBOP__COLLECTIVE__LAT               "+:hvfm:i:x:a:z::"
-#define OMBOP__ACCEL__COLLECTIVE__LAT        "+:d:hvfm:i:x:a:z::"
-#define OMBOP__COLLECTIVE__ALL_REDUCE        "+:hvfm:i:x:a:c::u:G:P:T:Ilz::"
-#define OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE "+:d:hvfm:i:x:a:c::u:G:T:Ilz::"
+#define OMBOP__COLLECTIVE__BARRIER           "+:hvfm:i:x:a:u:G:eM::P:Iz::S:H:"
+#define OMBOP__ACCEL__COLLECTIVE__BARRIER    "+:d:hvfm:i:x:a:u:G:eM::Iz::S:H:"
+#define OMBOP__COLLECTIVE__LAT               "+:hvfm:i:x:a:z::H:"
+#define OMBOP__ACCEL__COLLECTIVE__LAT        "+:d:hvfm:i:x:a:z::H:"
+#define OMBOP__COLLECTIVE__ALL_REDUCE        "+:hvfm:i:x:a:c::u:G:eM::P:T:O:Ilz::S:H:U:E:"
+#define OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE "+:d:hvfm:i:x:a:c::u:G:eM::T:O:Ilz::S:H:U:E:"
 #define OMBOP__COLLECTIVE__REDUCE            OMBOP__COLLECTIVE__ALL_REDUCE "k:"
 #define OMBOP__ACCEL__COLLECTIVE__REDUCE                                       \
     OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE "k:"
 #define OMBOP__COLLECTIVE__REDUCE_SCATTER OMBOP__COLLECTIVE__ALL_REDUCE
 #define OMBOP__ACCEL__COLLECTIVE__REDUCE_SCATTER                               \
     OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE
-#define OMBOP__COLLECTIVE__NBC_BARRIER        "+:hvfm:i:x:t:a:G:P:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__NBC_BARRIER "+:d:hvfm:i:x:t:a:G:Iz::"
-#define OMBOP__COLLECTIVE__NBC_ALLTOALL       "+:hvfm:i:x:t:a:c::u:G:D:P:T:Ilz::"
+#define OMBOP__COLLECTIVE__NBC_BARRIER        "+:hvfm:i:x:t:a:G:eM::P:Iz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__NBC_BARRIER "+:d:hvfm:i:x:t:a:G:eM::Iz::H:"
+#define OMBOP__COLLECTIVE__NBC_ALLTOALL       "+:hvfm:i:x:t:a:c::u:G:eM::D:P:T:Ilz::H:"
 #define OMBOP__ACCEL__COLLECTIVE__NBC_ALLTOALL                                 \
-    "+:d:hvfm:i:x:t:a:c::u:G:D:T:Ilz::"
+    "+:d:hvfm:i:x:t:a:c::u:G:eM::D:T:Ilz::H:"
 #define OMBOP__COLLECTIVE__NBC_GATHER OMBOP__COLLECTIVE__NBC_ALLTOALL "k:"
 #define OMBOP__ACCEL__COLLECTIVE__NBC_GATHER                                   \
     OMBOP__ACCEL__COLLECTIVE__NBC_ALLTOALL "k:"
@@ -113,36 +148,51 @@
 #define OMBOP__COLLECTIVE__NBC_SCATTER OMBOP__COLLECTIVE__NBC_ALLTOALL "k:"
 #define OMBOP__ACCEL__COLLECTIVE__NBC_SCATTER                                  \
     OMBOP__ACCEL__COLLECTIVE__NBC_ALLTOALL "k:"
-#define OMBOP__COLLECTIVE__NBC_BCAST        "+:hvfm:i:x:t:a:c::u:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__NBC_BCAST "+:d:hvfm:i:x:t:a:c::u:G:D:T:Iz::"
-#define OMBOP__COLLECTIVE__NBC_ALL_REDUCE   "+:hvfm:i:x:t:a:c::u:G:P:T:Ilz::"
+#define OMBOP__COLLECTIVE__NBC_BCAST        "+:hvfm:i:x:t:a:c::u:G:eM::D:P:T:Iz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__NBC_BCAST "+:d:hvfm:i:x:t:a:c::u:G:eM::D:T:Iz::H:"
+#define OMBOP__COLLECTIVE__NBC_ALL_REDUCE   "+:hvfm:i:x:t:a:c::u:G:eM::P:T:O:Ilz::H:"
 #define OMBOP__ACCEL__COLLECTIVE__NBC_ALL_REDUCE                               \
-    "+:d:hvfm:i:x:t:a:c::u:G:T:Ilz::"
+    "+:d:hvfm:i:x:t:a:c::u:G:eM::T:O:Ilz::H:"
 #define OMBOP__COLLECTIVE__NBC_REDUCE OMBOP__COLLECTIVE__NBC_ALL_REDUCE "k:"
 #define OMBOP__ACCEL__COLLECTIVE__NBC_REDUCE                                   \
     OMBOP__ACCEL__COLLECTIVE__NBC_ALL_REDUCE "k:"
 #define OMBOP__COLLECTIVE__NBC_REDUCE_SCATTER OMBOP__COLLECTIVE__NBC_ALL_REDUCE
 #define OMBOP__ACCEL__COLLECTIVE__NBC_REDUCE_SCATTER                           \
     OMBOP__ACCEL__COLLECTIVE__NBC_ALL_REDUCE
-#define OMBOP__COLLECTIVE__NBC_NHBR_GATHER "+:hvfm:i:x:t:a:c::u:N:G:D:P:T:Iz::"
+#define OMBOP__COLLECTIVE__NBC_NHBR_GATHER "+:hvfm:i:x:t:a:c::u:N:G:eM::D:P:T:Iz::H:"
 #define OMBOP__ACCEL__COLLECTIVE__NBC_NHBR_GATHER                              \
-    "+:d:hvfm:i:x:t:a:c::u:N:G:D:T:Iz::"
+    "+:d:hvfm:i:x:t:a:c::u:N:G:eM::D:T:Iz::H:"
 #define OMBOP__COLLECTIVE__NBC_NHBR_ALLTOALL OMBOP__COLLECTIVE__NBC_NHBR_GATHER
 #define OMBOP__ACCEL__COLLECTIVE__NBC_NHBR_ALLTOALL                            \
     OMBOP__ACCEL__COLLECTIVE__NBC_NHBR_GATHER
-#define OMBOP__ONE_SIDED__BW         "+:w:s:hvm:x:i:W:G:P:I"
-#define OMBOP__ACCEL__ONE_SIDED__BW  "+:w:s:hvm:d:x:i:W:G:I"
-#define OMBOP__ONE_SIDED__LAT        "+:w:s:hvm:x:i:G:P:I"
-#define OMBOP__ACCEL__ONE_SIDED__LAT "+:w:s:hvm:d:x:i:G:I"
-#define OMBOP__MBW_MR                "p:W:R:x:i:m:Vhvb:c::u:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__MBW_MR         "p:W:R:x:i:m:d:Vhvb:c::u:G:D:T:Iz::"
+#define OMBOP__ONE_SIDED__BW         "+:w:s:hvm:x:i:W:G:eM::P:IH:"
+#define OMBOP__ACCEL__ONE_SIDED__BW  "+:w:s:hvm:d:x:i:W:G:eM::IH:"
+#define OMBOP__ONE_SIDED__LAT        "+:w:s:hvm:x:i:G:eM::P:IH:"
+#define OMBOP__ACCEL__ONE_SIDED__LAT "+:w:s:hvm:d:x:i:G:eM::IH:"
+#define OMBOP__ONE_SIDED__SHM_LAT    "+:hvm:x:i:IH:"
+#define OMBOP__ONE_SIDED__SHM_BW     "+:hvm:x:i:W:IH:"
+#define OMBOP__MBW_MR                "p:W:R:x:i:m:Vhvb:c::u:G:eM::D:P:T:Iz::H:X:"
+#define OMBOP__ACCEL__MBW_MR         "p:W:R:x:i:m:d:Vhvb:c::u:G:eM::D:T:Iz::H:X:"
 #define OMBOP__OSHM                  ":hvfm:i:";
 #define OMBOP__UPC                   OMBOP__OSHM
 #define OMBOP__UPCXX                 OMBOP__OSHM
 #define OMBOP__STARTUP__INIT         "I"
+#define OMBOP__STARTUP__LAT          "+:hvfi:x:I"
+#define OMBOP__STARTUP__OBJ_CREATE   "+:hvm:i:x:I"
+#define OMBOP__COLLECTIVE__COLL_AUTOTUNE        "+:hvm:i:x:C:o:H:"
+#define OMBOP__ACCEL__COLLECTIVE__COLL_AUTOTUNE OMBOP__COLLECTIVE__COLL_AUTOTUNE
+#define OMBOP__COLLECTIVE__COLL_SCALING         "+:hvm:i:x:C:g:H:"
+#define OMBOP__ACCEL__COLLECTIVE__COLL_SCALING  OMBOP__COLLECTIVE__COLL_SCALING
+#define OMBOP__COLLECTIVE__COLL_CONCURRENT      "+:hvm:i:x:C:j:H:"
+#define OMBOP__ACCEL__COLLECTIVE__COLL_CONCURRENT                              \
+    OMBOP__COLLECTIVE__COLL_CONCURRENT
+#define OMBOP__COLLECTIVE__COLL_MT              "+:hvm:i:x:C:t:H:"
+#define OMBOP__ACCEL__COLLECTIVE__COLL_MT       OMBOP__COLLECTIVE__COLL_MT
+#define OMBOP__COLLECTIVE__REDUCE_LOCAL         "+:hvm:i:x:T:O:H:"
+#define OMBOP__ACCEL__COLLECTIVE__REDUCE_LOCAL  OMBOP__COLLECTIVE__REDUCE_LOCAL
 /*Persistent Collectives*/
-#define OMBOP__COLLECTIVE__ALLTOALL_P        "+:hvfm:i:x:a:c::u:G:D:P:T:Ilz::"
-#define OMBOP__ACCEL__COLLECTIVE__ALLTOALL_P "+:d:hvfm:i:x:a:c::u:G:D:T:Ilz::"
+#define OMBOP__COLLECTIVE__ALLTOALL_P        "+:hvfm:i:x:a:c::u:G:eM::D:P:T:Ilz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__ALLTOALL_P "+:d:hvfm:i:x:a:c::u:G:eM::D:T:Ilz::H:"
 #define OMBOP__COLLECTIVE__GATHER_P          OMBOP__COLLECTIVE__ALLTOALL_P
 #define OMBOP__ACCEL__COLLECTIVE__GATHER_P   OMBOP__ACCEL__COLLECTIVE__ALLTOALL_P
 #define OMBOP__COLLECTIVE__ALL_GATHER_P      OMBOP__COLLECTIVE__ALLTOALL_P
@@ -150,12 +200,12 @@
     OMBOP__ACCEL__COLLECTIVE__ALLTOALL_P
 #define OMBOP__COLLECTIVE__SCATTER_P           OMBOP__COLLECTIVE__ALLTOALL_P
 #define OMBOP__ACCEL__COLLECTIVE__SCATTER_P    OMBOP__ACCEL__COLLECTIVE__ALLTOALL_P
-#define OMBOP__COLLECTIVE__BCAST_P             "+:hvfm:i:x:a:c::u:G:D:P:T:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__BCAST_P      "+:d:hvfm:i:x:a:c::u:G:D:T:Iz::"
-#define OMBOP__COLLECTIVE__BARRIER_P           "+:hvfm:i:x:a:u:G:P:Iz::"
-#define OMBOP__ACCEL__COLLECTIVE__BARRIER_P    "+:d:hvfm:i:x:a:u:G:Iz::"
-#define OMBOP__COLLECTIVE__ALL_REDUCE_P        "+:hvfm:i:x:a:c::u:G:P:T:Ilz::"
-#define OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE_P "+:d:hvfm:i:x:a:c::u:G:T:Ilz::"
+#define OMBOP__COLLECTIVE__BCAST_P             "+:hvfm:i:x:a:c::u:G:eM::D:P:T:Iz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__BCAST_P      "+:d:hvfm:i:x:a:c::u:G:eM::D:T:Iz::H:"
+#define OMBOP__COLLECTIVE__BARRIER_P           "+:hvfm:i:x:a:u:G:eM::P:Iz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__BARRIER_P    "+:d:hvfm:i:x:a:u:G:eM::Iz::H:"
+#define OMBOP__COLLECTIVE__ALL_REDUCE_P        "+:hvfm:i:x:a:c::u:G:eM::P:T:O:Ilz::H:"
+#define OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE_P "+:d:hvfm:i:x:a:c::u:G:eM::T:O:Ilz::H:"
 #define OMBOP__COLLECTIVE__REDUCE_P            OMBOP__COLLECTIVE__ALL_REDUCE_P
 #define OMBOP__ACCEL__COLLECTIVE__REDUCE_P                                     \
     OMBOP__ACCEL__COLLECTIVE__ALL_REDUCE_P
@@ -173,11 +223,15 @@
                   "~~bytes respectively. Examples:"                            \
                   "~~-m 128      // min = default, max = 128"                  \
                   "~~-m 2:128    // min = 2, max = 128"                        \
-                  "~~-m 2:       // min = 2, max = default"},                  \
+                  "~~-m 2:       // min = 2, max = default"                    \
+                  "~~-m 1M:4G    // K, M and G suffixes, powers of 1024"       \
+                  "~~osu_matching-> [MIN:]MAX - set the queue depth range "    \
+                  "(default 1:131072)"},                                       \
             {'W', "SIZE - set number of messages to send before "              \
                   "synchronization (default 64)"},                             \
             {'t',                                                              \
-             "Non-blocking collectives-> CALLS - set the number of "           \
+             "Non-blocking collectives and osu_pt2pt_overlap-> CALLS - set "   \
+             "the number of "                                                  \
              "MPI_Test() calls during the dummy computation,"                  \
              "~~set CALLS to 100, 1000, or any number > 0."                    \
              "~~Multi-Threaded/Process-> SEND:[RECV] - set the sender and "    \
@@ -186,7 +240,11 @@
              "~~Examples:"                                                     \
              "~~-t 4        // receiver t/p = 4 and sender t/p = 1"            \
              "~~-t 4:6      // sender t/p = 4 and receiver t/p = 6"            \
-             "~~-t 2:       // not defined"},                                  \
+             "~~-t 2:       // not defined"                                    \
+             "~~osu_mt_mbw_mr-> THREADS - largest number of threads per "      \
+             "process~~(default 8), swept in powers of two"                    \
+             "~~osu_coll_mt-> THREADS - number of threads per process "        \
+             "(default 4)"},                                                   \
             {'i', "ITER - number of iterations for timing (default 10000)"},   \
             {'x', "ITER - set number of warmup"                                \
                   "~~iterations to skip before timing (default 200)"},         \
@@ -210,7 +268,9 @@
                   "~~allocate     use MPI_Win_allocate to create an MPI "      \
                   "Window object(not valid when using device memory)"          \
                   "~~dynamic      use MPI_Win_create_dynamic to create an "    \
-                  "MPI Window object"},                                        \
+                  "MPI Window object"                                          \
+                  "~~allocate_shared use MPI_Win_allocate_shared to create "   \
+                  "an MPI Window object(all processes on one node)"},          \
             {'d', "TYPE - use accelerator device buffers, which can be of "    \
                   "TYPE 'cuda',"                                               \
                   "~~'managed', 'openacc', 'rocm' or 'sycl' (uses standard "   \
@@ -245,14 +305,104 @@
                   "(default:- cart:1:1)"                                       \
                   "~~-N cart:<num of dimentions:radius>   //Cartesian"         \
                   "~~-N graph:<adjacency graph file>      //Graph"},           \
-            {'T', "[all,mpi_char,mpi_int,mpi_float] - Set MPI_TYPE . "         \
-                  "Default:MPI_CHAR. Reduction defaults: MPI_INT"},            \
+            {'T', "[all,mpi_char,mpi_int,mpi_float,mpi_double,mpi_int64_t,"    \
+                  "~~mpi_c_double_complex,bf16,mpi_2int] - Set MPI_TYPE . "    \
+                  "Default:MPI_CHAR.~~Reduction defaults: MPI_INT (MPI_2INT "  \
+                  "for minloc). bf16 and~~mpi_2int are only supported by the " \
+                  "reduction benchmarks"},                                     \
             {'I', "Enable session based MPI initialization."},                 \
             {'l', "Run benchmark with MPI_IN_PLACE support."},                 \
             {'z', "Print tail latencies."                                      \
                   "~~-z Outputs P99, P90, P50 percentiles"                     \
                   "~~-z<1-99,1-99,1-99..> Comma seperated percentile range"},  \
             {'q', "Number of MPI partitions."},                                \
+            {'e', "Enable Linux perf_event hardware counters (cycles, "        \
+                  "instructions,~~LLC misses, context switches) and print "    \
+                  "IPC, LLC misses/KB~~and cycles/message per message size."}, \
+            {'C', "[allgather,allreduce,alltoall,barrier,bcast,gather,reduce," \
+                  "~~reduce_scatter,scatter] - collective to tune or sweep "  \
+                  "(default allreduce)~~osu_coll_concurrent also runs the "    \
+                  "non-blocking ones,~~e.g. -C iallreduce"},                   \
+            {'o', "PATH - write the best algorithms to a tuning file (Open "   \
+                  "MPI~~coll/tuned dynamic rules format when applicable)"},    \
+            {'M', "[FILTER] - sample MPI_T performance variables around the "  \
+                  "timed loop~~and print their deltas per message size. "      \
+                  "FILTER is a comma~~separated list of name substrings "      \
+                  "(default: all variables)"},                                 \
+            {'A', "[exact,any_tag,any_source,random] - receive pattern of "    \
+                  "osu_matching~~(default exact). exact and random post "      \
+                  "sequential and random~~tags, any_tag and any_source "       \
+                  "match with a wildcard receive"},                            \
+            {'L', "[last,random] - queue entry matched by osu_matching "      \
+                  "(default last)"},                                           \
+            {'S', "TYPE:US[:ARG] - delay the arrival of ranks at the "         \
+                  "collective~~in every iteration (blocking collectives)"      \
+                  "~~-S late:US[:RANK]    //RANK (default last) is US late"    \
+                  "~~-S random:US[:PCT]   //PCT% of the ranks (default 10) "   \
+                  "are US late"                                                \
+                  "~~-S gauss:US[:STDDEV] //normal delays with mean US "       \
+                  "(default STDDEV US/2)"                                      \
+                  "~~-S exp:US            //exponential delays with mean US"   \
+                  "~~The largest delay of every iteration is subtracted from " \
+                  "the latency."},                                             \
+            {'g', "[dense,spread][:N1,N2,...] - order in which the "           \
+                  "sub-communicators~~of osu_coll_scaling take ranks: dense "  \
+                  "fills a node before~~the next one, spread takes one rank "  \
+                  "per node first~~(default dense). Sizes default to 2, 4, "   \
+                  "8, ... up to all ranks"},                                   \
+            {'O', "[sum,max,min,prod,band,minloc,user] - reduction operator "  \
+                  "(default sum).~~user is a sum registered with "             \
+                  "MPI_Op_create, bf16 always uses~~user-defined operators"},  \
+            {'F', "PATTERN - traffic pattern of osu_bw_pattern (default "      \
+                  "random)~~-F random[:SEED]   //random permutation"          \
+                  "~~-F bitrev          //bit reversal of the rank"            \
+                  "~~-F transpose       //swap the halves of the rank bits"    \
+                  "~~-F ring            //rank + 1"                            \
+                  "~~-F tornado         //rank + ceil(N/2) - 1"                \
+                  "~~-F shuffle[:SEED]  //all-to-all, shuffled order"         \
+                  "~~-F file:PATH       //N x N matrix, nonzero entries are "  \
+                  "flows"},                                                    \
+            {'Y', "VICTIM:CONGESTOR[:PCT[:BYTES]] - interference run of "      \
+                  "osu_cong_impact~~VICTIM is allreduce or pingpong, "         \
+                  "CONGESTOR is incast,~~alltoall or put. PCT percent of the " \
+                  "ranks are victims~~(default allreduce:alltoall:20), the "   \
+                  "congestors send~~BYTES per message (default 131072)"},      \
+            {'B', "SPLIT - node halves of osu_bisection (default random)"      \
+                  "~~-B random[:SPLITS[:SEED]] //SPLITS random splits "        \
+                  "(default 10)"                                               \
+                  "~~-B name                   //first half of the sorted "    \
+                  "host names"                                                 \
+                  "~~-B file:PATH              //hosts of one half, one per "  \
+                  "line"},                                                     \
+            {'j', "PATTERN[:N] - disjoint groups of osu_coll_concurrent "      \
+                  "(default node)~~-j node       //one group per node"        \
+                  "~~-j stride:N   //N groups, rank r in group r % N "         \
+                  "(default 2)~~-j row:N      //rows of a grid with N "        \
+                  "columns~~-j col:N      //columns of a grid with N "         \
+                  "columns~~Without N the grid is as square as possible"},    \
+            {'H', "POLICY - bind every process, and the threads it starts, "   \
+                  "to~~CPUs and print the placement of all ranks"              \
+                  "~~-H none        //only print where the launcher put them"  \
+                  "~~-H compact     //fill the sockets one after the other"    \
+                  "~~-H scatter     //spread the processes over the sockets"   \
+                  "~~-H socket:N    //all processes on socket N"               \
+                  "~~-H cores:LIST  //CPUs of LIST in order, e.g. 0-3,8"},     \
+            {'X', "THREADS[:MB] - also measure bandwidth while THREADS "       \
+                  "memory~~streaming threads per process run a STREAM triad"   \
+                  " over~~three arrays of MB megabytes each. Default MB: 32"}, \
+            {'U', "SIZE - fail instead of allocating a message buffer larger"  \
+                  " than~~SIZE bytes, K, M and G suffixes accepted (default:"  \
+                  " no limit)"},                                               \
+            {'E', "POLICY - buffers used by every iteration (default: reuse)"  \
+                  "~~-E reuse      //the same buffers every iteration"         \
+                  "~~-E rotate:MB  //cycle through buffers spanning MB per"    \
+                  " side,~~                 more than the registration cache"  \
+                  " holds~~                 (default MB: 256)"                 \
+                  "~~-E malloc     //malloc new buffers every iteration, then" \
+                  " free~~                 the old ones; malloc may return"    \
+                  " addresses~~                 freed an iteration earlier"    \
+                  "~~-E mmap       //mmap new pages every iteration, then"     \
+                  " munmap~~                 the old ones"},                   \
         {                                                                      \
             'k', "Set root rank. Default: fixed:0"                             \
                  "~~-k fixed:[RANK] //Fixed root rank."                        \
@@ -8,7 +8,7 @@
  * copyright file COPYRIGHT in the top level OMB directory.
  */
 
-#include <osu_util_mpi.h>
+#include "osu_util_mpit.h"
 
 #ifdef _ENABLE_PAPI_
 static char **PAPI_values = NULL;
@@ -17,8 +17,223 @@ static FILE *omb_papi_output = NULL;
 char omb_papi_output_filename[OMB_PAPI_FILE_PATH_MAX_LENGTH];
 #endif /*#ifdef _ENABLE_PAPI_*/
 
+#ifdef _ENABLE_PERF_EVENT_
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+enum omb_perf_events_t {
+    OMB_PERF_CYCLES,
+    OMB_PERF_INSTRUCTIONS,
+    OMB_PERF_LLC_MISSES,
+    OMB_PERF_CTX_SWITCHES,
+    OMB_PERF_NUM_EVENTS
+};
+
+typedef struct omb_perf_record {
+    size_t size;
+    double messages;
+    double counts[OMB_PERF_NUM_EVENTS];
+} omb_perf_record_t;
+
+static const struct {
+    __u32 type;
+    __u64 config;
+} omb_perf_event_attrs[OMB_PERF_NUM_EVENTS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}};
+static int omb_perf_fds[OMB_PERF_NUM_EVENTS] = {-1, -1, -1, -1};
+static int omb_perf_running = 0;
+static int omb_perf_num_records = 0;
+static omb_perf_record_t omb_perf_records[OMB_PERF_MAX_RECORDS];
+
+static int omb_perf_open(int event, int exclude_kernel)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = omb_perf_event_attrs[event].type;
+    attr.config = omb_perf_event_attrs[event].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = exclude_kernel;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*
+ * Opens the counters for the calling thread. Kernel time is included when
+ * perf_event_paranoid allows it, otherwise only user space is counted. An
+ * event is used only if it could be opened on every process.
+ */
+static void omb_perf_init(void)
+{
+    int i = 0, rank = 0;
+    int available[OMB_PERF_NUM_EVENTS], global_available[OMB_PERF_NUM_EVENTS];
+
+    omb_perf_num_records = 0;
+    omb_perf_running = 0;
+    if (!options.perf_enabled) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    for (i = 0; i < OMB_PERF_NUM_EVENTS; i++) {
+        omb_perf_fds[i] = omb_perf_open(i, 0);
+        if (-1 == omb_perf_fds[i]) {
+            omb_perf_fds[i] = omb_perf_open(i, 1);
+        }
+        available[i] = (-1 != omb_perf_fds[i]);
+    }
+    MPI_CHECK(MPI_Allreduce(available, global_available, OMB_PERF_NUM_EVENTS,
+                            MPI_INT, MPI_MIN, MPI_COMM_WORLD));
+    for (i = 0; i < OMB_PERF_NUM_EVENTS; i++) {
+        if (!global_available[i] && -1 != omb_perf_fds[i]) {
+            close(omb_perf_fds[i]);
+            omb_perf_fds[i] = -1;
+        }
+    }
+    if (0 == rank && (!global_available[OMB_PERF_CYCLES] ||
+                      !global_available[OMB_PERF_INSTRUCTIONS] ||
+                      !global_available[OMB_PERF_LLC_MISSES] ||
+                      !global_available[OMB_PERF_CTX_SWITCHES])) {
+        fprintf(stderr, "Warning! Some perf_event counters could not be"
+                        " opened. Check /proc/sys/kernel/perf_event_paranoid."
+                        "\n");
+        fflush(stderr);
+    }
+}
+
+static void omb_perf_start(void)
+{
+    int i = 0;
+
+    if (!options.perf_enabled) {
+        return;
+    }
+    for (i = 0; i < OMB_PERF_NUM_EVENTS; i++) {
+        if (-1 != omb_perf_fds[i]) {
+            ioctl(omb_perf_fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(omb_perf_fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    omb_perf_running = 1;
+}
+
+static void omb_perf_stop(size_t size)
+{
+    int i = 0, rank = 0, numprocs = 0;
+    __u64 values[3];
+    double counts[OMB_PERF_NUM_EVENTS], total[OMB_PERF_NUM_EVENTS];
+    omb_perf_record_t *record = NULL;
+
+    if (!options.perf_enabled) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &numprocs));
+    for (i = 0; i < OMB_PERF_NUM_EVENTS; i++) {
+        counts[i] = -1;
+        if (-1 == omb_perf_fds[i]) {
+            continue;
+        }
+        ioctl(omb_perf_fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        counts[i] = 0;
+        if (omb_perf_running && sizeof(values) == read(omb_perf_fds[i], values,
+                                                      sizeof(values))) {
+            /* Scale for counter multiplexing */
+            counts[i] = values[2] ? (double)values[0] * values[1] / values[2] :
+                                    0;
+        }
+    }
+    omb_perf_running = 0;
+    MPI_CHECK(MPI_Reduce(counts, total, OMB_PERF_NUM_EVENTS, MPI_DOUBLE,
+                         MPI_SUM, 0, MPI_COMM_WORLD));
+    if (0 != rank || OMB_PERF_MAX_RECORDS == omb_perf_num_records) {
+        return;
+    }
+    record = &omb_perf_records[omb_perf_num_records++];
+    record->size = size;
+    record->messages = options.iterations;
+    if (BW == options.subtype || CONG_BW == options.subtype ||
+        MBW_MR == options.bench) {
+        record->messages *= options.window_size;
+    }
+    for (i = 0; i < OMB_PERF_NUM_EVENTS; i++) {
+        record->counts[i] = -1 == omb_perf_fds[i] ? -1 : total[i] / numprocs;
+    }
+}
+
+static void omb_perf_print_metric(double value, int available)
+{
+    if (available) {
+        fprintf(stdout, "%*.*f", FIELD_WIDTH, FLOAT_PRECISION, value);
+    } else {
+        fprintf(stdout, "%*s", FIELD_WIDTH, "-");
+    }
+}
+
+/*
+ * Prints the derived metrics, averaged over all processes, for every message
+ * size recorded since omb_perf_init() and closes the counters.
+ */
+static void omb_perf_print_and_free(void)
+{
+    int i = 0, rank = 0;
+    omb_perf_record_t *record = NULL;
+    double kbytes = 0;
+
+    if (!options.perf_enabled) {
+        return;
+    }
+    MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank));
+    if (0 == rank && omb_perf_num_records) {
+        fprintf(stdout, "\n# perf_event counters (average per process)\n");
+        fprintf(stdout, "%-*s%*s%*s%*s%*s\n", 10, "# Size", FIELD_WIDTH,
+                "Cycles/msg", FIELD_WIDTH, "IPC", FIELD_WIDTH,
+                "LLC misses/KB", FIELD_WIDTH, "Ctx switches");
+        for (i = 0; i < omb_perf_num_records; i++) {
+            record = &omb_perf_records[i];
+            kbytes = record->size * record->messages / 1024.0;
+            fprintf(stdout, "%-*zu", 10, record->size);
+            omb_perf_print_metric(
+                record->counts[OMB_PERF_CYCLES] / record->messages,
+                record->counts[OMB_PERF_CYCLES] >= 0 && record->messages > 0);
+            omb_perf_print_metric(
+                record->counts[OMB_PERF_INSTRUCTIONS] /
+                    record->counts[OMB_PERF_CYCLES],
+                record->counts[OMB_PERF_INSTRUCTIONS] >= 0 &&
+                    record->counts[OMB_PERF_CYCLES] > 0);
+            omb_perf_print_metric(record->counts[OMB_PERF_LLC_MISSES] / kbytes,
+                                  record->counts[OMB_PERF_LLC_MISSES] >= 0 &&
+                                      kbytes > 0);
+            omb_perf_print_metric(record->counts[OMB_PERF_CTX_SWITCHES],
+                                  record->counts[OMB_PERF_CTX_SWITCHES] >= 0);
+            fprintf(stdout, "\n");
+        }
+        fflush(stdout);
+    }
+    for (i = 0; i < OMB_PERF_NUM_EVENTS; i++) {
+        if (-1 != omb_perf_fds[i]) {
+            close(omb_perf_fds[i]);
+            omb_perf_fds[i] = -1;
+        }
+    }
+    omb_perf_num_records = 0;
+}
+#endif /*#ifdef _ENABLE_PERF_EVENT_*/
+
 void omb_papi_init(int *papi_eventset)
 {
+#ifdef _ENABLE_PERF_EVENT_
+    omb_perf_init();
+#endif /*#ifdef _ENABLE_PERF_EVENT_*/
+#ifdef _ENABLE_MPIT_
+    omb_mpit_pvar_init();
+#endif /*#ifdef _ENABLE_MPIT_*/
 #ifdef _ENABLE_PAPI_
     int papi_retval = 0, i = 0;
     omb_papi_output = fopen(omb_papi_output_filename, "w");
@@ -69,6 +284,12 @@ void omb_papi_init(int *papi_eventset)
 
 void omb_papi_start(int *papi_eventset)
 {
+#ifdef _ENABLE_PERF_EVENT_
+    omb_perf_start();
+#endif /*#ifdef _ENABLE_PERF_EVENT_*/
+#ifdef _ENABLE_MPIT_
+    omb_mpit_pvar_start();
+#endif /*#ifdef _ENABLE_MPIT_*/
 #ifdef _ENABLE_PAPI_
     int papi_retval = 0;
 
@@ -84,8 +305,14 @@ void omb_papi_start(int *papi_eventset)
 #endif /*#ifdef _ENABLE_PAPI_*/
 }
 
-void omb_papi_stop_and_print(int *papi_eventset, int size)
+void omb_papi_stop_and_print(int *papi_eventset, size_t size)
 {
+#ifdef _ENABLE_PERF_EVENT_
+    omb_perf_stop(size);
+#endif /*#ifdef _ENABLE_PERF_EVENT_*/
+#ifdef _ENABLE_MPIT_
+    omb_mpit_pvar_stop(size);
+#endif /*#ifdef _ENABLE_MPIT_*/
 #ifdef _ENABLE_PAPI_
     int myid = 0, i = 0, j = 0, papi_retval = 0, numprocs = 0;
     long long *count;
@@ -107,7 +334,7 @@ void omb_papi_stop_and_print(int *papi_eventset, int size)
         exit(EXIT_FAILURE);
     }
     if (myid == 0) {
-        fprintf(omb_papi_output, "Size: %d\n", size);
+        fprintf(omb_papi_output, "Size: %zu\n", size);
         fprintf(omb_papi_output, ">>========================================"
                                  "=======================>>\n");
         fprintf(omb_papi_output, "%-*s", FIELD_WIDTH, "PAPI Event Name");
@@ -140,6 +367,12 @@ void omb_papi_stop_and_print(int *papi_eventset, int size)
 
 void omb_papi_free(int *papi_eventset)
 {
+#ifdef _ENABLE_PERF_EVENT_
+    omb_perf_print_and_free();
+#endif /*#ifdef _ENABLE_PERF_EVENT_*/
+#ifdef _ENABLE_MPIT_
+    omb_mpit_pvar_print_and_free();
+#endif /*#ifdef _ENABLE_MPIT_*/
 #ifdef _ENABLE_PAPI_
     if (!options.papi_enabled) {
         return;
@@ -21,8 +21,14 @@
 #define OMB_PAPI_FILE_PATH_MAX_LENGTH OMB_FILE_PATH_MAX_LENGTH
 #define OMB_PAPI_NUMBER_OF_EVENTS     100
 
+/*
+ * Maximum number of message sizes (across all datatypes) for which perf_event
+ * counter results are kept until they are printed by omb_papi_free().
+ */
+#define OMB_PERF_MAX_RECORDS 256
+
 void omb_papi_init(int *papi_eventset);
 void omb_papi_start(int *papi_eventset);
-void omb_papi_stop_and_print(int *papi_eventset, int size);
+void omb_papi_stop_and_print(int *papi_eventset, size_t size);
 void omb_papi_free(int *papi_eventset);
 void omb_papi_parse_event_options(char *opt_arr);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#include "osu_util_shm.h"
+#ifdef _ENABLE_NT_STORES_
+#include <emmintrin.h>
+#endif
+
+/*
+ * Both processes allocate their segment with MPI_Win_allocate_shared, which
+ * is only used to obtain memory the peer can address; no RMA is performed on
+ * the window. Each segment is touched by its owner first so that it is placed
+ * on the owner's NUMA node.
+ */
+void omb_shm_channel_create(MPI_Comm comm, size_t buf_size,
+                            omb_shm_channel_t *channel)
+{
+    int rank = 0, disp_unit = 0;
+    size_t seg_size = 0, page_size = getpagesize();
+    MPI_Aint peer_size = 0;
+    char *local = NULL, *peer = NULL;
+
+    MPI_CHECK(MPI_Comm_rank(comm, &rank));
+    seg_size = sizeof(struct omb_shm_ring) + buf_size;
+    seg_size = (seg_size + page_size - 1) / page_size * page_size;
+    MPI_CHECK(MPI_Win_allocate_shared(seg_size, 1, MPI_INFO_NULL, comm, &local,
+                                      &channel->win));
+    MPI_CHECK(MPI_Win_shared_query(channel->win, 1 - rank, &peer_size,
+                                   &disp_unit, &peer));
+    memset(local, 0, seg_size);
+    channel->in = (struct omb_shm_ring *)local;
+    channel->out = (struct omb_shm_ring *)peer;
+    channel->in_buf = local + sizeof(struct omb_shm_ring);
+    channel->out_buf = peer + sizeof(struct omb_shm_ring);
+    channel->head = channel->tail = 0;
+    channel->cached_head = channel->cached_tail = 0;
+    MPI_CHECK(MPI_Barrier(comm));
+}
+
+void omb_shm_channel_free(omb_shm_channel_t *channel)
+{
+    MPI_CHECK(MPI_Win_free(&channel->win));
+}
+
+/*
+ * Pushes size bytes into the peer's ring, split into slot sized chunks that
+ * the consumer may drain while later chunks are still being copied in. A zero
+ * sized message still occupies one slot and serves as a flag.
+ */
+void omb_shm_send(omb_shm_channel_t *channel, const char *buf, size_t size,
+                  omb_shm_copy_fn copy)
+{
+    size_t offset = 0, chunk = 0;
+    struct omb_shm_ring *ring = channel->out;
+
+    do {
+        while (channel->head - channel->cached_tail >= OMB_SHM_RING_SLOTS) {
+            channel->cached_tail =
+                __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        }
+        chunk = MIN(size - offset, OMB_SHM_SLOT_BYTES);
+        if (chunk) {
+            copy(ring->slots[channel->head % OMB_SHM_RING_SLOTS],
+                 buf + offset, chunk);
+        }
+        channel->head++;
+        __atomic_store_n(&ring->head, channel->head, __ATOMIC_RELEASE);
+        offset += chunk;
+    } while (offset < size);
+}
+
+/*
+ * Pops a message of size bytes from the local ring. With a NULL buf the
+ * chunks are only consumed, which is how flags and direct copies into in_buf
+ * are received.
+ */
+void omb_shm_recv(omb_shm_channel_t *channel, char *buf, size_t size)
+{
+    size_t offset = 0, chunk = 0;
+    struct omb_shm_ring *ring = channel->in;
+
+    do {
+        while (channel->tail == channel->cached_head) {
+            channel->cached_head =
+                __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        }
+        chunk = MIN(size - offset, OMB_SHM_SLOT_BYTES);
+        if (chunk && NULL != buf) {
+            memcpy(buf + offset,
+                   ring->slots[channel->tail % OMB_SHM_RING_SLOTS], chunk);
+        }
+        channel->tail++;
+        __atomic_store_n(&ring->tail, channel->tail, __ATOMIC_RELEASE);
+        offset += chunk;
+    } while (offset < size);
+}
+
+/*
+ * memcpy replacement that writes the destination with non-temporal stores,
+ * bypassing the cache of the copying core. Falls back to memcpy when the
+ * compiler does not target SSE2.
+ */
+void *omb_shm_copy_nt(void *dst, const void *src, size_t n)
+{
+#ifdef _ENABLE_NT_STORES_
+    char *d = dst;
+    const char *s = src;
+    size_t lead = (16 - ((uintptr_t)d & 15)) & 15;
+    __m128i x0, x1, x2, x3;
+
+    lead = MIN(lead, n);
+    memcpy(d, s, lead);
+    d += lead;
+    s += lead;
+    n -= lead;
+    for (; n >= 64; n -= 64, d += 64, s += 64) {
+        x0 = _mm_loadu_si128((const __m128i *)s);
+        x1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        x2 = _mm_loadu_si128((const __m128i *)(s + 32));
+        x3 = _mm_loadu_si128((const __m128i *)(s + 48));
+        _mm_stream_si128((__m128i *)d, x0);
+        _mm_stream_si128((__m128i *)(d + 16), x1);
+        _mm_stream_si128((__m128i *)(d + 32), x2);
+        _mm_stream_si128((__m128i *)(d + 48), x3);
+    }
+    memcpy(d, s, n);
+    _mm_sfence();
+    return dst;
+#else
+    return memcpy(dst, src, n);
+#endif
+}
+
+/* vi:set sw=4 sts=4 tw=80: */
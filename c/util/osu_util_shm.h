@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 the Network-Based Computing Laboratory
+ * (NBCL), The Ohio State University.
+ *
+ * Contact: Dr. D. K. Panda (panda@cse.ohio-state.edu)
+ *
+ * For detailed copyright and licensing information, please refer to the
+ * copyright file COPYRIGHT in the top level OMB directory.
+ */
+#ifndef OSU_UTIL_SHM_H
+#define OSU_UTIL_SHM_H
+
+#include "osu_util_mpi.h"
+
+#if defined(__SSE2__)
+#define _ENABLE_NT_STORES_ 1
+#endif
+
+#define OMB_SHM_CACHE_LINE 64
+#define OMB_SHM_RING_SLOTS 16
+#define OMB_SHM_SLOT_BYTES 8192
+
+typedef void *(*omb_shm_copy_fn)(void *dst, const void *src, size_t n);
+
+/*
+ * Single-producer single-consumer ring of fixed size slots. It lives in the
+ * segment of the consuming process; head is only written by the producer and
+ * tail only by the consumer, each on its own cache line.
+ */
+struct omb_shm_ring {
+    volatile uint64_t head;
+    char pad_head[OMB_SHM_CACHE_LINE - sizeof(uint64_t)];
+    volatile uint64_t tail;
+    char pad_tail[OMB_SHM_CACHE_LINE - sizeof(uint64_t)];
+    char slots[OMB_SHM_RING_SLOTS][OMB_SHM_SLOT_BYTES];
+};
+
+/*
+ * A pair of processes on one node, each owning an inbound ring followed by a
+ * buffer that the peer can copy into directly.
+ */
+typedef struct omb_shm_channel {
+    MPI_Win win;
+    struct omb_shm_ring *in;
+    struct omb_shm_ring *out;
+    char *in_buf;
+    char *out_buf;
+    uint64_t head;
+    uint64_t tail;
+    uint64_t cached_head;
+    uint64_t cached_tail;
+} omb_shm_channel_t;
+
+void omb_shm_channel_create(MPI_Comm comm, size_t buf_size,
+                            omb_shm_channel_t *channel);
+void omb_shm_channel_free(omb_shm_channel_t *channel);
+void omb_shm_send(omb_shm_channel_t *channel, const char *buf, size_t size,
+                  omb_shm_copy_fn copy);
+void omb_shm_recv(omb_shm_channel_t *channel, char *buf, size_t size);
+void *omb_shm_copy_nt(void *dst, const void *src, size_t n);
+
+#endif /* OSU_UTIL_SHM_H */